@@ -0,0 +1,50 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google benchmark header files
+#include <benchmark/benchmark.h>
+
+// C++ header files
+#include <atomic>
+#include <cstdint>
+
+namespace srilakshmikanthanp::clipbirdesk::benchmarks {
+/**
+ * @brief Number of heap allocations made by the process, it is
+ * incremented by the allocation hooks defined in bench.cpp
+ */
+inline std::atomic<std::uint64_t> allocations{0};
+
+/**
+ * @brief Counts the allocations made while the benchmark loop
+ * runs and reports them as the average per iteration
+ */
+class AllocationCounter {
+ private:
+
+  benchmark::State& state;
+  std::uint64_t start;
+
+ public:
+
+  /**
+   * @brief Start counting the allocations
+   *
+   * @param state benchmark state
+   */
+  explicit AllocationCounter(benchmark::State& state)
+      : state(state), start(allocations.load(std::memory_order_relaxed)) {}
+
+  /**
+   * @brief Report the allocations per iteration
+   */
+  ~AllocationCounter() {
+    const auto count = allocations.load(std::memory_order_relaxed) - start;
+    state.counters["allocs"] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+  }
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::benchmarks
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google benchmark header files
+#include <benchmark/benchmark.h>
+
+// Qt header files
+#include <QCoreApplication>
+
+// C++ header files
+#include <cstdlib>
+#include <new>
+
+// Local header files
+#include "benchmarks/allocations.hpp"
+#include "benchmarks/network/packets/SyncingPacket.hpp"
+#include "benchmarks/network/syncing/Encoder.hpp"
+#include "benchmarks/storage/searchindex/SearchIndex.hpp"
+
+using srilakshmikanthanp::clipbirdesk::benchmarks::allocations;
+
+// Qt containers allocate with malloc/realloc so on glibc they are
+// hooked as well, on other platforms only operator new is counted
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_realloc(void* ptr, std::size_t size);
+
+/**
+ * @brief Count and forward to the glibc malloc
+ */
+extern "C" void* malloc(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+/**
+ * @brief Count and forward to the glibc realloc
+ */
+extern "C" void* realloc(void* ptr, std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+#else
+/**
+ * @brief Count and forward to malloc
+ */
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+/**
+ * @brief Release the memory from operator new
+ */
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+/**
+ * @brief Release the memory from operator new
+ */
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+#endif
+
+/**
+ * @brief Benchmarking the clipbirdesk Application
+ */
+auto main(int argc, char **argv) -> int {
+  QCoreApplication app(argc, argv);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
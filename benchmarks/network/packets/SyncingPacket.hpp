@@ -0,0 +1,169 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google benchmark header files
+#include <benchmark/benchmark.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+// Local header files
+#include "benchmarks/allocations.hpp"
+#include "network/packets/syncingpacket/syncingpacket.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::benchmarks {
+/**
+ * @brief Create the items of the SyncingPacket with the
+ * given count and payload size of each item
+ *
+ * @param count number of items
+ * @param size payload size of each item
+ */
+inline QVector<QPair<QString, QByteArray>> createItems(qint64 count, qint64 size) {
+  // create the items
+  QVector<QPair<QString, QByteArray>> items;
+
+  // reserve the memory
+  items.reserve(count);
+
+  // fill the items with the same payload (implicitly shared)
+  for (auto payload = QByteArray(size, 'x'); items.size() < count;) {
+    items.append({"text/plain", payload});
+  }
+
+  // return the items
+  return items;
+}
+
+/**
+ * @brief Item counts 1 - 64 and payload sizes 16B - 256MB, the
+ * combinations larger than 256MB in total are skipped so the
+ * suite fits in the memory of a developer machine
+ */
+inline void syncingPacketArgs(benchmark::internal::Benchmark* bench) {
+  // total bytes limit of the packet
+  constexpr qint64 limit = qint64(256) << 20;
+
+  // generate the combinations
+  for (qint64 count = 1; count <= 64; count *= 4) {
+    for (qint64 size = 16; size <= limit; size *= 16) {
+      if (count * size <= limit) bench->Args({count, size});
+    }
+  }
+
+  // name the arguments
+  bench->ArgNames({"items", "size"});
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::benchmarks
+
+/**
+ * @brief benchmarking the createPacket for SyncingPacket
+ */
+inline void BM_SyncingPacketCreate(benchmark::State& state) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using benchmarks namespace
+  using namespace srilakshmikanthanp::clipbirdesk::benchmarks;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // create the items
+  const auto items = createItems(state.range(0), state.range(1));
+
+  // packet type
+  const auto type  = SyncingPacket::PacketType::SyncPacket;
+
+  // count the allocations
+  AllocationCounter counter(state);
+
+  // benchmark the loop
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(createPacket({type, items}));
+  }
+
+  // bytes processed
+  state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+/**
+ * @brief benchmarking the encode (toQByteArray) of SyncingPacket
+ */
+inline void BM_SyncingPacketEncode(benchmark::State& state) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using benchmarks namespace
+  using namespace srilakshmikanthanp::clipbirdesk::benchmarks;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // packet type
+  const auto type   = SyncingPacket::PacketType::SyncPacket;
+
+  // create the packet
+  const auto packet = createPacket({type, createItems(state.range(0), state.range(1))});
+
+  // count the allocations
+  AllocationCounter counter(state);
+
+  // benchmark the loop
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toQByteArray(packet));
+  }
+
+  // bytes processed
+  state.SetBytesProcessed(state.iterations() * packet.size());
+}
+
+/**
+ * @brief benchmarking the decode (fromQByteArray) of SyncingPacket
+ */
+inline void BM_SyncingPacketDecode(benchmark::State& state) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using benchmarks namespace
+  using namespace srilakshmikanthanp::clipbirdesk::benchmarks;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // packet type
+  const auto type  = SyncingPacket::PacketType::SyncPacket;
+
+  // create the items
+  const auto items = createItems(state.range(0), state.range(1));
+
+  // create the encoded packet
+  const auto bytes = toQByteArray(createPacket({type, items}));
+
+  // count the allocations
+  AllocationCounter counter(state);
+
+  // benchmark the loop
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fromQByteArray<SyncingPacket>(bytes));
+  }
+
+  // bytes processed
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+// register the benchmarks
+BENCHMARK(BM_SyncingPacketCreate)
+    ->Apply(srilakshmikanthanp::clipbirdesk::benchmarks::syncingPacketArgs);
+BENCHMARK(BM_SyncingPacketEncode)
+    ->Apply(srilakshmikanthanp::clipbirdesk::benchmarks::syncingPacketArgs);
+BENCHMARK(BM_SyncingPacketDecode)
+    ->Apply(srilakshmikanthanp::clipbirdesk::benchmarks::syncingPacketArgs);
@@ -0,0 +1,121 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google benchmark header files
+#include <benchmark/benchmark.h>
+
+// Local header files
+#include "benchmarks/allocations.hpp"
+#include "benchmarks/network/packets/SyncingPacket.hpp"
+#include "network/packets/syncingpacket/syncingpacket.hpp"
+#include "network/syncing/encoder/encoder.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::benchmarks {
+/**
+ * @brief Item counts 1 - 4 and payload sizes 16B - 4KB of the
+ * small syncs like the text copies
+ */
+inline void smallSyncArgs(benchmark::internal::Benchmark* bench) {
+  // generate the combinations
+  for (qint64 count = 1; count <= 4; count *= 2) {
+    for (qint64 size = 16; size <= 4096; size *= 16) {
+      bench->Args({count, size});
+    }
+  }
+
+  // name the arguments
+  bench->ArgNames({"items", "size"});
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::benchmarks
+
+/**
+ * @brief benchmarking the encode of SyncingPacket to the frame of
+ * the Encoder, compare the allocations with BM_SyncingPacketEncode
+ */
+inline void BM_EncoderEncode(benchmark::State& state) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using the Encoder
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Encoder;
+
+  // using benchmarks namespace
+  using namespace srilakshmikanthanp::clipbirdesk::benchmarks;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // packet type
+  const auto type   = SyncingPacket::PacketType::SyncPacket;
+
+  // create the packet
+  const auto packet = createPacket({type, createItems(state.range(0), state.range(1))});
+
+  // encoder of the connection
+  Encoder encoder;
+
+  // the first packet grows the frame
+  encoder.encode(packet);
+
+  // count the allocations
+  AllocationCounter counter(state);
+
+  // benchmark the loop, the bytes are dropped like after the write
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encoder.encode(packet));
+  }
+
+  // bytes processed
+  state.SetBytesProcessed(state.iterations() * packet.size());
+}
+
+/**
+ * @brief benchmarking the small sync, the packet is created and
+ * encoded to the frame of the Encoder
+ */
+inline void BM_EncoderSmallSync(benchmark::State& state) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using the Encoder
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Encoder;
+
+  // using benchmarks namespace
+  using namespace srilakshmikanthanp::clipbirdesk::benchmarks;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // create the items
+  const auto items = createItems(state.range(0), state.range(1));
+
+  // packet type
+  const auto type  = SyncingPacket::PacketType::SyncPacket;
+
+  // encoder of the connection
+  Encoder encoder;
+
+  // the first packet grows the frame
+  encoder.encode(createPacket({type, items}));
+
+  // count the allocations
+  AllocationCounter counter(state);
+
+  // benchmark the loop
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encoder.encode(createPacket({type, items})));
+  }
+
+  // bytes processed
+  state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+// register the benchmarks
+BENCHMARK(BM_EncoderEncode)
+    ->Apply(srilakshmikanthanp::clipbirdesk::benchmarks::smallSyncArgs);
+BENCHMARK(BM_EncoderSmallSync)
+    ->Apply(srilakshmikanthanp::clipbirdesk::benchmarks::smallSyncArgs);
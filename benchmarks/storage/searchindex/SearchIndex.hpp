@@ -0,0 +1,83 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google benchmark header files
+#include <benchmark/benchmark.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+// C++ header files
+#include <memory>
+
+// Local header files
+#include "storage/searchindex/searchindex.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::benchmarks {
+/**
+ * @brief Create the index with the random words in the documents
+ *
+ * @param count number of the documents
+ * @param file file of the index
+ */
+inline std::unique_ptr<storage::SearchIndex> createIndex(qint64 count, const QString& file) {
+  // words of the documents
+  const QStringList words = {"https", "example", "meeting", "clipboard", "invoice", "kernel",
+                             "password", "address", "photo", "release", "budget", "laptop",
+                             "morning", "network", "server", "client"};
+
+  // creating the index
+  auto index = std::make_unique<storage::SearchIndex>(file);
+  index->load({});
+
+  // same seed so the runs are comparable
+  QRandomGenerator random(42);
+
+  // add the documents of 8 - 40 words with a unique number
+  for (qint64 i = 0; i < count; i++) {
+    QStringList text;
+    for (int w = 8 + random.bounded(32); w > 0; w--) text.append(words.at(random.bounded(16)));
+    text.append(QString("doc%1").arg(i));
+    index->add(QByteArray::number(i), {{"text/plain", text.join(' ').toUtf8()}});
+  }
+
+  // wait for the indexer
+  index->waitForIdle();
+
+  // return the index
+  return index;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::benchmarks
+
+/**
+ * @brief benchmarking the substring search of SearchIndex
+ */
+inline void BM_SearchIndexQuery(benchmark::State& state) {
+  // using benchmarks namespace
+  using namespace srilakshmikanthanp::clipbirdesk::benchmarks;
+
+  // directory of the index
+  QTemporaryDir dir;
+
+  // create the index
+  const auto index = createIndex(state.range(0), dir.filePath("search"));
+
+  // a rare or a common query
+  const auto query = state.range(1) ? QString("doc%1").arg(state.range(0) / 2) : "meeting";
+
+  // benchmark the loop
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index->search(query));
+  }
+}
+
+// register the benchmarks
+BENCHMARK(BM_SearchIndexQuery)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1}})
+    ->ArgNames({"documents", "rare"})
+    ->Unit(benchmark::kMicrosecond);
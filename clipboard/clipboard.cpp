@@ -18,19 +18,44 @@ namespace srilakshmikanthanp::clipbirdesk::clipboard {
 Clipboard::Clipboard(QClipboard* clipboard, QObject* parent)
     : QObject(parent), m_clipboard(clipboard) {
   // connect the clipboard change signal to the slot
-  // that is used to notify the listeners
+  // that is used to notify the listeners, every change
+  // starts a new sync that the spans are correlated to
   const auto func   = &Clipboard::OnClipboardChange;
   const auto signal = &QClipboard::changed;
-  const auto slot   = [this, func] { emit(this->*func)(get()); };
+  const auto slot   = [this, func] {
+    // the change made by applying a sync is not a new copy, the
+    // sync is already forwarded by the server it came through
+    if (this->isApplied()) return;
+
+    // the copy starts a new sync
+    tracing::SyncScope scope(tracing::newSyncId());
+    emit(this->*func)(get());
+  };
   QObject::connect(m_clipboard, signal, this, slot);
 }
 
+/**
+ * @brief Is the clipboard holding the items of a sync that
+ * were applied to it rather than a copy made on this host
+ *
+ * @return true if the items came in a sync
+ */
+bool Clipboard::isApplied() const {
+  const auto own = qobject_cast<const MimeData*>(m_clipboard->mimeData());
+  return own != nullptr && own->getSyncId() != 0;
+}
+
 /**
  * @brief Get the clipboard data from the clipboard
  *
  * @return mime type and data
  */
 QVector<QPair<QString, QByteArray>> Clipboard::get() {
+  // measure the time to capture the clipboard
+  static auto& getTime = metrics::Registry::instance().histogram("clipbird_clipboard_get_ns");
+  metrics::ScopedTimer timer(getTime);
+  CLIPBIRD_TRACE_SPAN("capture");
+
   // Default clipboard data & mime data
   QVector<QPair<QString, QByteArray>> items;
   const auto mimeData = m_clipboard->mimeData();
@@ -38,6 +63,9 @@ QVector<QPair<QString, QByteArray>> Clipboard::get() {
   // if mime data is not supported
   if (mimeData == nullptr) return items;
 
+  // the items this host set are taken as they are
+  if (const auto own = qobject_cast<const MimeData*>(mimeData)) return own->items();
+
   // get the formats
   const auto formats = mimeData->formats();
 
@@ -58,19 +86,30 @@ void Clipboard::clear() {
 }
 
 /**
- * @brief Set the clipboard data to the clipboard
+ * @brief Set the clipboard data to the clipboard, the formats
+ * are served when they are pasted and the large ones that are
+ * rarely pasted are spilled to a file, the items set while a
+ * sync is applied don't notify the change
  *
  * @param mime mime type of the data
  * @param data data to be set
  */
 void Clipboard::set(const QVector<QPair<QString, QByteArray>> data) {
-  // create the mime data object
-  auto mimeData = new QMimeData();
+  // measure the time to apply the clipboard
+  static auto& setTime = metrics::Registry::instance().histogram("clipbird_clipboard_set_ns");
+  metrics::ScopedTimer timer(setTime);
+  CLIPBIRD_TRACE_SPAN("apply");
 
-  // set the data
-  for (const auto& [mime, data] : data) {
-    mimeData->setData(mime, data);
-  }
+  // the mime data shares the buffers of the items and is
+  // tagged with the sync being applied so its change is not
+  // sent again as a new copy
+  auto mimeData = new MimeData(data, tracing::currentSyncId());
+
+  // bytes of the formats that are not in memory, none till the
+  // spill of the mime data is done and sets it
+  metrics::Registry::instance().gauge("clipbird_clipboard_spilled_bytes").set(
+      mimeData->getSpilledBytes()
+  );
 
   // set the mime data
   m_clipboard->setMimeData(mimeData);
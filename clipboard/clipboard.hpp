@@ -17,7 +17,10 @@
 
 
 // project header
+#include "clipboard/mimedata/mimedata.hpp"
 #include "types/except/except.hpp"
+#include "utility/metrics/metrics.hpp"
+#include "utility/tracing/tracing.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::clipboard {
 /**
@@ -37,6 +40,16 @@ class Clipboard : public QObject {
 
   QClipboard* m_clipboard = nullptr;
 
+ private:  // member functions
+
+  /**
+   * @brief Is the clipboard holding the items of a sync that
+   * were applied to it rather than a copy made on this host
+   *
+   * @return true if the items came in a sync
+   */
+  bool isApplied() const;
+
  private:  // just for Qt
 
   /// @brief Qt meta object
@@ -70,7 +83,10 @@ class Clipboard : public QObject {
   void clear();
 
   /**
-   * @brief Set the clipboard data to the clipboard
+   * @brief Set the clipboard data to the clipboard, the formats
+   * are served when they are pasted and the large ones that are
+   * rarely pasted are spilled to a file, the items set while a
+   * sync is applied don't notify the change
    *
    * @param mime mime type of the data
    * @param data data to be set
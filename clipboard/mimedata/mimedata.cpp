@@ -0,0 +1,205 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "mimedata.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::clipboard {
+/**
+ * @brief Write the data to the spill file
+ *
+ * @param data data to spill
+ * @return qint64 offset of the data or -1 if not spilled
+ */
+qint64 MimeData::spill(const QByteArray& data) {
+  // open the file on the first spill
+  if (!m_spill->isOpen() && !m_spill->open()) return -1;
+
+  // append the data to the file
+  const auto offset = m_spill->size();
+  if (!m_spill->seek(offset) || m_spill->write(data) != data.size()) return -1;
+
+  // offset of the data
+  return offset;
+}
+
+/**
+ * @brief Spill the formats on the thread, they are served from
+ * the buffers till all of them are written
+ *
+ * @param indexes indexes of the formats to spill
+ */
+void MimeData::spillFormats(const QList<qsizetype>& indexes) {
+  // formats written and their offsets, the formats are only
+  // read from the buffers meanwhile so the file is this thread's
+  QList<QPair<qsizetype, qint64>> spilled;
+  for (const auto index : indexes) {
+    const auto offset = this->spill(m_formats.at(index).data);
+    if (offset >= 0) spilled.append({index, offset});
+  }
+
+  // bytes that are spilled
+  qint64 bytes = 0;
+
+  // read the formats from the file and drop the buffers
+  {
+    QMutexLocker locker(&m_lock);
+    for (const auto& [index, offset] : spilled) {
+      auto& format  = m_formats[index];
+      format.offset = offset;
+      format.data   = QByteArray();
+      bytes        += format.size;
+    }
+  }
+
+  // bytes of the formats that are not in memory
+  m_spilled.store(bytes);
+  metrics::Registry::instance().gauge("clipbird_clipboard_spilled_bytes").set(bytes);
+}
+
+/**
+ * @brief Get the data of the format from the buffer or the file
+ *
+ * @param format Format
+ * @return QByteArray data of the format
+ */
+QByteArray MimeData::load(const Format& format) const {
+  // the spill may be swapping the buffer for the file
+  QMutexLocker locker(&m_lock);
+
+  // the format is in the buffer
+  if (format.offset < 0) return format.data;
+
+  // count the formats read back
+  static auto& reads = metrics::Registry::instance().counter(
+      "clipbird_clipboard_spill_reads_total"
+  );
+
+  // the format is pasted
+  reads.inc();
+
+  // read the format from the file
+  if (!m_spill->seek(format.offset)) return QByteArray();
+  return m_spill->read(format.size);
+}
+
+/**
+ * @brief Get the data of the mime type when it is asked for
+ *
+ * @param mime mime type
+ * @param type preferred type
+ * @return QVariant data or invalid if the format is not here
+ */
+QVariant MimeData::retrieveData(const QString& mime, QMetaType type) const {
+  // find the format
+  for (const auto& format : m_formats) {
+    if (format.mime == mime) return this->load(format);
+  }
+
+  // not here
+  return QMimeData::retrieveData(mime, type);
+}
+
+/**
+ * @brief Construct a new Mime Data object of the items, the large
+ * formats that are not the first or the text are spilled on a
+ * thread so the clipboard is set at once
+ *
+ * @param items mime type and data
+ * @param syncId id of the sync the items came in if any
+ */
+MimeData::MimeData(const QVector<QPair<QString, QByteArray>>& items, quint64 syncId)
+    : m_syncId(syncId) {
+  // formats to spill
+  QList<qsizetype> indexes;
+
+  for (const auto& [mime, data] : items) {
+    // is the format pasted mostly
+    const auto isDefault = m_formats.isEmpty() || mime.startsWith("text/");
+
+    // spill the large formats that are rarely pasted
+    if (!isDefault && data.size() > spillSize) indexes.append(m_formats.size());
+
+    // the buffer is shared with the received packet
+    m_formats.append({mime, data, -1, data.size()});
+  }
+
+  // nothing to spill
+  if (indexes.isEmpty()) return;
+
+  // the file is opened on the thread
+  m_spill   = new QTemporaryFile(this);
+  m_spiller = std::thread([this, indexes] { this->spillFormats(indexes); });
+}
+
+/**
+ * @brief Destroy the Mime Data object after the spill
+ */
+MimeData::~MimeData() {
+  this->waitForSpill();
+}
+
+/**
+ * @brief Wait till the large formats are spilled
+ */
+void MimeData::waitForSpill() {
+  if (m_spiller.joinable()) m_spiller.join();
+}
+
+/**
+ * @brief Get the formats of the mime data
+ *
+ * @return QStringList
+ */
+QStringList MimeData::formats() const {
+  QStringList list;
+  for (const auto& format : m_formats) list.append(format.mime);
+  return list;
+}
+
+/**
+ * @brief Has the mime data the format
+ *
+ * @param mime mime type
+ * @return bool
+ */
+bool MimeData::hasFormat(const QString& mime) const {
+  for (const auto& format : m_formats) {
+    if (format.mime == mime) return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Get the items of the mime data, the spilled formats are
+ * read back
+ *
+ * @return QVector<QPair<QString, QByteArray>> mime type and data
+ */
+QVector<QPair<QString, QByteArray>> MimeData::items() const {
+  QVector<QPair<QString, QByteArray>> items;
+  for (const auto& format : m_formats) items.append({format.mime, this->load(format)});
+  return items;
+}
+
+/**
+ * @brief Get the bytes of the formats that are spilled so far
+ *
+ * @return qint64
+ */
+qint64 MimeData::getSpilledBytes() const {
+  return m_spilled.load();
+}
+
+/**
+ * @brief Get the id of the sync the items came in, zero if the
+ * items are not from a sync
+ *
+ * @return quint64
+ */
+quint64 MimeData::getSyncId() const {
+  return m_syncId;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::clipboard
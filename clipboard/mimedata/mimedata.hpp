@@ -0,0 +1,181 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt header
+#include <QByteArray>
+#include <QMetaType>
+#include <QMimeData>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QVariant>
+#include <QVector>
+
+// standard header
+#include <atomic>
+#include <thread>
+#include <utility>
+
+// project header
+#include "utility/metrics/metrics.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::clipboard {
+/**
+ * @brief Mime data of the items that came from a peer, the formats
+ * are not copied into the mime data but served when they are asked
+ * for, the first format and the text are kept in the buffers that
+ * were received and the other large formats are written to a spill
+ * file on a thread and read back only if they are pasted
+ */
+class MimeData : public QMimeData {
+ private:  // just for Qt
+
+  /// @brief Qt meta object
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(MimeData)
+
+ public:  // Constants
+
+  /// @brief Formats larger than it are spilled to the file
+  static constexpr qsizetype spillSize = 1024 * 1024;
+
+ private:  // Types
+
+  /**
+   * @brief Format of the mime data, the spilled format has no data
+   * but the offset of it in the spill file
+   */
+  struct Format {
+    QString mime;
+    QByteArray data;
+    qint64 offset  = -1;
+    qsizetype size = 0;
+  };
+
+ private:  // Member variables
+
+  /// @brief Formats in the order they came
+  QVector<Format> m_formats;
+
+  /// @brief File of the spilled formats, opened on the first spill
+  QTemporaryFile* m_spill = nullptr;
+
+  /// @brief Thread that spills the large formats
+  std::thread m_spiller;
+
+  /// @brief Lock of the formats and the file
+  mutable QMutex m_lock;
+
+  /// @brief Bytes of the formats that are spilled
+  std::atomic<qint64> m_spilled{0};
+
+  /// @brief Id of the sync the items came in or zero if local
+  quint64 m_syncId        = 0;
+
+ private:  // Member functions
+
+  /**
+   * @brief Write the data to the spill file
+   *
+   * @param data data to spill
+   * @return qint64 offset of the data or -1 if not spilled
+   */
+  qint64 spill(const QByteArray& data);
+
+  /**
+   * @brief Spill the formats on the thread, they are served from
+   * the buffers till all of them are written
+   *
+   * @param indexes indexes of the formats to spill
+   */
+  void spillFormats(const QList<qsizetype>& indexes);
+
+  /**
+   * @brief Get the data of the format from the buffer or the file
+   *
+   * @param format Format
+   * @return QByteArray data of the format
+   */
+  QByteArray load(const Format& format) const;
+
+ protected:  // override functions from the base class
+
+  /**
+   * @brief Get the data of the mime type when it is asked for
+   *
+   * @param mime mime type
+   * @param type preferred type
+   * @return QVariant data or invalid if the format is not here
+   */
+  QVariant retrieveData(const QString& mime, QMetaType type) const override;
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Mime Data object of the items, the large
+   * formats that are not the first or the text are spilled on a
+   * thread so the clipboard is set at once
+   *
+   * @param items mime type and data
+   * @param syncId id of the sync the items came in if any
+   */
+  explicit MimeData(const QVector<QPair<QString, QByteArray>>& items, quint64 syncId = 0);
+
+  /**
+   * @brief Destroy the Mime Data object after the spill
+   */
+  ~MimeData();
+
+  /**
+   * @brief Wait till the large formats are spilled
+   */
+  void waitForSpill();
+
+  /**
+   * @brief Get the formats of the mime data
+   *
+   * @return QStringList
+   */
+  QStringList formats() const override;
+
+  /**
+   * @brief Has the mime data the format
+   *
+   * @param mime mime type
+   * @return bool
+   */
+  bool hasFormat(const QString& mime) const override;
+
+  /**
+   * @brief Get the items of the mime data, the spilled formats are
+   * read back
+   *
+   * @return QVector<QPair<QString, QByteArray>> mime type and data
+   */
+  QVector<QPair<QString, QByteArray>> items() const;
+
+  /**
+   * @brief Get the bytes of the formats that are spilled so far
+   *
+   * @return qint64
+   */
+  qint64 getSpilledBytes() const;
+
+  /**
+   * @brief Get the id of the sync the items came in, zero if the
+   * items are not from a sync
+   *
+   * @return quint64
+   */
+  quint64 getSyncId() const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::clipboard
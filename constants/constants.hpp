@@ -20,7 +20,7 @@ namespace srilakshmikanthanp::clipbirdesk::constants {
  * @brief Get the Application Version
  * @return std::string
  */
-std::string getAppMajorVersion() {
+inline std::string getAppMajorVersion() {
   return std::string(CLIPBIRDESK_VERSION_MAJOR);
 }
 
@@ -28,7 +28,7 @@ std::string getAppMajorVersion() {
  * @brief Get the Application Version
  * @return std::string
  */
-std::string getAppMinorVersion() {
+inline std::string getAppMinorVersion() {
   return std::string(CLIPBIRDESK_VERSION_MINOR);
 }
 
@@ -36,15 +36,41 @@ std::string getAppMinorVersion() {
  * @brief Get the Application Version
  * @return std::string
  */
-std::string getAppPatchVersion() {
+inline std::string getAppPatchVersion() {
   return std::string(CLIPBIRDESK_VERSION_PATCH);
 }
 
+/**
+ * @brief Get the Protocol Version, it is changed when the packets
+ * change in a way the older versions can't read
+ * @return quint16
+ */
+inline quint16 getProtocolVersion() {
+  return 2;
+}
+
+/**
+ * @brief Get the oldest Protocol Version this version can talk to
+ * @return quint16
+ */
+inline quint16 getMinProtocolVersion() {
+  return 1;
+}
+
+/**
+ * @brief Get the Maximum Packet Size in bytes a peer may send, a
+ * packet or a reassembled stream that announces more is dropped
+ * @return qint64
+ */
+inline qint64 getMaxPacketSize() {
+  return qint64(512) << 20;
+}
+
 /**
  * @brief Get the Application Name
  * @return std::string
  */
-std::string getAppName() {
+inline std::string getAppName() {
   return std::string(CLIPBIRDESK_NAME);
 }
 
@@ -52,7 +78,7 @@ std::string getAppName() {
  * @brief Get logo path
  * @return std::string
  */
-std::string getAppLogo() {
+inline std::string getAppLogo() {
   return std::string(CLIPBIRDESK_LOGO);
 }
 
@@ -60,7 +86,7 @@ std::string getAppLogo() {
  * @brief Get App Home Directory
  * @return std::string
  */
-std::string getAppHome() {
+inline std::string getAppHome() {
   return (std::filesystem::path(getenv("HOME")) / ("." + getAppName())).string();
 }
 
@@ -68,7 +94,7 @@ std::string getAppHome() {
  * @brief Get the App Window Ratio
  * @return QSize
  */
-auto getAppWindowRatio() -> QSize {
+inline auto getAppWindowRatio() -> QSize {
   return QSize(4, 2);
 }
 }  // namespace srilakshmikanthanp::clipbirdesk::config
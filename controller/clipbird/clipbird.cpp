@@ -22,10 +22,11 @@ void ClipBird::handleServerStatusChanged(bool isConnected) {
 
   // if the client is connected then connect the signals
   if (isConnected) {
-    // Connect the onClipboardChange signal to the client
+    // Connect the onClipboardChange signal to the client once, the
+    // status is true again on every failover
     const auto signal = &clipboard::Clipboard::OnClipboardChange;
     const auto slot   = &Client::syncItems;
-    connect(&m_clipboard, signal, client, slot);
+    connect(&m_clipboard, signal, client, slot, Qt::UniqueConnection);
   } else {
     // Disconnect the onClipboardChange signal to the client
     const auto signal = &clipboard::Clipboard::OnClipboardChange;
@@ -34,6 +35,16 @@ void ClipBird::handleServerStatusChanged(bool isConnected) {
   }
 }
 
+/**
+ * @brief Handle the items to add to the history
+ *
+ * @param items items of the clipboard
+ * @param origin peer the items came from
+ */
+void ClipBird::handleHistoryItems(QVector<QPair<QString, QByteArray>> items, QString origin) {
+  m_history.add(items, origin);
+}
+
 /**
  * @brief Construct a new ClipBird object and manage
  * the clipboard, server and client
@@ -42,7 +53,41 @@ void ClipBird::handleServerStatusChanged(bool isConnected) {
  * @param parent parent object
  */
 ClipBird::ClipBird(QClipboard *board, QObject *parent)
-    : QObject(parent), m_clipboard(board, this) {}
+    : QObject(parent), m_clipboard(board, this) {
+  // the payloads in the history are not transferred again
+  m_blobs.setHistory(&m_history);
+
+  // hashes of the content in the history
+  QSet<QByteArray> hashes;
+  for (const auto &entry : m_history.getEntries()) hashes.insert(entry.hash);
+
+  // load the search index in the background
+  m_search.load(hashes);
+
+  // Connect the onErrorOccurred signal of the index to the signal
+  const auto signal_e = &storage::SearchIndex::OnErrorOccurred;
+  const auto slot_e   = &ClipBird::OnErrorOccurred;
+  connect(&m_search, signal_e, this, slot_e);
+
+  // Connect the onErrorOccurred signal of the history to the signal
+  const auto signal_w = &storage::History::OnErrorOccurred;
+  const auto slot_w   = &ClipBird::OnErrorOccurred;
+  connect(&m_history, signal_w, this, slot_w);
+
+  // index the entries once they are written to the history
+  const auto signal_a = &storage::History::OnAdded;
+  const auto slot_a   = [this](QByteArray hash, QVector<QPair<QString, QByteArray>> items) {
+    m_search.add(hash, items);
+  };
+  connect(&m_history, signal_a, this, slot_a);
+
+  // add the items copied on this host to the history
+  const auto signal_h = &clipboard::Clipboard::OnClipboardChange;
+  const auto slot_h   = [this](QVector<QPair<QString, QByteArray>> items) {
+    handleHistoryItems(items, QHostInfo::localHostName());
+  };
+  connect(&m_clipboard, signal_h, this, slot_h);
+}
 
 /**
  * @brief set the authenticator
@@ -80,6 +125,70 @@ QSslConfiguration ClipBird::getSSLConfiguration() const {
   return m_sslConfig;
 }
 
+/**
+ * @brief get the store of the pinned peers shared
+ * by the server and the client
+ *
+ * @return storage::TrustStore* trust store
+ */
+storage::TrustStore *ClipBird::getTrustStore() {
+  return &m_trustStore;
+}
+
+/**
+ * @brief get the history of the clipboard items that
+ * are copied here or synced from the peers
+ *
+ * @return storage::History* history
+ */
+storage::History *ClipBird::getHistory() {
+  return &m_history;
+}
+
+/**
+ * @brief set the clipboard to the entry of the history
+ *
+ * @param index index of the entry
+ */
+void ClipBird::restoreFromHistory(qsizetype index) {
+  m_clipboard.set(m_history.restore(index));
+}
+
+/**
+ * @brief find the entries of the history that have the
+ * query in their text
+ *
+ * @param query text to find
+ * @param limit maximum number of results
+ *
+ * @return QList<qsizetype> index of the entries from the newest
+ */
+QList<qsizetype> ClipBird::searchHistory(const QString &query, qsizetype limit) const {
+  // content that has the query
+  const auto hashes  = m_search.search(query, limit);
+
+  // entries of the history
+  const auto entries = m_history.getEntries();
+
+  // newest entry of the content
+  QHash<QByteArray, qsizetype> newest;
+  for (auto i = entries.size() - 1; i >= 0; i--) {
+    if (hashes.contains(entries.at(i).hash) && !newest.contains(entries.at(i).hash)) {
+      newest.insert(entries.at(i).hash, i);
+    }
+  }
+
+  // index of the entries in the order of the results, the
+  // content dropped from the history is skipped
+  QList<qsizetype> results;
+  for (const auto &hash : hashes) {
+    if (newest.contains(hash)) results.append(newest.value(hash));
+  }
+
+  // return the results
+  return results;
+}
+
 //---------------------- public slots -----------------------//
 
 /**
@@ -98,11 +207,22 @@ void ClipBird::setCurrentHostAsServer() {
   // Set the QSslConfiguration
   server->setSSLConfiguration(m_sslConfig);
 
+  // Set the store of the pinned peers
+  server->setTrustStore(&m_trustStore);
+
+  // Set the store of the payloads
+  server->setBlobStore(&m_blobs);
+
   // Connect the onClientStateChanged signal to the signal
   const auto signal_s = &Server::OnCLientStateChanged;
   const auto slot_s   = &ClipBird::OnCLientStateChanged;
   connect(server, signal_s, this, slot_s);
 
+  // Connect the onSyncRequest signal to the history
+  const auto signal_h = &Server::OnSyncRequest;
+  const auto slot_h   = &ClipBird::handleHistoryItems;
+  connect(server, signal_h, this, slot_h);
+
   // Connect the onSyncRequest signal to the clipboard
   const auto signal_c = &Server::OnSyncRequest;
   const auto slot_c   = &clipboard::Clipboard::set;
@@ -142,6 +262,17 @@ void ClipBird::setCurrentHostAsClient() {
   // Set the SSL Configuration
   client->setSSLConfiguration(m_sslConfig);
 
+  // Set the store of the pinned peers
+  client->setTrustStore(&m_trustStore);
+
+  // Set the store of the payloads
+  client->setBlobStore(&m_blobs);
+
+  // Set the authenticator to verify the unknown servers
+  if (m_authenticator != nullptr) {
+    client->setAuthenticator(m_authenticator);
+  }
+
   // Connect the onServerListChanged signal to the signal
   const auto signal_s = &Client::OnServerListChanged;
   const auto slot_s   = &ClipBird::OnServerListChanged;
@@ -155,15 +286,18 @@ void ClipBird::setCurrentHostAsClient() {
   // Connect the onServerStateChanged signal to the signal
   const auto signal_c = &Client::OnServerStatusChanged;
   const auto slot_c   = &ClipBird::handleServerStatusChanged;
-  const auto slot_d   = &ClipBird::handleServerStatusChanged;
   connect(client, signal_c, this, slot_c);
-  connect(client, signal_c, this, slot_d);
 
   // Connect the onErrorOccurred signal to the signal
   const auto signal_e = &Client::OnErrorOccurred;
   const auto slot_e   = &ClipBird::OnErrorOccurred;
   connect(client, signal_e, this, slot_e);
 
+  // Connect the onSyncRequest signal to the history
+  const auto signal_h = &Client::OnSyncRequest;
+  const auto slot_h   = &ClipBird::handleHistoryItems;
+  connect(client, signal_h, this, slot_h);
+
   // Connect the onSyncRequest signal to the clipboard
   const auto signal_r = &Client::OnSyncRequest;
   const auto slot_r   = &clipboard::Clipboard::set;
@@ -241,6 +375,46 @@ QPair<QHostAddress, quint16> ClipBird::getServerInfo() const {
   }
 }
 
+/**
+ * @brief Relay the syncs to an other server so the clients of
+ * both servers sync with each other
+ *
+ * @param peer host and port of the other server
+ */
+void ClipBird::addRelay(QPair<QHostAddress, quint16> peer) {
+  if (std::holds_alternative<Server>(m_host)) {
+    std::get<Server>(m_host).addRelay(peer);
+  } else {
+    throw std::runtime_error("Host is not server");
+  }
+}
+
+/**
+ * @brief Stop relaying the syncs to the other server
+ *
+ * @param peer host and port of the other server
+ */
+void ClipBird::removeRelay(QPair<QHostAddress, quint16> peer) {
+  if (std::holds_alternative<Server>(m_host)) {
+    std::get<Server>(m_host).removeRelay(peer);
+  } else {
+    throw std::runtime_error("Host is not server");
+  }
+}
+
+/**
+ * @brief Get the other servers that the syncs are relayed to
+ *
+ * @return QList<QPair<QHostAddress, quint16>> List of servers
+ */
+QList<QPair<QHostAddress, quint16>> ClipBird::getRelays() const {
+  if (std::holds_alternative<Server>(m_host)) {
+    return std::get<Server>(m_host).getRelays();
+  } else {
+    throw std::runtime_error("Host is not server");
+  }
+}
+
 //---------------------- Client functions -----------------------//
 
 /**
@@ -312,4 +486,62 @@ void ClipBird::disconnectFromServer(QPair<QHostAddress, quint16> host) {
   // disconnect from the server
   std::get<Client>(m_host).disconnectFromServer();
 }
+
+/**
+ * @brief Connect to the best server if the server is lost
+ *
+ * @param enabled
+ */
+void ClipBird::setFailover(bool enabled) {
+  if (std::holds_alternative<Client>(m_host)) {
+    std::get<Client>(m_host).setFailover(enabled);
+  } else {
+    throw std::runtime_error("Host is not client");
+  }
+}
+
+/**
+ * @brief Hold a connection to the next best pinned server so
+ * the failover is only a switch
+ *
+ * @param enabled
+ */
+void ClipBird::setStandby(bool enabled) {
+  if (std::holds_alternative<Client>(m_host)) {
+    std::get<Client>(m_host).setStandby(enabled);
+  } else {
+    throw std::runtime_error("Host is not client");
+  }
+}
+
+/**
+ * @brief Get only the items that are wanted from the server,
+ * the server drops the others before they are sent
+ *
+ * @param mimeTypes types to accept, one that ends with an asterisk is a prefix, empty for all
+ * @param maxItemSize larger items are dropped, 0 is no limit
+ * @param textOnly accept only the text
+ * @param paused accept nothing till it is resumed
+ */
+void ClipBird::setFilter(QStringList mimeTypes, quint32 maxItemSize, bool textOnly, bool paused) {
+  // if the host is not client then throw
+  if (!std::holds_alternative<Client>(m_host)) {
+    throw std::runtime_error("Host is not client");
+  }
+
+  // flags of the filter
+  using Flag         = network::packets::FilterPacket::Flag;
+  const quint8 flags = (paused ? Flag::Paused : 0) | (textOnly ? Flag::TextOnly : 0);
+
+  // types of the filter
+  QVector<QByteArray> types;
+  for (const auto &mime : mimeTypes) types.append(mime.toUtf8());
+
+  // create the filter
+  const auto packType = network::packets::FilterPacket::PacketType::Filter;
+  const auto filter   = utility::functions::createPacket({packType, flags, maxItemSize, types});
+
+  // set the filter
+  std::get<Client>(m_host).setFilter(filter);
+}
 }  // namespace srilakshmikanthanp::clipbirdesk::controller
@@ -19,6 +19,10 @@
 #include "clipboard/clipboard.hpp"
 #include "network/syncing/client/client.hpp"
 #include "network/syncing/server/server.hpp"
+#include "storage/blobstore/blobstore.hpp"
+#include "storage/history/history.hpp"
+#include "storage/searchindex/searchindex.hpp"
+#include "storage/truststore/truststore.hpp"
 #include "types/callback/callback.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::controller {
@@ -72,6 +76,10 @@ class ClipBird : public QObject {
   std::variant<Server, Client> m_host;
   QSslConfiguration m_sslConfig;
   clipboard::Clipboard m_clipboard;
+  storage::TrustStore m_trustStore;
+  storage::History m_history;
+  storage::BlobStore m_blobs;
+  storage::SearchIndex m_search;
   Authenticator m_authenticator = nullptr;
 
  private:  // private slots
@@ -79,6 +87,9 @@ class ClipBird : public QObject {
   /// @brief Handle On Server Status Changed (From client)
   void handleServerStatusChanged(bool isConnected);
 
+  /// @brief Handle the items to add to the history
+  void handleHistoryItems(QVector<QPair<QString, QByteArray>> items, QString origin);
+
  public:  // Member functions
 
   /**
@@ -138,6 +149,40 @@ class ClipBird : public QObject {
    */
   QSslConfiguration getSSLConfiguration() const;
 
+  /**
+   * @brief get the store of the pinned peers shared
+   * by the server and the client
+   *
+   * @return storage::TrustStore* trust store
+   */
+  storage::TrustStore* getTrustStore();
+
+  /**
+   * @brief get the history of the clipboard items that
+   * are copied here or synced from the peers
+   *
+   * @return storage::History* history
+   */
+  storage::History* getHistory();
+
+  /**
+   * @brief set the clipboard to the entry of the history
+   *
+   * @param index index of the entry
+   */
+  void restoreFromHistory(qsizetype index);
+
+  /**
+   * @brief find the entries of the history that have the
+   * query in their text
+   *
+   * @param query text to find
+   * @param limit maximum number of results
+   *
+   * @return QList<qsizetype> index of the entries from the newest
+   */
+  QList<qsizetype> searchHistory(const QString& query, qsizetype limit = 50) const;
+
   //---------------------- Server functions -----------------------//
 
   /**
@@ -165,6 +210,28 @@ class ClipBird : public QObject {
    */
   QPair<QHostAddress, quint16> getServerInfo() const;
 
+  /**
+   * @brief Relay the syncs to an other server so the clients of
+   * both servers sync with each other
+   *
+   * @param peer host and port of the other server
+   */
+  void addRelay(QPair<QHostAddress, quint16> peer);
+
+  /**
+   * @brief Stop relaying the syncs to the other server
+   *
+   * @param peer host and port of the other server
+   */
+  void removeRelay(QPair<QHostAddress, quint16> peer);
+
+  /**
+   * @brief Get the other servers that the syncs are relayed to
+   *
+   * @return QList<QPair<QHostAddress, quint16>> List of servers
+   */
+  QList<QPair<QHostAddress, quint16>> getRelays() const;
+
   //---------------------- Client functions -----------------------//
 
   /**
@@ -194,5 +261,31 @@ class ClipBird : public QObject {
    * @brief Disconnect from the server
    */
   void disconnectFromServer(QPair<QHostAddress, quint16> host);
+
+  /**
+   * @brief Connect to the best server if the server is lost
+   *
+   * @param enabled
+   */
+  void setFailover(bool enabled);
+
+  /**
+   * @brief Hold a connection to the next best pinned server so
+   * the failover is only a switch
+   *
+   * @param enabled
+   */
+  void setStandby(bool enabled);
+
+  /**
+   * @brief Get only the items that are wanted from the server,
+   * the server drops the others before they are sent
+   *
+   * @param mimeTypes types to accept, one that ends with an asterisk is a prefix, empty for all
+   * @param maxItemSize larger items are dropped, 0 is no limit
+   * @param textOnly accept only the text
+   * @param paused accept nothing till it is resumed
+   */
+  void setFilter(QStringList mimeTypes, quint32 maxItemSize, bool textOnly, bool paused);
 };
 }  // namespace srilakshmikanthanp::clipbirdesk::controller
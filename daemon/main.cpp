@@ -0,0 +1,197 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+/**
+ * This File starts the headless daemon that runs the controller
+ * as a server or client without any widgets, so it can run as
+ * a relay on a box that has no display
+ */
+
+// Qt Headers
+#include <QClipboard>
+#include <QCommandLineParser>
+#include <QGuiApplication>
+#include <QHostAddress>
+#include <QSettings>
+
+// C++ Headers
+#include <csignal>
+#include <cstdlib>
+
+// Project Headers
+#include "constants/constants.hpp"
+#include "controller/clipbird/clipbird.hpp"
+#include "network/exporter/exporter.hpp"
+#include "utility/functions/sslcert/sslcert.hpp"
+#include "utility/logging/logging.hpp"
+#include "utility/tracing/tracing.hpp"
+
+using namespace srilakshmikanthanp::clipbirdesk;
+
+/**
+ * @brief main function that starts the daemon as server or
+ * client as per the config file and command line flags, the
+ * flags take precedence over the config file
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments
+ *
+ * @return int Status code
+ */
+auto main(int argc, char **argv) -> int {
+  // use the offscreen platform unless one is given so
+  // the daemon starts on a box that has no display
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  // create the application without widgets
+  QGuiApplication app(argc, argv);
+
+  // set the application details
+  QGuiApplication::setApplicationName(QString::fromStdString(constants::getAppName()));
+
+  // command line parser
+  QCommandLineParser parser;
+
+  // command line options
+  const QCommandLineOption clientOpt("client", "Run as client instead of server");
+  const QCommandLineOption connectOpt("connect", "Server to connect as client", "host:port");
+  const QCommandLineOption trustOpt("trust-new", "Pin and accept peers that are not pinned");
+  const QCommandLineOption configOpt("config", "Config file with the same keys", "file");
+  const QCommandLineOption metricsOpt("metrics", "Serve metrics on localhost port", "port");
+  const QCommandLineOption logOpt("log", "Write the logs to the file instead of stderr", "file");
+  const QCommandLineOption traceOpt("trace", "Write the spans as Chrome trace JSON", "file");
+  const QCommandLineOption relayOpt("relay", "Other server to relay the syncs to", "host:port");
+  const QCommandLineOption standbyOpt("standby", "Hold a connection to the next best server");
+  const QCommandLineOption acceptOpt("accept", "Mime type to get from the server", "mime");
+  const QCommandLineOption maxSizeOpt("max-item-size", "Largest item to get", "bytes");
+  const QCommandLineOption textOnlyOpt("text-only", "Get only the text from the server");
+
+  // add the options
+  parser.setApplicationDescription("Headless clipbird daemon");
+  parser.addHelpOption();
+  parser.addOptions({clientOpt, connectOpt, trustOpt, configOpt, metricsOpt, logOpt, traceOpt, relayOpt, standbyOpt});
+  parser.addOptions({acceptOpt, maxSizeOpt, textOnlyOpt});
+
+  // parse the arguments
+  parser.process(app);
+
+  // read the config file if given
+  QSettings config(parser.value(configOpt), QSettings::IniFormat);
+
+  // resolve the option from flags or config
+  const auto isSet = [&](const QCommandLineOption &opt) {
+    return parser.isSet(opt) || config.value(opt.names().first(), false).toBool();
+  };
+
+  // resolve the value from flags or config
+  const auto value = [&](const QCommandLineOption &opt) {
+    return parser.isSet(opt) ? parser.value(opt) : config.value(opt.names().first()).toString();
+  };
+
+  // resolved options
+  const auto isClient    = isSet(clientOpt);
+  const auto trustNew    = isSet(trustOpt);
+  const auto standby     = isSet(standbyOpt);
+  const auto textOnly    = isSet(textOnlyOpt);
+  const auto maxItemSize = value(maxSizeOpt).toUInt();
+  const auto server      = value(connectOpt);
+  const auto metricsPort = value(metricsOpt);
+  const auto logFile     = value(logOpt);
+  const auto traceFile   = value(traceOpt);
+  const auto relays      = parser.isSet(relayOpt) ? parser.values(relayOpt)
+                                                  : config.value("relay").toStringList();
+  const auto accepts     = parser.isSet(acceptOpt) ? parser.values(acceptOpt)
+                                                   : config.value("accept").toStringList();
+
+  // log to the file if asked
+  if (!logFile.isEmpty()) {
+    qInstallMessageHandler(logging::createFileMessageHandler(logFile));
+  }
+
+  // write the spans to the file if asked
+  if (!traceFile.isEmpty() && tracing::start(traceFile)) {
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [] { tracing::stop(); });
+  }
+
+  // serve the metrics if asked
+  network::exporter::Exporter exporter;
+  if (!metricsPort.isEmpty()) {
+    try {
+      exporter.start(metricsPort.toUShort());
+    } catch (const std::exception &e) {
+      qCritical("Failed to serve metrics on port %s: %s", qUtf8Printable(metricsPort), e.what());
+      logging::flush();
+      return EXIT_FAILURE;
+    }
+    qInfo("Serving metrics on 127.0.0.1:%u/metrics", exporter.getPort());
+  }
+
+  // create the controller
+  auto controller     = controller::ClipBird(QGuiApplication::clipboard());
+
+  // nobody is there to answer so unknown peers are
+  // either pinned or rejected as per the flag
+  const auto authenticator = [trustNew](QPair<QHostAddress, quint16> host, auto result) {
+    qInfo("%s peer %s:%u", trustNew ? "Trusting" : "Rejecting",
+        qUtf8Printable(host.first.toString()), host.second);
+    result(trustNew);
+  };
+
+  // set Authenticator
+  controller.setAuthenticator(authenticator);
+
+  // identity kept in app home so the peers pin it once
+  const auto home = QString::fromStdString(constants::getAppHome());
+
+  // set the ssl config
+  controller.setSSLConfiguration(utility::functions::getQSslConfiguration(home));
+
+  // log the errors
+  const auto signal_e = &controller::ClipBird::OnErrorOccurred;
+  const auto slot_e   = [](QString error) { qWarning("%s", qUtf8Printable(error)); };
+  QObject::connect(&controller, signal_e, slot_e);
+
+  signal(SIGTERM, [](int sig) { qApp->quit(); });
+  signal(SIGABRT, [](int sig) { qApp->quit(); });
+  signal(SIGINT, [](int sig) { qApp->quit(); });
+
+  // parse the host:port of the peer
+  const auto toPeer = [](const QString &peer) -> QPair<QHostAddress, quint16> {
+    const auto sep = peer.lastIndexOf(':');
+    return {QHostAddress(peer.left(sep)), peer.mid(sep + 1).toUShort()};
+  };
+
+  // start as server if not client
+  if (!isClient) {
+    controller.setCurrentHostAsServer();
+    const auto [host, port] = controller.getServerInfo();
+    qInfo("Listening on %s:%u", qUtf8Printable(host.toString()), port);
+    for (const auto &relay : relays) {
+      controller.addRelay(toPeer(relay));
+      qInfo("Relaying to %s", qUtf8Printable(relay));
+    }
+    return app.exec();
+  }
+
+  // start as client
+  controller.setCurrentHostAsClient();
+
+  // keep connected to the best server that is found
+  controller.setFailover(true);
+  controller.setStandby(standby);
+
+  // get only the items that are wanted
+  controller.setFilter(accepts, maxItemSize, textOnly, false);
+
+  // connect to the given server first
+  if (!server.isEmpty()) {
+    controller.connectToServer(toPeer(server));
+  }
+
+  // return the status code of the app
+  return app.exec();
+}
@@ -24,6 +24,8 @@
 #include "ui/gui/utilities/utilities.hpp"
 #include "ui/gui/window/window.hpp"
 #include "utility/functions/sslcert/sslcert.hpp"
+#include "utility/logging/logging.hpp"
+#include "utility/tracing/tracing.hpp"
 
 using namespace srilakshmikanthanp::clipbirdesk;
 
@@ -38,14 +40,25 @@ using namespace srilakshmikanthanp::clipbirdesk;
  * @return int Status code
  */
 auto main(int argc, char **argv) -> int {
+  // log to the file off the GUI thread
+  qInstallMessageHandler(logging::createFileMessageHandler());
+
   // create SingleApplication instance
   QApplication app(argc, argv);
 
+  // write the spans to the file if asked
+  if (const auto file = qEnvironmentVariable("CLIPBIRD_TRACE"); !file.isEmpty()) {
+    if (tracing::start(file)) {
+      QObject::connect(&app, &QCoreApplication::aboutToQuit, [] { tracing::stop(); });
+    }
+  }
+
   // create the controller
   auto controller = controller::ClipBird(QApplication::clipboard());
 
-  // Create the SSL Config
-  auto sslConfig  = utility::functions::getQSslConfiguration();
+  // Create the SSL Config of the identity kept in app home
+  const auto home = QString::fromStdString(constants::getAppHome());
+  auto sslConfig  = utility::functions::getQSslConfiguration(home);
 
   // set Authenticator
   controller.setAuthenticator(ui::gui::authenticator);
@@ -28,14 +28,17 @@ void Client::processDiscoveryPacket(const packets::DiscoveryPacket& packet) {
   const auto port = packet.getHostPort();
   const auto type = packet.getIpType();
 
+  // time from the last broadcast to the response
+  const auto rtt  = QDeadlineTimer::current().deadlineNSecs() - m_broadcastAt;
+
   // Create the QHostAddress from the IP address
   QHostAddress address;
 
   // convert the IP address to QHostAddress
   if (type == types::enums::IPType::IPv4) {
-    this->onServerFound({toIPV4QHostAddress(host), port});
+    this->onServerFound({toIPV4QHostAddress(host), port}, rtt, packet);
   } else {
-    this->onServerFound({toIPV6QHostAddress(host), port});
+    this->onServerFound({toIPV6QHostAddress(host), port}, rtt, packet);
   }
 }
 
@@ -53,6 +56,9 @@ void Client::processDatagrams() {
     // Read the datagram
     m_socket->readDatagram(data.data(), data.size(), &address, &port);
 
+    // record the datagram
+    metrics::Registry::instance().counter("clipbird_discovery_datagrams_received_total").inc();
+
     // using fromQByteArray to parse the packet
     using utility::functions::fromQByteArray;
 
@@ -105,6 +111,9 @@ void Client::sendBroadcastMessage() {
   // Create the packet
   packets::DiscoveryPacket packet = createPacket({pakT, types::enums::IPType::IPv4, host, port});
 
+  // the responses are timed from here
+  m_broadcastAt = QDeadlineTimer::current().deadlineNSecs();
+
   // Send the data to the broadcast address
   this->sendPacket(packet, QHostAddress::Broadcast, 0);
 }
@@ -11,6 +11,7 @@
 
 // Qt headers
 #include <QByteArray>
+#include <QDeadlineTimer>
 #include <QHostAddress>
 #include <QObject>
 #include <QTimer>
@@ -24,6 +25,7 @@
 #include "types/except/except.hpp"
 #include "utility/functions/ipconv/ipconv.hpp"
 #include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/metrics/metrics.hpp"
 #include "utility/functions/packet/packet.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::network::discovery {
@@ -41,6 +43,9 @@ class Client : public QObject {
   /// @brief Timer to send the broadcast message
   QTimer* m_timer      = new QTimer(this);
 
+  /// @brief Time of the last broadcast in nanoseconds
+  qint64 m_broadcastAt = 0;
+
  private:  // Just for Qt
 
   Q_OBJECT
@@ -65,6 +70,7 @@ class Client : public QObject {
   template <typename Packet>
   void sendPacket(const Packet& pack, const QHostAddress& host, quint16 port) {
     m_socket->writeDatagram(utility::functions::toQByteArray(pack), host, port);
+    metrics::Registry::instance().counter("clipbird_discovery_datagrams_sent_total").inc();
   }
 
   /**
@@ -123,9 +129,12 @@ class Client : public QObject {
    * @brief On server found abstract function that
    * is called when the server is found
    *
-   * @param host Host address
-   * @param port Port number
+   * @param server Host address and port number
+   * @param rtt time from the broadcast to the response in nanoseconds
+   * @param packet response with the load and the version of the server
    */
-  virtual void onServerFound(QPair<QHostAddress, quint16>) = 0;
+  virtual void onServerFound(
+      QPair<QHostAddress, quint16> server, qint64 rtt, const packets::DiscoveryPacket& packet
+  ) = 0;
 };
 }  // namespace srilakshmikanthanp::clipbirdesk::network::discovery
@@ -35,11 +35,18 @@ void Server::processDiscoveryPacket(const packets::DiscoveryPacket& packet) {
     address = toIPV6QHostAddress(host);
   }
 
-  // set the IP address and port number
+  // set the IP address and port number along with the load
+  // and the version so the clients can choose between servers
   try {
 #define PARAMS pakType, getIPType(), getIPAddress(), getPort()
-    this->sendPacket(createPacket({PARAMS}), address, port);
+    auto response = createPacket({PARAMS});
 #undef PARAMS  // just used to avoid long line
+    response.setClientCount(getClientCount());
+    response.setCapacity(getCapacity());
+    response.setProtocolVersion(constants::getProtocolVersion());
+    response.setCodecs(getCodecs());
+    response.setPacketLength(response.size());
+    this->sendPacket(response, address, port);
   } catch (...) {
     return;  // return if any error occurs
   }
@@ -57,6 +64,9 @@ void Server::processDatagrams() {
     quint16 port;
     m_socket->readDatagram(data.data(), data.size(), &addr, &port);
 
+    // record the datagram
+    metrics::Registry::instance().counter("clipbird_discovery_datagrams_received_total").inc();
+
     // Using the ipconv namespace to convert the IP address
     using utility::functions::createPacket;
     using utility::functions::fromQByteArray;
@@ -18,12 +18,14 @@
 #include <QtLogging>
 
 // Local headers
+#include "constants/constants.hpp"
 #include "network/packets/discoverypacket/discoverypacket.hpp"
 #include "network/packets/invalidrequest/invalidrequest.hpp"
 #include "types/enums/enums.hpp"
 #include "types/except/except.hpp"
 #include "utility/functions/ipconv/ipconv.hpp"
 #include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/metrics/metrics.hpp"
 #include "utility/functions/packet/packet.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::network::discovery {
@@ -67,6 +69,7 @@ class Server : public QObject {
   template <typename Packet>
   void sendPacket(const Packet& pack, const QHostAddress& host, quint16 port) {
     m_socket->writeDatagram(utility::functions::toQByteArray(pack), host, port);
+    metrics::Registry::instance().counter("clipbird_discovery_datagrams_sent_total").inc();
   }
 
   /**
@@ -129,6 +132,29 @@ class Server : public QObject {
    */
   virtual QHostAddress getIPAddress() const      = 0;
 
+  /**
+   * @brief Get the number of the clients connected to the server
+   * that is advertised so the clients can pick a lightly loaded one
+   *
+   * @return quint32 number of the clients
+   */
+  virtual quint32 getClientCount() const         = 0;
+
+  /**
+   * @brief Get the number of the clients the server accepts
+   *
+   * @return quint32 number of the clients
+   */
+  virtual quint32 getCapacity() const            = 0;
+
+  /**
+   * @brief Get the encodings of the syncing items the server
+   * supports, bit n is set if the encoding n is supported
+   *
+   * @return quint32 bits of the encodings
+   */
+  virtual quint32 getCodecs() const              = 0;
+
  public:
 
   /**
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "exporter.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::exporter {
+/**
+ * @brief Accept the pending connections
+ */
+void Exporter::processConnections() {
+  while (m_server->hasPendingConnections()) {
+    // Get the scraper that has been connected
+    auto socket = m_server->nextPendingConnection();
+
+    // answer once the request line has arrived
+    const auto signal_r = &QTcpSocket::readyRead;
+    const auto slot_r   = [this, socket]() { this->processRequest(socket); };
+    QObject::connect(socket, signal_r, this, slot_r);
+
+    // release the socket once it is closed
+    const auto signal_d = &QTcpSocket::disconnected;
+    const auto slot_d   = &QTcpSocket::deleteLater;
+    QObject::connect(socket, signal_d, socket, slot_d);
+  }
+}
+
+/**
+ * @brief Answer the request once the request line arrived
+ *
+ * @param socket socket of the scraper
+ */
+void Exporter::processRequest(QTcpSocket* socket) {
+  // wait for the request line
+  if (!socket->canReadLine()) {
+    if (socket->bytesAvailable() > m_maxRequest) socket->abort();
+    return;
+  }
+
+  // answer only once
+  QObject::disconnect(socket, &QTcpSocket::readyRead, this, nullptr);
+
+  // method and path of the request
+  const auto parts = socket->readLine().trimmed().split(' ');
+  const auto path  = parts.size() > 1 ? parts[1] : QByteArray();
+
+  // status, content type and body
+  QByteArray status = "200 OK", type, body;
+
+  // route the request
+  if (parts[0] != "GET") {
+    status = "405 Method Not Allowed";
+  } else if (path == "/metrics") {
+    type = "text/plain; version=0.0.4; charset=utf-8";
+    body = metrics::Registry::instance().toPrometheus();
+  } else if (path == "/metrics.json") {
+    type = "application/json";
+    body = metrics::Registry::instance().toJson();
+  } else {
+    status = "404 Not Found";
+  }
+
+  // response head
+  QByteArray response = "HTTP/1.1 " + status + "\r\n";
+
+  // content type if any
+  if (!type.isEmpty()) response += "Content-Type: " + type + "\r\n";
+
+  // length and close
+  response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+  response += "Connection: close\r\n\r\n";
+
+  // write the response and close
+  socket->write(response + body);
+  socket->disconnectFromHost();
+}
+
+/**
+ * @brief Construct a new Exporter object
+ *
+ * @param parent Parent object
+ */
+Exporter::Exporter(QObject* parent) : QObject(parent) {
+  const auto signal_c = &QTcpServer::pendingConnectionAvailable;
+  const auto slot_c   = &Exporter::processConnections;
+  QObject::connect(m_server, signal_c, this, slot_c);
+}
+
+/**
+ * @brief Start listening on the loopback
+ *
+ * @param port port to listen or 0 for any
+ * @throw std::runtime_error if failed to listen
+ */
+void Exporter::start(quint16 port) {
+  if (!m_server->listen(QHostAddress::LocalHost, port)) {
+    throw std::runtime_error(m_server->errorString().toStdString());
+  }
+}
+
+/**
+ * @brief Stop listening
+ */
+void Exporter::stop() {
+  m_server->close();
+}
+
+/**
+ * @brief Get the port the exporter listens on
+ *
+ * @return quint16 port
+ */
+quint16 Exporter::getPort() const {
+  return m_server->serverPort();
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::exporter
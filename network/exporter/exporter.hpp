@@ -0,0 +1,94 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QHostAddress>
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+// C++ headers
+#include <stdexcept>
+
+// project headers
+#include "utility/metrics/metrics.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::exporter {
+/**
+ * @brief Minimal HTTP endpoint that serves the metrics registry,
+ * GET /metrics gives the prometheus text format and GET
+ * /metrics.json gives the JSON dump, it listens on the loopback
+ * only since the metrics name the peers
+ */
+class Exporter : public QObject {
+ private:  // just for Qt
+
+  /// @brief Qt meta object
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(Exporter)
+
+ private:  // Member variables
+
+  /// @brief Server that accepts the scrapes
+  QTcpServer* m_server = new QTcpServer(this);
+
+  /// @brief Maximum size of the request head
+  const qint64 m_maxRequest = 8192;
+
+ private:  // private functions
+
+  /**
+   * @brief Accept the pending connections
+   */
+  void processConnections();
+
+  /**
+   * @brief Answer the request once the request line arrived
+   *
+   * @param socket socket of the scraper
+   */
+  void processRequest(QTcpSocket* socket);
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Exporter object
+   *
+   * @param parent Parent object
+   */
+  explicit Exporter(QObject* parent = nullptr);
+
+  /**
+   * @brief Destroy the Exporter object
+   */
+  ~Exporter() override = default;
+
+  /**
+   * @brief Start listening on the loopback
+   *
+   * @param port port to listen or 0 for any
+   * @throw std::runtime_error if failed to listen
+   */
+  void start(quint16 port);
+
+  /**
+   * @brief Stop listening
+   */
+  void stop();
+
+  /**
+   * @brief Get the port the exporter listens on
+   *
+   * @return quint16 port
+   */
+  quint16 getPort() const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::exporter
@@ -0,0 +1,236 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "blobpacket.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Set the Packet Type object
+ *
+ * @param type
+ */
+void BlobPacket::setPacketType(quint8 type) {
+  if (type != PacketType::WantBlobs && type != PacketType::SendBlobs) {
+    throw std::invalid_argument("Invalid Packet Type");
+  } else {
+    this->packetType = type;
+  }
+}
+
+/**
+ * @brief Get the Packet Type object
+ *
+ * @return quint8
+ */
+quint8 BlobPacket::getPacketType() const noexcept {
+  return this->packetType;
+}
+
+/**
+ * @brief Set the Packet Length object
+ *
+ * @param length
+ */
+void BlobPacket::setPacketLength(qint32 length) {
+  this->packetLength = length;
+}
+
+/**
+ * @brief Get the Packet Length object
+ *
+ * @return qint32
+ */
+qint32 BlobPacket::getPacketLength() const noexcept {
+  return this->packetLength;
+}
+
+/**
+ * @brief Set the Sync Id object, it is the id of the syncing
+ * packet that has the references
+ *
+ * @param id
+ */
+void BlobPacket::setSyncId(quint64 id) {
+  this->syncId = id;
+}
+
+/**
+ * @brief Get the Sync Id object
+ *
+ * @return quint64
+ */
+quint64 BlobPacket::getSyncId() const noexcept {
+  return this->syncId;
+}
+
+/**
+ * @brief Set the Blob Count object
+ *
+ * @param count
+ */
+void BlobPacket::setBlobCount(qint32 count) {
+  this->blobCount = count;
+}
+
+/**
+ * @brief Get the Blob Count object
+ *
+ * @return qint32
+ */
+qint32 BlobPacket::getBlobCount() const noexcept {
+  return this->blobCount;
+}
+
+/**
+ * @brief Set the Blobs object
+ *
+ * @param blobs hashes or payloads
+ */
+void BlobPacket::setBlobs(const QVector<QByteArray>& blobs) {
+  if (blobs.size() != this->blobCount) {
+    throw std::invalid_argument("Invalid Blobs");
+  }
+
+  this->blobs = blobs;
+}
+
+/**
+ * @brief Get the Blobs object
+ *
+ * @return QVector<QByteArray>
+ */
+QVector<QByteArray> BlobPacket::getBlobs() const noexcept {
+  return this->blobs;
+}
+
+/**
+ * @brief Get the size of the packet
+ *
+ * @return size_t
+ */
+size_t BlobPacket::size() const noexcept {
+  size_t size = sizeof(this->packetType) + sizeof(this->packetLength) + sizeof(this->syncId) +
+                sizeof(this->blobCount);
+
+  for (const auto& blob : this->blobs) {
+    size += sizeof(qint32) + blob.size();
+  }
+
+  return size;
+}
+
+/**
+ * @brief Overloaded operator<< for QDataStream
+ *
+ * @param out
+ * @param packet
+ */
+QDataStream& operator<<(QDataStream& out, const BlobPacket& packet) {
+  // write the packet type
+  out << packet.packetType;
+
+  // write the packet length
+  out << packet.packetLength;
+
+  // write the sync id
+  out << packet.syncId;
+
+  // write the blob count
+  out << packet.blobCount;
+
+  // check enough blobs
+  if (packet.blobCount != packet.blobs.size()) {
+    throw std::invalid_argument("Invalid Blobs");
+  }
+
+  // write the blobs with their length
+  for (const auto& blob : packet.blobs) {
+    out << static_cast<qint32>(blob.size());
+    out.writeRawData(blob.data(), blob.size());
+  }
+
+  // return the stream
+  return out;
+}
+
+/**
+ * @brief Overloaded operator>> for QDataStream
+ *
+ * @param in
+ * @param packet
+ */
+QDataStream& operator>>(QDataStream& in, BlobPacket& packet) {
+  // read the packet type
+  in >> packet.packetType;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // check the packet type
+  if (packet.packetType != BlobPacket::PacketType::WantBlobs &&
+      packet.packetType != BlobPacket::PacketType::SendBlobs) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // read the packet length
+  in >> packet.packetLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Length"
+    );
+  }
+
+  // read the sync id
+  in >> packet.syncId;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Sync Id");
+  }
+
+  // read the blob count
+  in >> packet.blobCount;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok || packet.blobCount < 0) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Blob Count"
+    );
+  }
+
+  // read the blobs
+  for (int i = 0; i < packet.blobCount; i++) {
+    // length of the blob
+    qint32 length = 0;
+    in >> length;
+
+    // check the length
+    if (in.status() != QDataStream::Ok || length < 0) {
+      throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Blob");
+    }
+
+    // read the blob
+    QByteArray blob(length, Qt::Uninitialized);
+    in.readRawData(blob.data(), length);
+    packet.blobs.push_back(blob);
+  }
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Blobs");
+  }
+
+  // return the stream
+  return in;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
@@ -0,0 +1,138 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Standard header files
+#include <stdexcept>
+
+// Qt header files
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QVector>
+#include <QtTypes>
+
+// Local header files
+#include "types/enums/enums.hpp"
+#include "types/except/except.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Blob Packet that asks for the payloads of a syncing packet
+ * by their hash and answers with the payloads, the want packet has
+ * the hashes and the blob packet has the payloads
+ */
+class BlobPacket {
+ private:  // private members
+
+  quint8 packetType = 0x04;
+  qint32 packetLength;
+  quint64 syncId = 0;
+  qint32 blobCount;
+  QVector<QByteArray> blobs;
+
+ public:
+
+  /// @brief Allowed Packet Types
+  enum PacketType : quint8 { WantBlobs = 0x04, SendBlobs = 0x05 };
+
+ public:
+
+  /**
+   * @brief Set the Packet Type object
+   *
+   * @param type
+   */
+  void setPacketType(quint8 type);
+
+  /**
+   * @brief Get the Packet Type object
+   *
+   * @return quint8
+   */
+  quint8 getPacketType() const noexcept;
+
+  /**
+   * @brief Set the Packet Length object
+   *
+   * @param length
+   */
+  void setPacketLength(qint32 length);
+
+  /**
+   * @brief Get the Packet Length object
+   *
+   * @return qint32
+   */
+  qint32 getPacketLength() const noexcept;
+
+  /**
+   * @brief Set the Sync Id object, it is the id of the syncing
+   * packet that has the references
+   *
+   * @param id
+   */
+  void setSyncId(quint64 id);
+
+  /**
+   * @brief Get the Sync Id object
+   *
+   * @return quint64
+   */
+  quint64 getSyncId() const noexcept;
+
+  /**
+   * @brief Set the Blob Count object
+   *
+   * @param count
+   */
+  void setBlobCount(qint32 count);
+
+  /**
+   * @brief Get the Blob Count object
+   *
+   * @return qint32
+   */
+  qint32 getBlobCount() const noexcept;
+
+  /**
+   * @brief Set the Blobs object
+   *
+   * @param blobs hashes or payloads
+   */
+  void setBlobs(const QVector<QByteArray>& blobs);
+
+  /**
+   * @brief Get the Blobs object
+   *
+   * @return QVector<QByteArray>
+   */
+  QVector<QByteArray> getBlobs() const noexcept;
+
+  /**
+   * @brief Get the size of the packet
+   *
+   * @return size_t
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Overloaded operator<< for QDataStream
+   *
+   * @param out
+   * @param packet
+   */
+  friend QDataStream& operator<<(QDataStream& out, const BlobPacket& packet);
+
+  /**
+   * @brief Overloaded operator>> for QDataStream
+   *
+   * @param in
+   * @param packet
+   */
+  friend QDataStream& operator>>(QDataStream& in, BlobPacket& packet);
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
@@ -0,0 +1,232 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "chunkpacket.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Set the Packet Type object
+ *
+ * @param type
+ */
+void ChunkPacket::setPacketType(quint8 type) {
+  if (type != PacketType::Chunk) {
+    throw std::invalid_argument("Invalid Packet Type");
+  } else {
+    this->packetType = type;
+  }
+}
+
+/**
+ * @brief Get the Packet Type object
+ *
+ * @return quint8
+ */
+quint8 ChunkPacket::getPacketType() const noexcept {
+  return this->packetType;
+}
+
+/**
+ * @brief Set the Packet Length object
+ *
+ * @param length
+ */
+void ChunkPacket::setPacketLength(qint32 length) {
+  this->packetLength = length;
+}
+
+/**
+ * @brief Get the Packet Length object
+ *
+ * @return qint32
+ */
+qint32 ChunkPacket::getPacketLength() const noexcept {
+  return this->packetLength;
+}
+
+/**
+ * @brief Set the Stream Id object, it is the id of the large
+ * packet the chunk is part of
+ *
+ * @param id
+ */
+void ChunkPacket::setStreamId(quint32 id) {
+  this->streamId = id;
+}
+
+/**
+ * @brief Get the Stream Id object
+ *
+ * @return quint32
+ */
+quint32 ChunkPacket::getStreamId() const noexcept {
+  return this->streamId;
+}
+
+/**
+ * @brief Set the Flags object
+ *
+ * @param flags bits of the Flag
+ */
+void ChunkPacket::setFlags(quint8 flags) {
+  this->flags = flags;
+}
+
+/**
+ * @brief Get the Flags object
+ *
+ * @return quint8
+ */
+quint8 ChunkPacket::getFlags() const noexcept {
+  return this->flags;
+}
+
+/**
+ * @brief Set the Payload Length object
+ *
+ * @param length
+ */
+void ChunkPacket::setPayloadLength(qint32 length) {
+  this->payloadLength = length;
+}
+
+/**
+ * @brief Get the Payload Length object
+ *
+ * @return qint32
+ */
+qint32 ChunkPacket::getPayloadLength() const noexcept {
+  return this->payloadLength;
+}
+
+/**
+ * @brief Set the Payload object
+ *
+ * @param payload part of the packet
+ */
+void ChunkPacket::setPayload(const QByteArray& payload) {
+  if (payload.size() != this->payloadLength) {
+    throw std::invalid_argument("Invalid Payload");
+  }
+
+  this->payload = payload;
+}
+
+/**
+ * @brief Get the Payload object, it is borrowed from the chunk
+ *
+ * @return const QByteArray&
+ */
+const QByteArray& ChunkPacket::getPayload() const noexcept {
+  return this->payload;
+}
+
+/**
+ * @brief Get the size of the packet
+ *
+ * @return size_t
+ */
+size_t ChunkPacket::size() const noexcept {
+  return sizeof(this->packetType) + sizeof(this->packetLength) + sizeof(this->streamId) +
+         sizeof(this->flags) + sizeof(this->payloadLength) + this->payload.size();
+}
+
+/**
+ * @brief Overloaded operator<< for QDataStream
+ *
+ * @param out
+ * @param packet
+ */
+QDataStream& operator<<(QDataStream& out, const ChunkPacket& packet) {
+  // write the packet type
+  out << packet.packetType;
+
+  // write the packet length
+  out << packet.packetLength;
+
+  // write the stream id
+  out << packet.streamId;
+
+  // write the flags
+  out << packet.flags;
+
+  // check the payload length
+  if (packet.payloadLength != packet.payload.size()) {
+    throw std::invalid_argument("Invalid Payload");
+  }
+
+  // write the payload with its length
+  out << packet.payloadLength;
+  out.writeRawData(packet.payload.data(), packet.payload.size());
+
+  // return the stream
+  return out;
+}
+
+/**
+ * @brief Overloaded operator>> for QDataStream
+ *
+ * @param in
+ * @param packet
+ */
+QDataStream& operator>>(QDataStream& in, ChunkPacket& packet) {
+  // read the packet type
+  in >> packet.packetType;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // check the packet type
+  if (packet.packetType != ChunkPacket::PacketType::Chunk) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // read the packet length
+  in >> packet.packetLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Length"
+    );
+  }
+
+  // read the stream id and the flags
+  in >> packet.streamId >> packet.flags;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Stream");
+  }
+
+  // read the payload length
+  in >> packet.payloadLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok || packet.payloadLength < 0) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Payload Length"
+    );
+  }
+
+  // read the payload
+  packet.payload.resize(packet.payloadLength);
+  in.readRawData(packet.payload.data(), packet.payloadLength);
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Payload");
+  }
+
+  // return the stream
+  return in;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
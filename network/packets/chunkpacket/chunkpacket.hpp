@@ -0,0 +1,155 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Standard header files
+#include <stdexcept>
+
+// Qt header files
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QtTypes>
+
+// Local header files
+#include "types/enums/enums.hpp"
+#include "types/except/except.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Chunk Packet that carries a part of a large packet so the
+ * small packets can be sent between the parts, the parts of the
+ * same stream are joined in order to get the packet back
+ */
+class ChunkPacket {
+ private:  // private members
+
+  quint8 packetType    = 0x08;
+  qint32 packetLength  = 0;
+  quint32 streamId     = 0;
+  quint8 flags         = 0;
+  qint32 payloadLength = 0;
+  QByteArray payload;
+
+ public:
+
+  /// @brief Allowed Packet Types
+  enum PacketType : quint8 { Chunk = 0x08 };
+
+  /// @brief Flags of the chunk, a cancelled stream is dropped by the receiver
+  enum Flag : quint8 { First = 1u << 0, Last = 1u << 1, Cancel = 1u << 2 };
+
+ public:
+
+  /**
+   * @brief Set the Packet Type object
+   *
+   * @param type
+   */
+  void setPacketType(quint8 type);
+
+  /**
+   * @brief Get the Packet Type object
+   *
+   * @return quint8
+   */
+  quint8 getPacketType() const noexcept;
+
+  /**
+   * @brief Set the Packet Length object
+   *
+   * @param length
+   */
+  void setPacketLength(qint32 length);
+
+  /**
+   * @brief Get the Packet Length object
+   *
+   * @return qint32
+   */
+  qint32 getPacketLength() const noexcept;
+
+  /**
+   * @brief Set the Stream Id object, it is the id of the large
+   * packet the chunk is part of
+   *
+   * @param id
+   */
+  void setStreamId(quint32 id);
+
+  /**
+   * @brief Get the Stream Id object
+   *
+   * @return quint32
+   */
+  quint32 getStreamId() const noexcept;
+
+  /**
+   * @brief Set the Flags object
+   *
+   * @param flags bits of the Flag
+   */
+  void setFlags(quint8 flags);
+
+  /**
+   * @brief Get the Flags object
+   *
+   * @return quint8
+   */
+  quint8 getFlags() const noexcept;
+
+  /**
+   * @brief Set the Payload Length object
+   *
+   * @param length
+   */
+  void setPayloadLength(qint32 length);
+
+  /**
+   * @brief Get the Payload Length object
+   *
+   * @return qint32
+   */
+  qint32 getPayloadLength() const noexcept;
+
+  /**
+   * @brief Set the Payload object
+   *
+   * @param payload part of the packet
+   */
+  void setPayload(const QByteArray& payload);
+
+  /**
+   * @brief Get the Payload object, it is borrowed from the chunk
+   *
+   * @return const QByteArray&
+   */
+  const QByteArray& getPayload() const noexcept;
+
+  /**
+   * @brief Get the size of the packet
+   *
+   * @return size_t
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Overloaded operator<< for QDataStream
+   *
+   * @param out
+   * @param packet
+   */
+  friend QDataStream& operator<<(QDataStream& out, const ChunkPacket& packet);
+
+  /**
+   * @brief Overloaded operator>> for QDataStream
+   *
+   * @param in
+   * @param packet
+   */
+  friend QDataStream& operator>>(QDataStream& in, ChunkPacket& packet);
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
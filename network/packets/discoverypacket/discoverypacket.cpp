@@ -6,6 +6,27 @@
 #include "discoverypacket.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::network::packets {
+namespace {
+/**
+ * @brief Encode the number as big endian bytes
+ */
+template <typename Number>
+QByteArray encodeNumber(Number number) {
+  QByteArray bytes(sizeof(Number), Qt::Uninitialized);
+  qToBigEndian(number, bytes.data());
+  return bytes;
+}
+
+/**
+ * @brief Decode the big endian bytes, 0 if the size is not right
+ */
+template <typename Number>
+Number decodeNumber(const QByteArray& bytes) {
+  if (bytes.size() != sizeof(Number)) return 0;
+  return qFromBigEndian<Number>(bytes.constData());
+}
+}  // namespace
+
 /**
  * @brief Set the Packet Type object
  *
@@ -126,15 +147,143 @@ qint16 DiscoveryPacket::getHostPort() const noexcept {
   return this->hostPort;
 }
 
+/**
+ * @brief Set the Field object
+ *
+ * @param type
+ * @param value
+ */
+void DiscoveryPacket::setField(quint8 type, const QByteArray& value) {
+  // the length of the value is two bytes
+  if (value.size() > 0xFFFF) {
+    throw std::invalid_argument("Invalid field length");
+  }
+
+  // set the field
+  this->fields.insert(type, value);
+}
+
+/**
+ * @brief Get the Field object
+ *
+ * @param type
+ * @return QByteArray empty if not present
+ */
+QByteArray DiscoveryPacket::getField(quint8 type) const noexcept {
+  return this->fields.value(type);
+}
+
+/**
+ * @brief Has the packet the field
+ *
+ * @param type
+ * @return bool
+ */
+bool DiscoveryPacket::hasField(quint8 type) const noexcept {
+  return this->fields.contains(type);
+}
+
+/**
+ * @brief Get the Fields object
+ *
+ * @return QMap<quint8, QByteArray>
+ */
+QMap<quint8, QByteArray> DiscoveryPacket::getFields() const noexcept {
+  return this->fields;
+}
+
+/**
+ * @brief Set the Client Count object, number of the clients
+ * connected to the server
+ *
+ * @param count
+ */
+void DiscoveryPacket::setClientCount(quint32 count) {
+  this->setField(Field::ClientCount, encodeNumber(count));
+}
+
+/**
+ * @brief Get the Client Count object
+ *
+ * @return quint32 0 if not present
+ */
+quint32 DiscoveryPacket::getClientCount() const noexcept {
+  return decodeNumber<quint32>(this->getField(Field::ClientCount));
+}
+
+/**
+ * @brief Set the Capacity object, number of the clients the
+ * server accepts
+ *
+ * @param capacity
+ */
+void DiscoveryPacket::setCapacity(quint32 capacity) {
+  this->setField(Field::Capacity, encodeNumber(capacity));
+}
+
+/**
+ * @brief Get the Capacity object
+ *
+ * @return quint32 0 if not present
+ */
+quint32 DiscoveryPacket::getCapacity() const noexcept {
+  return decodeNumber<quint32>(this->getField(Field::Capacity));
+}
+
+/**
+ * @brief Set the Protocol Version object
+ *
+ * @param version
+ */
+void DiscoveryPacket::setProtocolVersion(quint16 version) {
+  this->setField(Field::ProtocolVersion, encodeNumber(version));
+}
+
+/**
+ * @brief Get the Protocol Version object
+ *
+ * @return quint16 0 if not present
+ */
+quint16 DiscoveryPacket::getProtocolVersion() const noexcept {
+  return decodeNumber<quint16>(this->getField(Field::ProtocolVersion));
+}
+
+/**
+ * @brief Set the Codecs object, bit n is set if the encoding
+ * n of the syncing items is supported
+ *
+ * @param codecs
+ */
+void DiscoveryPacket::setCodecs(quint32 codecs) {
+  this->setField(Field::Codecs, encodeNumber(codecs));
+}
+
+/**
+ * @brief Get the Codecs object
+ *
+ * @return quint32 0 if not present
+ */
+quint32 DiscoveryPacket::getCodecs() const noexcept {
+  return decodeNumber<quint32>(this->getField(Field::Codecs));
+}
+
 /**
  * @brief Get the Size of the Packet
  *
  * @return std::size_t
  */
 std::size_t DiscoveryPacket::size() const noexcept {
-  return (
-      sizeof(packetType) + sizeof(packetLength) + sizeof(ipType) + sizeof(hostPort) + hostIp.size()
-  );
+  // size of the fixed part
+  auto size = sizeof(packetType) + sizeof(packetLength) + sizeof(ipType) + sizeof(hostPort) +
+              hostIp.size();
+
+  // type, length and value of the fields
+  for (const auto& value : fields) {
+    size += sizeof(quint8) + sizeof(quint16) + value.size();
+  }
+
+  // return the size
+  return size;
 }
 
 /**
@@ -165,6 +314,12 @@ QDataStream& operator<<(QDataStream& stream, const DiscoveryPacket& packet) {
   // write the port
   stream << packet.hostPort;
 
+  // write the fields
+  for (auto it = packet.fields.cbegin(); it != packet.fields.cend(); ++it) {
+    stream << it.key() << static_cast<quint16>(it.value().size());
+    stream.writeRawData(it.value().data(), it.value().size());
+  }
+
   // return the stream
   return stream;
 }
@@ -230,6 +385,29 @@ QDataStream& operator>>(QDataStream& stream, DiscoveryPacket& packet) {
     throw types::except::MalformedPacket(types::enums::CodingError, "Invalid Port");
   }
 
+  // read the fields till the end, older peers send none
+  while (!stream.atEnd()) {
+    quint8 type;
+    quint16 length;
+
+    // read the type and the length
+    stream >> type >> length;
+
+    // read the value
+    QByteArray value(length, Qt::Uninitialized);
+    if (stream.readRawData(value.data(), length) != length) {
+      throw types::except::MalformedPacket(types::enums::CodingError, "Invalid Field");
+    }
+
+    // is the stream status is bad
+    if (stream.status() != QDataStream::Ok) {
+      throw types::except::MalformedPacket(types::enums::CodingError, "Invalid Field");
+    }
+
+    // keep the field
+    packet.fields.insert(type, value);
+  }
+
   // return the stream
   return stream;
 }
@@ -12,6 +12,8 @@
 #include <QByteArray>
 #include <QDataStream>
 #include <QIODevice>
+#include <QMap>
+#include <QtEndian>
 #include <QtTypes>
 
 // Local header files
@@ -30,12 +32,17 @@ class DiscoveryPacket {
   quint8 ipType;
   QByteArray hostIp;
   qint16 hostPort;
+  QMap<quint8, QByteArray> fields;
 
  public:
 
   /// @brief Allowed Packet Types
   enum PacketType : quint8 { Request = 0x01, Response = 0x02 };
 
+  /// @brief Known fields of the response, the fields that are not
+  /// known are kept as they are so new fields can be added later
+  enum Field : quint8 { ClientCount = 0x01, Capacity = 0x02, ProtocolVersion = 0x03, Codecs = 0x04 };
+
  public:
 
   /**
@@ -108,6 +115,96 @@ class DiscoveryPacket {
    */
   qint16 getHostPort() const noexcept;
 
+  /**
+   * @brief Set the Field object
+   *
+   * @param type
+   * @param value
+   */
+  void setField(quint8 type, const QByteArray& value);
+
+  /**
+   * @brief Get the Field object
+   *
+   * @param type
+   * @return QByteArray empty if not present
+   */
+  QByteArray getField(quint8 type) const noexcept;
+
+  /**
+   * @brief Has the packet the field
+   *
+   * @param type
+   * @return bool
+   */
+  bool hasField(quint8 type) const noexcept;
+
+  /**
+   * @brief Get the Fields object
+   *
+   * @return QMap<quint8, QByteArray>
+   */
+  QMap<quint8, QByteArray> getFields() const noexcept;
+
+  /**
+   * @brief Set the Client Count object, number of the clients
+   * connected to the server
+   *
+   * @param count
+   */
+  void setClientCount(quint32 count);
+
+  /**
+   * @brief Get the Client Count object
+   *
+   * @return quint32 0 if not present
+   */
+  quint32 getClientCount() const noexcept;
+
+  /**
+   * @brief Set the Capacity object, number of the clients the
+   * server accepts
+   *
+   * @param capacity
+   */
+  void setCapacity(quint32 capacity);
+
+  /**
+   * @brief Get the Capacity object
+   *
+   * @return quint32 0 if not present
+   */
+  quint32 getCapacity() const noexcept;
+
+  /**
+   * @brief Set the Protocol Version object
+   *
+   * @param version
+   */
+  void setProtocolVersion(quint16 version);
+
+  /**
+   * @brief Get the Protocol Version object
+   *
+   * @return quint16 0 if not present
+   */
+  quint16 getProtocolVersion() const noexcept;
+
+  /**
+   * @brief Set the Codecs object, bit n is set if the encoding
+   * n of the syncing items is supported
+   *
+   * @param codecs
+   */
+  void setCodecs(quint32 codecs);
+
+  /**
+   * @brief Get the Codecs object
+   *
+   * @return quint32 0 if not present
+   */
+  quint32 getCodecs() const noexcept;
+
   /**
    * @brief Get the Size of the Packet
    *
@@ -0,0 +1,262 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "filterpacket.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Set the Packet Type object
+ *
+ * @param type
+ */
+void FilterPacket::setPacketType(quint8 type) {
+  if (type != PacketType::Filter) {
+    throw std::invalid_argument("Invalid Packet Type");
+  } else {
+    this->packetType = type;
+  }
+}
+
+/**
+ * @brief Get the Packet Type object
+ *
+ * @return quint8
+ */
+quint8 FilterPacket::getPacketType() const noexcept {
+  return this->packetType;
+}
+
+/**
+ * @brief Set the Packet Length object
+ *
+ * @param length
+ */
+void FilterPacket::setPacketLength(qint32 length) {
+  this->packetLength = length;
+}
+
+/**
+ * @brief Get the Packet Length object
+ *
+ * @return qint32
+ */
+qint32 FilterPacket::getPacketLength() const noexcept {
+  return this->packetLength;
+}
+
+/**
+ * @brief Set the Flags object
+ *
+ * @param flags bits of the Flag
+ */
+void FilterPacket::setFlags(quint8 flags) {
+  this->flags = flags;
+}
+
+/**
+ * @brief Get the Flags object
+ *
+ * @return quint8
+ */
+quint8 FilterPacket::getFlags() const noexcept {
+  return this->flags;
+}
+
+/**
+ * @brief Set the Max Item Size object, the larger items are
+ * dropped, 0 is no limit
+ *
+ * @param size
+ */
+void FilterPacket::setMaxItemSize(quint32 size) {
+  this->maxItemSize = size;
+}
+
+/**
+ * @brief Get the Max Item Size object
+ *
+ * @return quint32
+ */
+quint32 FilterPacket::getMaxItemSize() const noexcept {
+  return this->maxItemSize;
+}
+
+/**
+ * @brief Set the Mime Count object
+ *
+ * @param count
+ */
+void FilterPacket::setMimeCount(qint32 count) {
+  this->mimeCount = count;
+}
+
+/**
+ * @brief Get the Mime Count object
+ *
+ * @return qint32
+ */
+qint32 FilterPacket::getMimeCount() const noexcept {
+  return this->mimeCount;
+}
+
+/**
+ * @brief Set the Mime Types object, only the items of the types
+ * are accepted, a type that ends with an asterisk is a prefix and no
+ * types accept all
+ *
+ * @param types
+ */
+void FilterPacket::setMimeTypes(const QVector<QByteArray>& types) {
+  if (types.size() != this->mimeCount) {
+    throw std::invalid_argument("Invalid Mime Types");
+  }
+
+  this->mimeTypes = types;
+}
+
+/**
+ * @brief Get the Mime Types object
+ *
+ * @return QVector<QByteArray>
+ */
+QVector<QByteArray> FilterPacket::getMimeTypes() const noexcept {
+  return this->mimeTypes;
+}
+
+/**
+ * @brief Get the size of the packet
+ *
+ * @return size_t
+ */
+size_t FilterPacket::size() const noexcept {
+  size_t size = sizeof(this->packetType) + sizeof(this->packetLength) + sizeof(this->flags) +
+                sizeof(this->maxItemSize) + sizeof(this->mimeCount);
+
+  for (const auto& mime : this->mimeTypes) {
+    size += sizeof(qint32) + mime.size();
+  }
+
+  return size;
+}
+
+/**
+ * @brief Overloaded operator<< for QDataStream
+ *
+ * @param out
+ * @param packet
+ */
+QDataStream& operator<<(QDataStream& out, const FilterPacket& packet) {
+  // write the packet type
+  out << packet.packetType;
+
+  // write the packet length
+  out << packet.packetLength;
+
+  // write the flags
+  out << packet.flags;
+
+  // write the max item size
+  out << packet.maxItemSize;
+
+  // write the mime count
+  out << packet.mimeCount;
+
+  // check enough mime types
+  if (packet.mimeCount != packet.mimeTypes.size()) {
+    throw std::invalid_argument("Invalid Mime Types");
+  }
+
+  // write the mime types with their length
+  for (const auto& mime : packet.mimeTypes) {
+    out << static_cast<qint32>(mime.size());
+    out.writeRawData(mime.data(), mime.size());
+  }
+
+  // return the stream
+  return out;
+}
+
+/**
+ * @brief Overloaded operator>> for QDataStream
+ *
+ * @param in
+ * @param packet
+ */
+QDataStream& operator>>(QDataStream& in, FilterPacket& packet) {
+  // read the packet type
+  in >> packet.packetType;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // check the packet type
+  if (packet.packetType != FilterPacket::PacketType::Filter) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // read the packet length
+  in >> packet.packetLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Length"
+    );
+  }
+
+  // read the flags and the max item size
+  in >> packet.flags >> packet.maxItemSize;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Filter");
+  }
+
+  // read the mime count
+  in >> packet.mimeCount;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok || packet.mimeCount < 0) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Mime Count"
+    );
+  }
+
+  // read the mime types
+  for (int i = 0; i < packet.mimeCount; i++) {
+    // length of the mime type
+    qint32 length = 0;
+    in >> length;
+
+    // check the length
+    if (in.status() != QDataStream::Ok || length < 0) {
+      throw types::except::MalformedPacket(
+          types::enums::ErrorCode::CodingError, "Invalid Mime Type"
+      );
+    }
+
+    // read the mime type
+    QByteArray mime(length, Qt::Uninitialized);
+    in.readRawData(mime.data(), length);
+    packet.mimeTypes.push_back(mime);
+  }
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Mime Types"
+    );
+  }
+
+  // return the stream
+  return in;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
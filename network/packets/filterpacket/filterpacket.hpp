@@ -0,0 +1,158 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Standard header files
+#include <stdexcept>
+
+// Qt header files
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QVector>
+#include <QtTypes>
+
+// Local header files
+#include "types/enums/enums.hpp"
+#include "types/except/except.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Filter Packet that the client sends to the server to get
+ * only the items it wants, the server drops the other items before
+ * they are encoded for the client, the default accepts all
+ */
+class FilterPacket {
+ private:  // private members
+
+  quint8 packetType   = 0x07;
+  qint32 packetLength = 0;
+  quint8 flags        = 0;
+  quint32 maxItemSize = 0;
+  qint32 mimeCount    = 0;
+  QVector<QByteArray> mimeTypes;
+
+ public:
+
+  /// @brief Allowed Packet Types
+  enum PacketType : quint8 { Filter = 0x07 };
+
+  /// @brief Flags of the filter
+  enum Flag : quint8 { Paused = 1u << 0, TextOnly = 1u << 1 };
+
+ public:
+
+  /**
+   * @brief Set the Packet Type object
+   *
+   * @param type
+   */
+  void setPacketType(quint8 type);
+
+  /**
+   * @brief Get the Packet Type object
+   *
+   * @return quint8
+   */
+  quint8 getPacketType() const noexcept;
+
+  /**
+   * @brief Set the Packet Length object
+   *
+   * @param length
+   */
+  void setPacketLength(qint32 length);
+
+  /**
+   * @brief Get the Packet Length object
+   *
+   * @return qint32
+   */
+  qint32 getPacketLength() const noexcept;
+
+  /**
+   * @brief Set the Flags object
+   *
+   * @param flags bits of the Flag
+   */
+  void setFlags(quint8 flags);
+
+  /**
+   * @brief Get the Flags object
+   *
+   * @return quint8
+   */
+  quint8 getFlags() const noexcept;
+
+  /**
+   * @brief Set the Max Item Size object, the larger items are
+   * dropped, 0 is no limit
+   *
+   * @param size
+   */
+  void setMaxItemSize(quint32 size);
+
+  /**
+   * @brief Get the Max Item Size object
+   *
+   * @return quint32
+   */
+  quint32 getMaxItemSize() const noexcept;
+
+  /**
+   * @brief Set the Mime Count object
+   *
+   * @param count
+   */
+  void setMimeCount(qint32 count);
+
+  /**
+   * @brief Get the Mime Count object
+   *
+   * @return qint32
+   */
+  qint32 getMimeCount() const noexcept;
+
+  /**
+   * @brief Set the Mime Types object, only the items of the types
+   * are accepted, a type that ends with an asterisk is a prefix and no
+   * types accept all
+   *
+   * @param types
+   */
+  void setMimeTypes(const QVector<QByteArray>& types);
+
+  /**
+   * @brief Get the Mime Types object
+   *
+   * @return QVector<QByteArray>
+   */
+  QVector<QByteArray> getMimeTypes() const noexcept;
+
+  /**
+   * @brief Get the size of the packet
+   *
+   * @return size_t
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Overloaded operator<< for QDataStream
+   *
+   * @param out
+   * @param packet
+   */
+  friend QDataStream& operator<<(QDataStream& out, const FilterPacket& packet);
+
+  /**
+   * @brief Overloaded operator>> for QDataStream
+   *
+   * @param in
+   * @param packet
+   */
+  friend QDataStream& operator>>(QDataStream& in, FilterPacket& packet);
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
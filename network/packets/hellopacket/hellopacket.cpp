@@ -0,0 +1,195 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "hellopacket.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Set the Packet Type object
+ *
+ * @param type
+ */
+void HelloPacket::setPacketType(quint8 type) {
+  if (type != PacketType::Hello) {
+    throw std::invalid_argument("Invalid Packet Type");
+  } else {
+    this->packetType = type;
+  }
+}
+
+/**
+ * @brief Get the Packet Type object
+ *
+ * @return quint8
+ */
+quint8 HelloPacket::getPacketType() const noexcept {
+  return this->packetType;
+}
+
+/**
+ * @brief Set the Packet Length object
+ *
+ * @param length
+ */
+void HelloPacket::setPacketLength(qint32 length) {
+  this->packetLength = length;
+}
+
+/**
+ * @brief Get the Packet Length object
+ *
+ * @return qint32
+ */
+qint32 HelloPacket::getPacketLength() const noexcept {
+  return this->packetLength;
+}
+
+/**
+ * @brief Set the Version object, it is the newest protocol
+ * version the peer talks
+ *
+ * @param version
+ */
+void HelloPacket::setVersion(quint16 version) {
+  this->version = version;
+}
+
+/**
+ * @brief Get the Version object
+ *
+ * @return quint16
+ */
+quint16 HelloPacket::getVersion() const noexcept {
+  return this->version;
+}
+
+/**
+ * @brief Set the Min Version object, it is the oldest protocol
+ * version the peer talks
+ *
+ * @param version
+ */
+void HelloPacket::setMinVersion(quint16 version) {
+  if (version > this->version) {
+    throw std::invalid_argument("Invalid Min Version");
+  }
+
+  this->minVersion = version;
+}
+
+/**
+ * @brief Get the Min Version object
+ *
+ * @return quint16
+ */
+quint16 HelloPacket::getMinVersion() const noexcept {
+  return this->minVersion;
+}
+
+/**
+ * @brief Set the Features object
+ *
+ * @param features bits of the Feature
+ */
+void HelloPacket::setFeatures(quint32 features) {
+  this->features = features;
+}
+
+/**
+ * @brief Get the Features object
+ *
+ * @return quint32
+ */
+quint32 HelloPacket::getFeatures() const noexcept {
+  return this->features;
+}
+
+/**
+ * @brief Get the size of the packet
+ *
+ * @return size_t
+ */
+size_t HelloPacket::size() const noexcept {
+  return sizeof(this->packetType) + sizeof(this->packetLength) + sizeof(this->version) +
+         sizeof(this->minVersion) + sizeof(this->features);
+}
+
+/**
+ * @brief Overloaded operator<< for QDataStream
+ *
+ * @param out
+ * @param packet
+ */
+QDataStream& operator<<(QDataStream& out, const HelloPacket& packet) {
+  // write the packet type
+  out << packet.packetType;
+
+  // write the packet length
+  out << packet.packetLength;
+
+  // write the versions
+  out << packet.version << packet.minVersion;
+
+  // write the features
+  out << packet.features;
+
+  // return the stream
+  return out;
+}
+
+/**
+ * @brief Overloaded operator>> for QDataStream
+ *
+ * @param in
+ * @param packet
+ */
+QDataStream& operator>>(QDataStream& in, HelloPacket& packet) {
+  // read the packet type
+  in >> packet.packetType;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // check the packet type
+  if (packet.packetType != HelloPacket::PacketType::Hello) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Type"
+    );
+  }
+
+  // read the packet length
+  in >> packet.packetLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Length"
+    );
+  }
+
+  // read the versions
+  in >> packet.version >> packet.minVersion;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok || packet.minVersion > packet.version) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Version");
+  }
+
+  // read the features
+  in >> packet.features;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Features");
+  }
+
+  // return the stream
+  return in;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
@@ -0,0 +1,148 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Standard header files
+#include <stdexcept>
+
+// Qt header files
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QtTypes>
+
+// Local header files
+#include "types/enums/enums.hpp"
+#include "types/except/except.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::packets {
+/**
+ * @brief Hello Packet that both the peers send once the connection
+ * is verified, it has the protocol versions the peer talks and the
+ * features it supports, the peers use the lower version and the
+ * features that both of them have
+ */
+class HelloPacket {
+ private:  // private members
+
+  quint8 packetType = 0x06;
+  qint32 packetLength;
+  quint16 version    = 0;
+  quint16 minVersion = 0;
+  quint32 features   = 0;
+
+ public:
+
+  /// @brief Allowed Packet Types
+  enum PacketType : quint8 { Hello = 0x06 };
+
+  /// @brief Features of the peer, bit n of the low byte is the encoding n of the items
+  enum Feature : quint32 {
+    InlineItems    = 1u << 0,
+    ReferenceItems = 1u << 1,
+    DeltaItems     = 1u << 2,
+    Filters        = 1u << 8,
+    Chunks         = 1u << 9,
+  };
+
+ public:
+
+  /**
+   * @brief Set the Packet Type object
+   *
+   * @param type
+   */
+  void setPacketType(quint8 type);
+
+  /**
+   * @brief Get the Packet Type object
+   *
+   * @return quint8
+   */
+  quint8 getPacketType() const noexcept;
+
+  /**
+   * @brief Set the Packet Length object
+   *
+   * @param length
+   */
+  void setPacketLength(qint32 length);
+
+  /**
+   * @brief Get the Packet Length object
+   *
+   * @return qint32
+   */
+  qint32 getPacketLength() const noexcept;
+
+  /**
+   * @brief Set the Version object, it is the newest protocol
+   * version the peer talks
+   *
+   * @param version
+   */
+  void setVersion(quint16 version);
+
+  /**
+   * @brief Get the Version object
+   *
+   * @return quint16
+   */
+  quint16 getVersion() const noexcept;
+
+  /**
+   * @brief Set the Min Version object, it is the oldest protocol
+   * version the peer talks
+   *
+   * @param version
+   */
+  void setMinVersion(quint16 version);
+
+  /**
+   * @brief Get the Min Version object
+   *
+   * @return quint16
+   */
+  quint16 getMinVersion() const noexcept;
+
+  /**
+   * @brief Set the Features object
+   *
+   * @param features bits of the Feature
+   */
+  void setFeatures(quint32 features);
+
+  /**
+   * @brief Get the Features object
+   *
+   * @return quint32
+   */
+  quint32 getFeatures() const noexcept;
+
+  /**
+   * @brief Get the size of the packet
+   *
+   * @return size_t
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Overloaded operator<< for QDataStream
+   *
+   * @param out
+   * @param packet
+   */
+  friend QDataStream& operator<<(QDataStream& out, const HelloPacket& packet);
+
+  /**
+   * @brief Overloaded operator>> for QDataStream
+   *
+   * @param in
+   * @param packet
+   */
+  friend QDataStream& operator>>(QDataStream& in, HelloPacket& packet);
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::packets
@@ -37,14 +37,36 @@ void SyncingItem::setMimeType(const QByteArray& type) {
 }
 
 /**
- * @brief Get the Mime Type object
+ * @brief Get the Mime Type object, it is borrowed from the item
  *
- * @return QByteArray
+ * @return const QByteArray&
  */
-QByteArray SyncingItem::getMimeType() const noexcept {
+const QByteArray& SyncingItem::getMimeType() const noexcept {
   return this->mimeType;
 }
 
+/**
+ * @brief Set the Encoding object
+ *
+ * @param encoding
+ */
+void SyncingItem::setEncoding(quint8 encoding) {
+  if (encoding > Encoding::Delta) {
+    throw std::invalid_argument("Invalid Encoding");
+  } else {
+    this->encoding = encoding;
+  }
+}
+
+/**
+ * @brief Get the Encoding object
+ *
+ * @return quint8
+ */
+quint8 SyncingItem::getEncoding() const noexcept {
+  return this->encoding;
+}
+
 /**
  * @brief Set the Payload Length object
  *
@@ -77,14 +99,24 @@ void SyncingItem::setPayload(const QByteArray& payload) {
 }
 
 /**
- * @brief Get the Payload object
+ * @brief Get the Payload object, it is borrowed from the item
  *
- * @return QByteArray
+ * @return const QByteArray&
  */
-QByteArray SyncingItem::getPayload() const noexcept {
+const QByteArray& SyncingItem::getPayload() const noexcept {
   return this->payload;
 }
 
+/**
+ * @brief Take the Payload object out of the item that is not
+ * used anymore
+ *
+ * @return QByteArray
+ */
+QByteArray SyncingItem::takePayload() && noexcept {
+  return std::move(this->payload);
+}
+
 /**
  * @brief Get the size of the packet
  *
@@ -92,8 +124,8 @@ QByteArray SyncingItem::getPayload() const noexcept {
  */
 size_t SyncingItem::size() const noexcept {
   return (
-      sizeof(this->mimeLength) + this->mimeType.size() + sizeof(this->payloadLength) +
-      this->payload.size()
+      sizeof(this->mimeLength) + this->mimeType.size() + sizeof(this->encoding) +
+      sizeof(this->payloadLength) + this->payload.size()
   );
 }
 
@@ -115,6 +147,9 @@ QDataStream& operator<<(QDataStream& out, const SyncingItem& payload) {
   // write the mime type
   out.writeRawData(payload.mimeType.data(), payload.mimeLength);
 
+  // write the encoding
+  out << payload.encoding;
+
   // write the payload length
   out << payload.payloadLength;
 
@@ -158,6 +193,19 @@ QDataStream& operator>>(QDataStream& in, SyncingItem& payload) {
     throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Mime Type");
   }
 
+  // read the encoding
+  in >> payload.encoding;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Encoding");
+  }
+
+  // check the encoding
+  if (payload.encoding > SyncingItem::Encoding::Delta) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Encoding");
+  }
+
   // read the payload length
   in >> payload.payloadLength;
 
@@ -168,7 +216,7 @@ QDataStream& operator>>(QDataStream& in, SyncingItem& payload) {
     );
   }
 
-  // resize the payload
+  // resize the payload, it is the only copy of it out of the frame
   payload.payload.resize(payload.payloadLength);
 
   // read the payload
@@ -225,6 +273,63 @@ qint32 SyncingPacket::getPacketLength() const noexcept {
   return this->packetLength;
 }
 
+/**
+ * @brief Set the Sync Id object, it is the same for the packet
+ * and its forwards so the traces of the peers can be correlated
+ *
+ * @param id
+ */
+void SyncingPacket::setSyncId(quint64 id) {
+  this->syncId = id;
+}
+
+/**
+ * @brief Get the Sync Id object
+ *
+ * @return quint64
+ */
+quint64 SyncingPacket::getSyncId() const noexcept {
+  return this->syncId;
+}
+
+/**
+ * @brief Set the Origin Id object, it is the id of the node the
+ * sync started at so a relay drops the sync that came back to it
+ *
+ * @param id
+ */
+void SyncingPacket::setOriginId(quint64 id) {
+  this->originId = id;
+}
+
+/**
+ * @brief Get the Origin Id object
+ *
+ * @return quint64
+ */
+quint64 SyncingPacket::getOriginId() const noexcept {
+  return this->originId;
+}
+
+/**
+ * @brief Set the Hop Count object, it is the number of relays
+ * the sync has been forwarded through
+ *
+ * @param count
+ */
+void SyncingPacket::setHopCount(quint8 count) {
+  this->hopCount = count;
+}
+
+/**
+ * @brief Get the Hop Count object
+ *
+ * @return quint8
+ */
+quint8 SyncingPacket::getHopCount() const noexcept {
+  return this->hopCount;
+}
+
 /**
  * @brief Set the Item Count object
  *
@@ -257,31 +362,184 @@ void SyncingPacket::setItems(const QVector<SyncingItem>& payloads) {
 }
 
 /**
- * @brief Get the Payloads object
+ * @brief Set the Payloads object by moving them in
  *
- * @return QVector<Payload>
+ * @param payloads
  */
-QVector<SyncingItem> SyncingPacket::getItems() const noexcept {
+void SyncingPacket::setItems(QVector<SyncingItem>&& payloads) {
+  if (payloads.size() != this->itemCount) {
+    throw std::invalid_argument("Invalid Payloads");
+  }
+
+  this->items = std::move(payloads);
+}
+
+/**
+ * @brief Get the Payloads object, they are borrowed from the packet
+ *
+ * @return const QVector<SyncingItem>&
+ */
+const QVector<SyncingItem>& SyncingPacket::getItems() const noexcept {
   return this->items;
 }
 
+/**
+ * @brief Take the Payloads object out of the packet that is not
+ * used anymore
+ *
+ * @return QVector<SyncingItem>
+ */
+QVector<SyncingItem> SyncingPacket::takeItems() && noexcept {
+  return std::move(this->items);
+}
+
+/**
+ * @brief Set the Generation object, it orders the copies so the
+ * receiver drops the sync that is older than the one it has, 0
+ * is the packet of a peer that doesn't order them
+ *
+ * @param generation
+ */
+void SyncingPacket::setGeneration(quint64 generation) {
+  this->generation = generation;
+}
+
+/**
+ * @brief Get the Generation object
+ *
+ * @return quint64
+ */
+quint64 SyncingPacket::getGeneration() const noexcept {
+  return this->generation;
+}
+
+/**
+ * @brief Set the Version object, it is the protocol version the
+ * packet is coded in that the peers agreed by the hello, it is
+ * not on the wire, the version 1 has no sync id, origin id, hop
+ * count, encodings and generation
+ *
+ * @param version
+ */
+void SyncingPacket::setVersion(quint16 version) {
+  this->version = version;
+}
+
+/**
+ * @brief Get the Version object
+ *
+ * @return quint16
+ */
+quint16 SyncingPacket::getVersion() const noexcept {
+  return this->version;
+}
+
 /**
  * @brief Get the size of the packet
  *
  * @return size_t
  */
 size_t SyncingPacket::size() const noexcept {
+  // the header of the version 1
   size_t size = sizeof(this->packetType) + sizeof(this->packetLength) + sizeof(this->itemCount);
 
+  // the header of the sync from the version 2
+  if (this->version >= 2) {
+    size += sizeof(this->syncId) + sizeof(this->originId) + sizeof(this->hopCount) +
+            sizeof(this->generation);
+  }
+
+  // the items, the version 1 has no encoding
   for (const auto& payload : this->items) {
-    size += payload.size();
+    size += payload.size() - (this->version >= 2 ? 0 : sizeof(quint8));
   }
 
   return size;
 }
 
 /**
- * @brief Overloaded operator<< for QDataStream
+ * @brief Write the item as the version 1 does, it has no encoding
+ * so only the inline items can be written
+ *
+ * @param out
+ * @param item
+ */
+static void writeInlineItem(QDataStream& out, const SyncingItem& item) {
+  // the version 1 has only the inline items
+  if (item.getEncoding() != SyncingItem::Encoding::Inline) {
+    throw std::invalid_argument("Invalid Encoding");
+  }
+
+  // write the mime type
+  out << item.getMimeLength();
+  out.writeRawData(item.getMimeType().data(), item.getMimeLength());
+
+  // write the payload
+  out << item.getPayloadLength();
+  out.writeRawData(item.getPayload().data(), item.getPayloadLength());
+}
+
+/**
+ * @brief Read the item as the version 1 does, it has no encoding
+ * so the item is inline
+ *
+ * @param in
+ * @return SyncingItem
+ */
+static SyncingItem readInlineItem(QDataStream& in) {
+  // lengths of the mime type and the payload
+  qint32 mimeLength = 0, payloadLength = 0;
+
+  // read the mime length
+  in >> mimeLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok || mimeLength < 0) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Mime Length"
+    );
+  }
+
+  // read the mime type
+  QByteArray mimeType(mimeLength, Qt::Uninitialized);
+  in.readRawData(mimeType.data(), mimeLength);
+
+  // read the payload length
+  in >> payloadLength;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok || payloadLength < 0) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Payload Length"
+    );
+  }
+
+  // read the payload, it is the only copy of it out of the frame
+  QByteArray payload(payloadLength, Qt::Uninitialized);
+  in.readRawData(payload.data(), payloadLength);
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Payload Attempt"
+    );
+  }
+
+  // create the item
+  SyncingItem item;
+  item.setMimeLength(mimeLength);
+  item.setMimeType(mimeType);
+  item.setEncoding(SyncingItem::Encoding::Inline);
+  item.setPayloadLength(payloadLength);
+  item.setPayload(payload);
+
+  // return the item
+  return item;
+}
+
+/**
+ * @brief Overloaded operator<< for QDataStream, the packet is
+ * written in its version
  *
  * @param out
  * @param packet
@@ -293,6 +551,16 @@ QDataStream& operator<<(QDataStream& out, const SyncingPacket& packet) {
   // write the packet length
   out << packet.packetLength;
 
+  // the version 1 has only the items
+  const auto isSync = packet.version >= 2;
+
+  // write the sync id, the origin id and the hop count
+  if (isSync) {
+    out << packet.syncId;
+    out << packet.originId;
+    out << packet.hopCount;
+  }
+
   // write the item count
   out << packet.itemCount;
 
@@ -303,7 +571,16 @@ QDataStream& operator<<(QDataStream& out, const SyncingPacket& packet) {
 
   // write the payloads
   for (const auto& payload : packet.items) {
-    out << payload;
+    if (isSync) {
+      out << payload;
+    } else {
+      writeInlineItem(out, payload);
+    }
+  }
+
+  // write the generation after the payloads
+  if (isSync) {
+    out << packet.generation;
   }
 
   // return the stream
@@ -311,7 +588,8 @@ QDataStream& operator<<(QDataStream& out, const SyncingPacket& packet) {
 }
 
 /**
- * @brief Overloaded operator>> for QDataStream
+ * @brief Overloaded operator>> for QDataStream, the packet is
+ * read in the version it is set to
  *
  * @param in
  * @param packet
@@ -344,6 +622,37 @@ QDataStream& operator>>(QDataStream& in, SyncingPacket& packet) {
     );
   }
 
+  // the version 1 has only the items
+  const auto isSync = packet.version >= 2;
+
+  // read the sync id
+  if (isSync) in >> packet.syncId;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Sync Id");
+  }
+
+  // read the origin id
+  if (isSync) in >> packet.originId;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Origin Id"
+    );
+  }
+
+  // read the hop count
+  if (isSync) in >> packet.hopCount;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Hop Count"
+    );
+  }
+
   // read the item count
   in >> packet.itemCount;
 
@@ -356,11 +665,16 @@ QDataStream& operator>>(QDataStream& in, SyncingPacket& packet) {
 
   // read the payloads
   for (int i = 0; i < packet.itemCount; i++) {
+    if (!isSync) {
+      packet.items.push_back(readInlineItem(in));
+      continue;
+    }
+
     SyncingItem payload;
 
     in >> payload;
 
-    packet.items.push_back(payload);
+    packet.items.push_back(std::move(payload));
   }
 
   // check if stream is valid
@@ -368,6 +682,19 @@ QDataStream& operator>>(QDataStream& in, SyncingPacket& packet) {
     throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Payloads");
   }
 
+  // the version 1 ends at the payloads
+  if (!isSync) return in;
+
+  // read the generation
+  in >> packet.generation;
+
+  // check if stream is valid
+  if (in.status() != QDataStream::Ok) {
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Generation"
+    );
+  }
+
   // return the stream
   return in;
 }
@@ -8,6 +8,7 @@
 // Standard header files
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 // Qt header files
 #include <QByteArray>
@@ -16,6 +17,7 @@
 #include <QtTypes>
 
 // Local header files
+#include "constants/constants.hpp"
 #include "types/enums/enums.hpp"
 #include "types/except/except.hpp"
 
@@ -28,9 +30,18 @@ class SyncingItem {
 
   qint32 mimeLength;
   QByteArray mimeType;
+  quint8 encoding = 0x00;
   qint32 payloadLength;
   QByteArray payload;
 
+ public:
+
+  /// @brief Encodings of the payload, a reference carries only the
+  /// SHA-256 of the payload that the receiver may already have and
+  /// a delta carries the SHA-256 of the base and the payload and the
+  /// delta that turns the base into the payload
+  enum Encoding : quint8 { Inline = 0x00, Reference = 0x01, Delta = 0x02 };
+
  public:
 
   /**
@@ -53,11 +64,25 @@ class SyncingItem {
   void setMimeType(const QByteArray& type);
 
   /**
-   * @brief Get the Mime Type object
+   * @brief Get the Mime Type object, it is borrowed from the item
    *
-   * @return QByteArray
+   * @return const QByteArray&
+   */
+  const QByteArray& getMimeType() const noexcept;
+
+  /**
+   * @brief Set the Encoding object
+   *
+   * @param encoding
+   */
+  void setEncoding(quint8 encoding);
+
+  /**
+   * @brief Get the Encoding object
+   *
+   * @return quint8
    */
-  QByteArray getMimeType() const noexcept;
+  quint8 getEncoding() const noexcept;
 
   /**
    * @brief Set the Payload Length object
@@ -81,11 +106,19 @@ class SyncingItem {
   void setPayload(const QByteArray& payload);
 
   /**
-   * @brief Get the Payload object
+   * @brief Get the Payload object, it is borrowed from the item
+   *
+   * @return const QByteArray&
+   */
+  const QByteArray& getPayload() const noexcept;
+
+  /**
+   * @brief Take the Payload object out of the item that is not
+   * used anymore
    *
    * @return QByteArray
    */
-  QByteArray getPayload() const noexcept;
+  QByteArray takePayload() && noexcept;
 
   /**
    * @brief Get the size of the packet
@@ -119,8 +152,16 @@ class SyncingPacket {
 
   quint8 packetType = 0x03;
   qint32 packetLength;
+  quint64 syncId    = 0;
+  quint64 originId  = 0;
+  quint8 hopCount   = 0;
   qint32 itemCount;
   QVector<SyncingItem> items;
+  quint64 generation = 0;
+
+ private:  // not on the wire
+
+  quint16 version    = constants::getProtocolVersion();
 
  public:
 
@@ -157,6 +198,51 @@ class SyncingPacket {
    */
   qint32 getPacketLength() const noexcept;
 
+  /**
+   * @brief Set the Sync Id object, it is the same for the packet
+   * and its forwards so the traces of the peers can be correlated
+   *
+   * @param id
+   */
+  void setSyncId(quint64 id);
+
+  /**
+   * @brief Get the Sync Id object
+   *
+   * @return quint64
+   */
+  quint64 getSyncId() const noexcept;
+
+  /**
+   * @brief Set the Origin Id object, it is the id of the node the
+   * sync started at so a relay drops the sync that came back to it
+   *
+   * @param id
+   */
+  void setOriginId(quint64 id);
+
+  /**
+   * @brief Get the Origin Id object
+   *
+   * @return quint64
+   */
+  quint64 getOriginId() const noexcept;
+
+  /**
+   * @brief Set the Hop Count object, it is the number of relays
+   * the sync has been forwarded through
+   *
+   * @param count
+   */
+  void setHopCount(quint8 count);
+
+  /**
+   * @brief Get the Hop Count object
+   *
+   * @return quint8
+   */
+  quint8 getHopCount() const noexcept;
+
   /**
    * @brief Set the Item Count object
    *
@@ -179,11 +265,59 @@ class SyncingPacket {
   void setItems(const QVector<SyncingItem>& payloads);
 
   /**
-   * @brief Get the Payloads object
+   * @brief Set the Payloads object by moving them in
+   *
+   * @param payloads
+   */
+  void setItems(QVector<SyncingItem>&& payloads);
+
+  /**
+   * @brief Get the Payloads object, they are borrowed from the packet
+   *
+   * @return const QVector<SyncingItem>&
+   */
+  const QVector<SyncingItem>& getItems() const noexcept;
+
+  /**
+   * @brief Take the Payloads object out of the packet that is not
+   * used anymore
    *
-   * @return QVector<Payload>
+   * @return QVector<SyncingItem>
    */
-  QVector<SyncingItem> getItems() const noexcept;
+  QVector<SyncingItem> takeItems() && noexcept;
+
+  /**
+   * @brief Set the Generation object, it orders the copies so the
+   * receiver drops the sync that is older than the one it has, 0
+   * is the packet of a peer that doesn't order them
+   *
+   * @param generation
+   */
+  void setGeneration(quint64 generation);
+
+  /**
+   * @brief Get the Generation object
+   *
+   * @return quint64
+   */
+  quint64 getGeneration() const noexcept;
+
+  /**
+   * @brief Set the Version object, it is the protocol version the
+   * packet is coded in that the peers agreed by the hello, it is
+   * not on the wire, the version 1 has no sync id, origin id, hop
+   * count, encodings and generation
+   *
+   * @param version
+   */
+  void setVersion(quint16 version);
+
+  /**
+   * @brief Get the Version object
+   *
+   * @return quint16
+   */
+  quint16 getVersion() const noexcept;
 
   /**
    * @brief Get the size of the packet
@@ -193,7 +327,8 @@ class SyncingPacket {
   size_t size() const noexcept;
 
   /**
-   * @brief Overloaded operator<< for QDataStream
+   * @brief Overloaded operator<< for QDataStream, the packet is
+   * written in its version
    *
    * @param out
    * @param packet
@@ -201,7 +336,8 @@ class SyncingPacket {
   friend QDataStream& operator<<(QDataStream& out, const SyncingPacket& packet);
 
   /**
-   * @brief Overloaded operator>> for QDataStream
+   * @brief Overloaded operator>> for QDataStream, the packet is
+   * read in the version it is set to
    *
    * @param in
    * @param packet
@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "resolver.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::resolver {
+/**
+ * @brief Handle the lookup result from QHostInfo and
+ * update the cache and notify the listeners
+ *
+ * @param address address that was looked up
+ * @param info result of the lookup
+ */
+void Resolver::handleLookupResult(const QHostAddress& address, const QHostInfo& info) {
+  // key of the address
+  const auto key    = address.toString();
+
+  // failed lookups are cached too so broken reverse
+  // DNS is not queried again until the entry expires
+  const auto name   = info.error() == QHostInfo::NoError ? info.hostName() : key;
+
+  // expiry timestamp of the entry
+  const auto expiry = QDateTime::currentMSecsSinceEpoch() + m_ttl;
+
+  // update the cache
+  m_cache.insert(key, {name, expiry});
+
+  // remove from the pending
+  m_pending.remove(key);
+
+  // notify the listeners
+  emit OnHostNameResolved(address, name);
+}
+
+/**
+ * @brief Construct a new Resolver object
+ *
+ * @param parent Parent object
+ */
+Resolver::Resolver(QObject* parent) : QObject(parent) {}
+
+/**
+ * @brief Get the Resolver instance shared by the
+ * application, the instance is owned by the application
+ * object so it is destroyed along with it
+ *
+ * @return Resolver*
+ */
+Resolver* Resolver::instance() {
+  static auto* resolver = new Resolver(QCoreApplication::instance());
+  return resolver;
+}
+
+/**
+ * @brief Get the host name of the address, if the name is
+ * cached and fresh it is returned, otherwise the lookup is
+ * started and the address itself is returned, once the
+ * name arrives OnHostNameResolved is emitted
+ *
+ * @param address Host address
+ * @return QString host name or address
+ */
+QString Resolver::resolve(const QHostAddress& address) {
+  // key of the address
+  const auto key     = address.toString();
+
+  // current timestamp in milliseconds
+  const auto current = QDateTime::currentMSecsSinceEpoch();
+
+  // find the entry from cache
+  const auto entry   = m_cache.constFind(key);
+
+  // if the entry is fresh then return it
+  if (entry != m_cache.constEnd() && entry->second > current) {
+    return entry->first;
+  }
+
+  // if the lookup is not in flight then start it
+  if (!m_pending.contains(key)) {
+    // mark as pending
+    m_pending.insert(key);
+
+    // handle the result on the event loop
+    const auto slot = [this, address](const QHostInfo& info) {
+      this->handleLookupResult(address, info);
+    };
+
+    // start the lookup
+    QHostInfo::lookupHost(key, this, slot);
+  }
+
+  // return the stale name if any or the address
+  return entry != m_cache.constEnd() ? entry->first : key;
+}
+
+/**
+ * @brief Set the Time To Live of the cache entries
+ *
+ * @param ttl time to live in milliseconds
+ */
+void Resolver::setTimeToLive(qint64 ttl) {
+  m_ttl = ttl;
+}
+
+/**
+ * @brief Get the Time To Live of the cache entries
+ *
+ * @return qint64 time to live in milliseconds
+ */
+qint64 Resolver::getTimeToLive() const {
+  return m_ttl;
+}
+
+/**
+ * @brief Clear the cache
+ */
+void Resolver::clearCache() {
+  m_cache.clear();
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::resolver
@@ -0,0 +1,113 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QHash>
+#include <QHostAddress>
+#include <QHostInfo>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QString>
+
+namespace srilakshmikanthanp::clipbirdesk::network::resolver {
+/**
+ * @brief Asynchronous host name resolver with a TTL cache, the
+ * lookups are done with QHostInfo::lookupHost so the caller is
+ * never blocked, the result is delivered with OnHostNameResolved
+ */
+class Resolver : public QObject {
+ signals:  // signals for this class
+  /// @brief On Host Name Resolved
+  void OnHostNameResolved(QHostAddress address, QString hostName);
+
+ private:  // just for Qt
+
+  /// @brief Qt meta object
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(Resolver)
+
+ private:  // Member variables
+
+  /// @brief Cache of address -> (host name, expiry timestamp)
+  QHash<QString, QPair<QString, qint64>> m_cache;
+
+  /// @brief Addresses with a lookup in flight
+  QSet<QString> m_pending;
+
+  /// @brief Time to live of the cache entries in milliseconds
+  qint64 m_ttl = 5 * 60 * 1000;
+
+ private:  // private functions
+
+  /**
+   * @brief Handle the lookup result from QHostInfo and
+   * update the cache and notify the listeners
+   *
+   * @param address address that was looked up
+   * @param info result of the lookup
+   */
+  void handleLookupResult(const QHostAddress& address, const QHostInfo& info);
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Resolver object
+   *
+   * @param parent Parent object
+   */
+  explicit Resolver(QObject* parent = nullptr);
+
+  /**
+   * @brief Destroy the Resolver object
+   */
+  ~Resolver() override = default;
+
+  /**
+   * @brief Get the Resolver instance shared by the
+   * application
+   *
+   * @return Resolver*
+   */
+  static Resolver* instance();
+
+  /**
+   * @brief Get the host name of the address, if the name is
+   * cached and fresh it is returned, otherwise the lookup is
+   * started and the address itself is returned, once the
+   * name arrives OnHostNameResolved is emitted
+   *
+   * @param address Host address
+   * @return QString host name or address
+   */
+  QString resolve(const QHostAddress& address);
+
+  /**
+   * @brief Set the Time To Live of the cache entries
+   *
+   * @param ttl time to live in milliseconds
+   */
+  void setTimeToLive(qint64 ttl);
+
+  /**
+   * @brief Get the Time To Live of the cache entries
+   *
+   * @return qint64 time to live in milliseconds
+   */
+  qint64 getTimeToLive() const;
+
+  /**
+   * @brief Clear the cache
+   */
+  void clearCache();
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::resolver
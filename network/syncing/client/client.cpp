@@ -14,16 +14,126 @@ namespace srilakshmikanthanp::clipbirdesk::network::syncing {
  * @param packet Syncing packet
  */
 void Client::processSyncingPacket(const packets::SyncingPacket& packet) {
-  // Make the vector of QPair<QString, QByteArray>
-  QVector<QPair<QString, QByteArray>> items;
+  // correlate the spans with the sender
+  tracing::SyncScope scope(packet.getSyncId());
 
-  // Get the items from the packet
-  for (auto item : packet.getItems()) {
-    items.append({item.getMimeType().toStdString().c_str(), item.getPayload()});
+  // the sync came back to the node it started at
+  if (packet.getOriginId() == m_nodeId) return;
+
+  // the sync is older than the copy this node has
+  if (m_generation.isStale(packet.getGeneration(), packet.getOriginId())) {
+    metrics::Registry::instance().counter("clipbird_syncs_stale_total").inc();
+    return;
+  }
+
+  // using the functions from namespace
+  using utility::functions::createPacket;
+  using utility::functions::getMissingBlobs;
+  using utility::functions::resolveItems;
+
+  // payloads that are referenced but not here
+  const auto missing = getMissingBlobs(packet, *m_blobs);
+
+  // if all the payloads are here then process them
+  if (missing.isEmpty()) {
+    return this->processSyncingItems(resolveItems(packet, *m_blobs), packet);
+  }
+
+  // drop the oldest if too many are waiting
+  if (m_waiting.size() >= m_maxWaiting) m_waiting.removeFirst();
+
+  // wait for the payloads
+  m_waiting.append(packet);
+
+  // ask the server for the payloads
+  const auto packType = packets::BlobPacket::PacketType::WantBlobs;
+  this->sendPacket(createPacket({packType, packet.getSyncId(), missing}));
+}
+
+/**
+ * @brief Process the items of the syncing packet that has all
+ * of its payloads and emit the signals
+ *
+ * @param items mime type and payload
+ * @param packet packet the items came in
+ */
+void Client::processSyncingItems(
+    const QVector<QPair<QString, QByteArray>>& items, const packets::SyncingPacket& packet
+) {
+  // the server has the text now
+  utility::functions::updateBases(m_bases, items, *m_blobs);
+
+  // drop the sync that a newer copy replaced meanwhile
+  if (!m_generation.advance(packet.getGeneration(), packet.getOriginId())) {
+    metrics::Registry::instance().counter("clipbird_syncs_stale_total").inc();
+    return;
   }
 
   // emit the signal
-  emit OnSyncRequest(items);
+  emit OnSyncRequest(items, m_ssl_socket->peerAddress().toString());
+
+  // header of the sync
+  const auto syncId     = packet.getSyncId();
+  const auto originId   = packet.getOriginId();
+  const auto hopCount   = packet.getHopCount();
+  const auto generation = packet.getGeneration();
+
+  // emit the signal for the relays
+  emit OnSyncRelay(items, syncId, originId, hopCount, generation);
+}
+
+/**
+ * @brief Process the BlobPacket from the server, the wanted
+ * payloads are sent and the sent payloads resume the waiting
+ * syncing packet
+ *
+ * @param packet BlobPacket
+ */
+void Client::processBlobPacket(const packets::BlobPacket& packet) {
+  // correlate the spans with the sender
+  tracing::SyncScope scope(packet.getSyncId());
+
+  // using the functions from namespace
+  using utility::functions::createPacket;
+  using utility::functions::getBlobs;
+  using utility::functions::getMissingBlobs;
+  using utility::functions::resolveItems;
+
+  // send the payloads the server wants
+  if (packet.getPacketType() == packets::BlobPacket::PacketType::WantBlobs) {
+    const auto packType = packets::BlobPacket::PacketType::SendBlobs;
+    const auto blobs    = getBlobs(packet.getBlobs(), *m_blobs);
+    const auto packet_s = createPacket({packType, packet.getSyncId(), blobs});
+    return this->sendPacket(packet_s, packet.getSyncId());
+  }
+
+  // is the packet waiting for the payloads
+  const auto isWaiting = [&](const packets::SyncingPacket& waiting) {
+    return waiting.getSyncId() == packet.getSyncId();
+  };
+
+  // find the waiting packet
+  const auto it = std::find_if(m_waiting.begin(), m_waiting.end(), isWaiting);
+
+  // if not waiting then ignore
+  if (it == m_waiting.end()) return;
+
+  // take the waiting packet
+  const auto waiting = m_waiting.takeAt(std::distance(m_waiting.begin(), it));
+
+  // hold the payloads while the packet is processed
+  QVector<QByteArray> hashes;
+  for (const auto& blob : packet.getBlobs()) hashes.append(m_blobs->put(blob));
+
+  // process the items if all the payloads are here
+  if (getMissingBlobs(waiting, *m_blobs).isEmpty()) {
+    this->processSyncingItems(resolveItems(waiting, *m_blobs), waiting);
+  } else {
+    emit OnErrorOccurred("Payloads of the sync are not available");
+  }
+
+  // release the payloads
+  for (const auto& hash : hashes) m_blobs->release(hash);
 }
 
 /**
@@ -36,6 +146,70 @@ void Client::processInvalidPacket(const packets::InvalidRequest& packet) {
   emit OnErrorOccurred(packet.getErrorMessage());
 }
 
+/**
+ * @brief Process the HelloPacket from the server, the server is
+ * left if the versions don't overlap else the lower version and
+ * the common features are used with it
+ *
+ * @param packet HelloPacket
+ */
+void Client::processHelloPacket(const packets::HelloPacket& packet) {
+  // versions of this client
+  const auto version    = constants::getProtocolVersion();
+  const auto minVersion = constants::getMinProtocolVersion();
+
+  // if the versions don't overlap then disconnect
+  if (packet.getVersion() < minVersion || packet.getMinVersion() > version) {
+    emit OnErrorOccurred("Protocol Version of the server is not supported");
+    m_ssl_socket->disconnectFromHost();
+    return;
+  }
+
+  // use the lower version and the common features
+  m_version  = std::min(packet.getVersion(), version);
+  m_features = packet.getFeatures() & utility::functions::supportedFeatures;
+
+  // cut the large packets into chunks if agreed
+  m_scheduler->setChunking(m_features & packets::HelloPacket::Feature::Chunks);
+
+  // tell the server the items to send
+  this->sendFilter();
+
+  // send the sync held till the hello
+  if (const auto held = std::exchange(m_held, Held()); !held.items.isEmpty()) {
+    this->relayItems(held.items, held.syncId, held.originId, held.hopCount, held.generation);
+  }
+}
+
+/**
+ * @brief Send the filter to the server and the standby server
+ * if they agreed on the filters
+ */
+void Client::sendFilter() {
+  // the feature of the filters
+  const auto filters = packets::HelloPacket::Feature::Filters;
+
+  // send to the server
+  if (m_verified && (m_features & filters)) this->sendPacket(m_filter);
+
+  // send to the standby server
+  if (m_standbySocket != nullptr && m_standbyVerified && (m_standbyFeatures & filters)) {
+    m_standbySocket->write(utility::functions::toQByteArray(this->standbyFilter()));
+  }
+}
+
+/**
+ * @brief Get the filter of the standby server, it is the filter
+ * paused so the standby sends no syncs till it is promoted
+ *
+ * @return packets::FilterPacket
+ */
+packets::FilterPacket Client::standbyFilter() const {
+  auto filter = m_filter;
+  filter.setFlags(filter.getFlags() | packets::FilterPacket::Flag::Paused);
+  return filter;
+}
+
 /**
  * @brief Updates the server list by removing the
  * server that that has exceeded the threshold
@@ -45,24 +219,94 @@ void Client::updateServerList() {
   // current timestamp in milliseconds
   const auto current   = QDateTime::currentMSecsSinceEpoch();
 
+  // is the connected server removed
+  auto isTargetGone    = false;
+
   // candidate for removal
-  const auto candidate = [&](auto element) -> bool {
-    return (current - std::get<2>(element)) > m_threshold;
+  const auto candidate = [&](const Found& found) -> bool {
+    const auto isStale  = (current - found.seenAt) > m_threshold;
+    const auto isTarget = found.host == m_target.first && found.port == m_target.second;
+    isTargetGone        = isTargetGone || (isStale && isTarget);
+    return isStale;
   };
 
   // remove the server that has exceeded the threshold
-  const auto start = m_servers.begin();
-  const auto end   = m_servers.end();
-  const auto it    = std::remove_if(start, end, candidate);
+  if (m_servers.removeIf(candidate) > 0) {
+    emit OnServerListChanged(getServerList());
+  }
 
-  // if No change return
-  if (it == end) return;
+  // nothing to fail over
+  if (!m_failover || m_leaving) return this->updateStandby();
 
-  // Remove the server from the list
-  m_servers.erase(it, end);
+  // the connected server stopped answering the discovery so
+  // leave it, the disconnection fails over to the next one
+  if (isTargetGone && m_verified) {
+    m_ssl_socket->abort();
+  }
 
-  // emit the signal if changed
-  emit OnServerListChanged(getServerList());
+  // the last connect failed so try the next best one
+  if (m_ssl_socket->state() == QAbstractSocket::UnconnectedState) {
+    if (!m_target.first.isNull()) m_lost = m_target;
+    this->failover();
+  }
+
+  // keep the standby
+  this->updateStandby();
+}
+
+/**
+ * @brief Process the packet from the server by its type, the
+ * chunks are joined and the whole packet is processed
+ *
+ * @param data packet
+ */
+void Client::processPacket(const QByteArray& data) {
+  // using fromQByteArray to parse the packet
+  using utility::functions::fromQByteArray;
+
+  // packet types
+  using SyncingType = packets::SyncingPacket::PacketType;
+  using InvalidType = packets::InvalidRequest::PacketType;
+  using BlobType    = packets::BlobPacket::PacketType;
+  using HelloType   = packets::HelloPacket::PacketType;
+  using ChunkType   = packets::ChunkPacket::PacketType;
+
+  // time to decode the packets
+  static auto& decodeTime = metrics::Registry::instance().histogram("clipbird_decode_ns");
+
+  // decode the syncing packet in the version agreed with the server,
+  // the version 1 has no sync id so the sync gets one here
+  const auto decode = [version = m_version](const QByteArray& data) {
+    CLIPBIRD_TRACE_SPAN("decode");
+    auto packet = fromQByteArray<packets::SyncingPacket>(data, version);
+    if (packet.getSyncId() == 0) packet.setSyncId(QRandomGenerator::global()->generate64());
+    return packet;
+  };
+
+  // process the packet by the type
+  switch (static_cast<quint8>(data.at(0))) {
+  case SyncingType::SyncPacket:
+    processSyncingPacket(metrics::measure(decodeTime, [&] { return decode(data); }));
+    break;
+  case InvalidType::RequestFailed:
+    processInvalidPacket(fromQByteArray<packets::InvalidRequest>(data));
+    break;
+  case BlobType::WantBlobs:
+  case BlobType::SendBlobs:
+    processBlobPacket(fromQByteArray<packets::BlobPacket>(data));
+    break;
+  case HelloType::Hello:
+    processHelloPacket(fromQByteArray<packets::HelloPacket>(data));
+    break;
+  case ChunkType::Chunk: {
+    const auto whole = m_scheduler->reassemble(fromQByteArray<packets::ChunkPacket>(data));
+    if (!whole.isEmpty()) processPacket(whole);
+    break;
+  }
+  default:
+    OnErrorOccurred("Unknown Packet Found");
+    break;
+  }
 }
 
 /**
@@ -70,44 +314,465 @@ void Client::updateServerList() {
  * from the server
  */
 void Client::processReadyRead() {
-  // Read All the data from the socket
-  const auto data = m_ssl_socket->readAll();
+  // keep the data until the server is verified
+  if (!m_verified) return;
 
-  // using fromQByteArray to parse the packet
-  using utility::functions::fromQByteArray;
+  // using readPacket to read the packets
+  using utility::functions::readPacket;
 
-  // try to parse the packet
+  // address of the server for the log
+  const auto peer = m_ssl_socket->peerAddress().toString();
+
+  // try to parse the packets that have fully arrived
   try {
-    processSyncingPacket(fromQByteArray<packets::SyncingPacket>(data));
-    return;
+    for (auto data = readPacket(m_ssl_socket); !data.isEmpty(); data = readPacket(m_ssl_socket)) {
+      // record the traffic
+      m_trafficIn.record(data.size());
+
+      // log the packet, only formatted if the category is enabled
+      qCDebug(logging::lcNetwork).noquote() << logging::withFields("packet received", {
+        {"peer", peer},
+        {"type", static_cast<quint8>(data.at(0))},
+        {"bytes", data.size()},
+      });
+
+      // process the packet by the type
+      this->processPacket(data);
+    }
   } catch (const types::except::MalformedPacket& e) {
     OnErrorOccurred(e.what());
-    return;
   } catch (const std::exception& e) {
     OnErrorOccurred(e.what());
-    return;
   } catch (...) {
     OnErrorOccurred("Unknown Error");
+  }
+}
+
+/**
+ * @brief Get the certificate fingerprint of the server
+ *
+ * @return QByteArray SHA-256 fingerprint or empty
+ */
+QByteArray Client::getFingerprint() const {
+  // get the certificate of the server
+  const auto certificate = m_ssl_socket->peerCertificate();
+
+  // if the server has no certificate then return empty
+  if (certificate.isNull()) return QByteArray();
+
+  // return the fingerprint
+  return certificate.digest(QCryptographicHash::Sha256);
+}
+
+/**
+ * @brief Verify the server once the TLS handshake is done, the
+ * pinned servers are trusted immediately others are verified
+ * by the authenticator
+ */
+void Client::processEncrypted() {
+  // labels of the handshake time
+  const auto labels = metrics::Labels{{"role", "client"}};
+
+  // handshake time of the connection
+  const auto time   = QDeadlineTimer::current().deadlineNSecs() - m_handshakeStart;
+
+  // record the handshake time
+  metrics::Registry::instance().histogram("clipbird_tls_handshake_ns", labels).record(time);
+
+  // log the handshake, only formatted if the category is enabled
+  qCDebug(logging::lcNetwork).noquote() << logging::withFields("handshake done", {
+    {"peer", m_ssl_socket->peerAddress().toString()},
+    {"latency_us", time / 1000},
+  });
+
+  // get the fingerprint of the server
+  const auto fingerprint = this->getFingerprint();
+
+  // if the server is pinned then trust it
+  if (m_trustStore != nullptr && m_trustStore->isTrusted(fingerprint)) {
+    return this->processVerification(fingerprint, true);
+  }
+
+  // if the server can't be verified then disconnect
+  if (fingerprint.isEmpty() || m_authenticator == nullptr) {
+    emit OnErrorOccurred("Server is not trusted");
+    m_ssl_socket->disconnectFromHost();
     return;
   }
 
-  // try to parse the packet
-  try {
-    processInvalidPacket(fromQByteArray<packets::InvalidRequest>(data));
+  // Peer info
+  const auto peerAddress = m_ssl_socket->peerAddress();
+  const auto peerPort    = m_ssl_socket->peerPort();
+
+  // the result may arrive after this client is destroyed
+  const auto client      = QPointer<Client>(this);
+
+  // callback that receives the result
+  const auto result      = [client, fingerprint](bool accepted) {
+    if (client) client->processVerification(fingerprint, accepted);
+  };
+
+  // verify the server
+  m_authenticator({peerAddress, peerPort}, result);
+}
+
+/**
+ * @brief Process the result of the authenticator for the
+ * server with the fingerprint
+ *
+ * @param fingerprint fingerprint of the verified server
+ * @param accepted Result of the authenticator
+ */
+void Client::processVerification(const QByteArray& fingerprint, bool accepted) {
+  // the socket may be connected to other server meanwhile
+  if (!m_ssl_socket->isEncrypted() || this->getFingerprint() != fingerprint) {
     return;
-  } catch (const types::except::MalformedPacket& e) {
-    OnErrorOccurred(e.what());
+  }
+
+  // if rejected then disconnect
+  if (!accepted) {
+    m_ssl_socket->disconnectFromHost();
     return;
+  }
+
+  // pin the server so it is not asked again
+  if (m_trustStore != nullptr && !m_trustStore->isTrusted(fingerprint)) {
+    try {
+      m_trustStore->trust(fingerprint, m_ssl_socket->peerAddress().toString());
+    } catch (const std::exception& e) {
+      emit OnErrorOccurred(e.what());
+    }
+  }
+
+  // mark as verified
+  m_verified = true;
+
+  // the traffic counters of the server
+  this->setTraffic();
+
+  // using the createPacket from namespace
+  using utility::functions::createPacket;
+
+  // tell the server the versions and the features
+  const auto packType = packets::HelloPacket::PacketType::Hello;
+  const auto version  = constants::getProtocolVersion();
+  const auto minimum  = constants::getMinProtocolVersion();
+  const auto features = utility::functions::supportedFeatures;
+  this->sendPacket(createPacket({packType, version, minimum, features}));
+
+  // notify the listeners
+  emit OnServerStatusChanged(true);
+
+  // process the data that arrived while verifying
+  if (m_ssl_socket->bytesAvailable() > 0) this->processReadyRead();
+}
+
+/**
+ * @brief Process the disconnection from the server
+ */
+void Client::processDisconnection() {
+  m_verified = false;
+  m_version  = 0;
+  m_features = packets::HelloPacket::Feature::InlineItems;
+  m_held     = Held();
+  m_scheduler->reset();
+  m_waiting.clear();
+  utility::functions::releaseBases(m_bases, *m_blobs);
+  emit OnServerStatusChanged(false);
+
+  // fail over to the next best server
+  m_lost = m_target;
+  this->failover();
+}
+
+/**
+ * @brief Connect the signals of the socket to the server
+ *
+ * @param socket socket to the server
+ */
+void Client::attachSocket(QSslSocket* socket) {
+  // the writes to the server are scheduled
+  m_scheduler = new Scheduler(socket, socket);
+
+  // encrypted signal to verify the server before
+  // emitting the signal for server state changed
+  const auto signal_c = &QSslSocket::encrypted;
+  const auto slot_c   = &Client::processEncrypted;
+  connect(socket, signal_c, this, slot_c);
+
+  // connect the signals and slots for the socket
+  // readyRead signal to process the packet
+  const auto signal_r = &QSslSocket::readyRead;
+  const auto slot_r   = &Client::processReadyRead;
+  connect(socket, signal_r, this, slot_r);
+
+  // disconnected signal to emit the signal for
+  // server state changed
+  const auto signal_d = &QSslSocket::disconnected;
+  const auto slot_d   = &Client::processDisconnection;
+  connect(socket, signal_d, this, slot_d);
+}
+
+/**
+ * @brief Look up the traffic counters of the server the socket
+ * is connected to
+ */
+void Client::setTraffic() {
+  const auto peer = m_ssl_socket->peerAddress().toString();
+  m_trafficIn     = metrics::Traffic("in", peer);
+  m_trafficOut    = metrics::Traffic("out", peer);
+}
+
+/**
+ * @brief Sort the servers from the best, the full servers are
+ * the last and the others are ranked by the rtt with the load
+ * added as the cost of a full server times the load
+ */
+void Client::rankServers() {
+  // is the server full
+  const auto isFull = [](const Found& found) {
+    return found.capacity > 0 && found.clientCount >= found.capacity;
+  };
+
+  // cost of the server
+  const auto costOf = [this](const Found& found) {
+    const auto load = found.capacity > 0 ? double(found.clientCount) / found.capacity : 0.0;
+    return found.rtt + qint64(load * m_loadCost);
+  };
+
+  // is the server better than the other
+  const auto isBetter = [&](const Found& a, const Found& b) {
+    return std::pair(isFull(a), costOf(a)) < std::pair(isFull(b), costOf(b));
+  };
+
+  // sort keeping the order of the equals
+  std::stable_sort(m_servers.begin(), m_servers.end(), isBetter);
+}
+
+/**
+ * @brief Connect to the standby server if it is ready else to
+ * the best server that is not lost, nothing is done if failover
+ * is disabled, the user disconnected or it is connected
+ */
+void Client::failover() {
+  // nothing to do
+  if (!m_failover || m_leaving) return;
+
+  // already connected or connecting
+  if (m_ssl_socket->state() != QAbstractSocket::UnconnectedState) return;
+
+  // switch to the standby if ready
+  if (m_standbySocket != nullptr && m_standbyVerified) return this->promoteStandby();
+
+  // is the server the lost one
+  const auto isLost = [&](const Found& found) {
+    return found.host == m_lost.first && found.port == m_lost.second;
+  };
+
+  // the best server that is not lost if any else the lost one
+  auto it = std::find_if_not(m_servers.begin(), m_servers.end(), isLost);
+  if (it == m_servers.end()) it = m_servers.begin();
+
+  // no server is found yet
+  if (it == m_servers.end()) return;
+
+  // count the failover
+  metrics::Registry::instance().counter("clipbird_failovers_total").inc();
+
+  // connect to the server
+  try {
+    this->connectToServer({it->host, it->port});
   } catch (const std::exception& e) {
-    OnErrorOccurred(e.what());
-    return;
-  } catch (...) {
-    OnErrorOccurred("Unknown Error");
+    emit OnErrorOccurred(e.what());
+  }
+}
+
+/**
+ * @brief Connect the standby to the next best server if there
+ * is none, drop it if not needed
+ */
+void Client::updateStandby() {
+  // the standby is only needed while connected
+  if (!m_standby || !m_failover || m_leaving || !m_verified) return this->dropStandby();
+
+  // already has the standby
+  if (m_standbySocket != nullptr) return;
+
+  // can the server be the standby
+  const auto isCandidate = [&](const Found& found) {
+    const auto server = QPair<QHostAddress, quint16>(found.host, found.port);
+    return server != m_target && !m_notPinned.contains(server);
+  };
+
+  // the next best server
+  const auto it = std::find_if(m_servers.begin(), m_servers.end(), isCandidate);
+
+  // no other server
+  if (it == m_servers.end()) return;
+
+  // create the standby connection
+  m_standbySocket = new QSslSocket(this);
+  m_standbyTarget = {it->host, it->port};
+
+  // same identity as the connection
+  m_standbySocket->setSslConfiguration(m_ssl_socket->sslConfiguration());
+
+  // verify the standby server by the trust store
+  const auto signal_c = &QSslSocket::encrypted;
+  const auto slot_c   = &Client::processStandbyEncrypted;
+  connect(m_standbySocket, signal_c, this, slot_c);
+
+  // drop the syncs that arrive on the standby
+  const auto signal_r = &QSslSocket::readyRead;
+  const auto slot_r   = &Client::processStandbyReadyRead;
+  connect(m_standbySocket, signal_r, this, slot_r);
+
+  // drop the standby if the link drops
+  const auto signal_d = &QSslSocket::disconnected;
+  const auto slot_d   = &Client::dropStandby;
+  connect(m_standbySocket, signal_d, this, slot_d);
+
+  // connect to the server as encrypted
+  m_standbySocket->connectToHostEncrypted(it->host.toString(), it->port);
+}
+
+/**
+ * @brief Drop the standby connection
+ */
+void Client::dropStandby() {
+  // no standby
+  if (m_standbySocket == nullptr) return;
+
+  // take the socket
+  const auto socket = std::exchange(m_standbySocket, nullptr);
+
+  // forget the socket
+  m_standbyVerified = false;
+  m_standbyVersion  = 0;
+  m_standbyFeatures = packets::HelloPacket::Feature::InlineItems;
+  disconnect(socket, nullptr, this, nullptr);
+
+  // release the socket
+  socket->abort();
+  socket->deleteLater();
+}
+
+/**
+ * @brief Use the standby connection as the connection to the
+ * server, the server has already verified it
+ */
+void Client::promoteStandby() {
+  // release the lost connection
+  const auto lost = std::exchange(m_ssl_socket, std::exchange(m_standbySocket, nullptr));
+  disconnect(lost, nullptr, this, nullptr);
+  lost->deleteLater();
+
+  // the standby is the connection now
+  disconnect(m_ssl_socket, nullptr, this, nullptr);
+  this->attachSocket(m_ssl_socket);
+  m_target          = m_standbyTarget;
+  m_version         = std::exchange(m_standbyVersion, 0);
+  m_features        = std::exchange(m_standbyFeatures, packets::HelloPacket::Feature::InlineItems);
+  m_standbyVerified = false;
+  m_verified        = true;
+
+  // the traffic counters of the server
+  this->setTraffic();
+
+  // cut the large packets into chunks if agreed
+  m_scheduler->setChunking(m_features & packets::HelloPacket::Feature::Chunks);
+
+  // the standby was paused, tell it the items to send
+  this->sendFilter();
+
+  // count the failover
+  metrics::Registry::instance().counter("clipbird_failovers_total").inc();
+
+  // notify the listeners
+  emit OnServerStatusChanged(true);
+
+  // process the data that arrived meanwhile
+  if (m_ssl_socket->bytesAvailable() > 0) this->processReadyRead();
+}
+
+/**
+ * @brief Keep the standby connection only if the server is
+ * pinned, nobody is asked about a standby
+ */
+void Client::processStandbyEncrypted() {
+  // certificate of the standby server
+  const auto certificate = m_standbySocket->peerCertificate();
+
+  // is the standby server pinned
+  const auto isPinned    = m_trustStore != nullptr && !certificate.isNull() &&
+                        m_trustStore->isTrusted(certificate.digest(QCryptographicHash::Sha256));
+
+  // using the createPacket from namespace
+  using utility::functions::createPacket;
+  using utility::functions::toQByteArray;
+
+  // keep the pinned server and tell it the versions and the features
+  if (isPinned) {
+    const auto packType = packets::HelloPacket::PacketType::Hello;
+    const auto version  = constants::getProtocolVersion();
+    const auto minimum  = constants::getMinProtocolVersion();
+    const auto features = utility::functions::supportedFeatures;
+    m_standbySocket->write(toQByteArray(createPacket({packType, version, minimum, features})));
+    m_standbyVerified = true;
     return;
   }
 
-  // if no packet is found
-  OnErrorOccurred("Unknown Packet Found");
+  // don't try the server again
+  m_notPinned.append(m_standbyTarget);
+  this->dropStandby();
+}
+
+/**
+ * @brief Drop the packets that arrive on the standby connection
+ * keeping the stream at the start of a packet, only the hello
+ * is kept for the time the standby is promoted
+ */
+void Client::processStandbyReadyRead() {
+  // only the whole packets are read
+  using utility::functions::fromQByteArray;
+  using utility::functions::readPacket;
+  using utility::functions::toQByteArray;
+
+  // versions of this client
+  const auto version    = constants::getProtocolVersion();
+  const auto minVersion = constants::getMinProtocolVersion();
+
+  // socket of the standby
+  const auto socket     = m_standbySocket;
+
+  // drop the packets but the hello
+  for (auto data = readPacket(socket); !data.isEmpty(); data = readPacket(socket)) {
+    // not the hello
+    if (static_cast<quint8>(data.at(0)) != packets::HelloPacket::PacketType::Hello) continue;
+
+    // the hello of the standby server
+    packets::HelloPacket packet;
+    try {
+      packet = fromQByteArray<packets::HelloPacket>(data);
+    } catch (const std::exception&) {
+      return this->dropStandby();
+    }
+
+    // if the versions don't overlap then it can't be the standby
+    if (packet.getVersion() < minVersion || packet.getMinVersion() > version) {
+      m_notPinned.append(m_standbyTarget);
+      return this->dropStandby();
+    }
+
+    // use the lower version and the common features
+    m_standbyVersion  = std::min(packet.getVersion(), version);
+    m_standbyFeatures = packet.getFeatures() & utility::functions::supportedFeatures;
+
+    // tell the standby server to send no syncs for now
+    if (m_standbyFeatures & packets::HelloPacket::Feature::Filters) {
+      socket->write(toQByteArray(this->standbyFilter()));
+    }
+  }
 }
 
 /**
@@ -125,17 +790,11 @@ Client::Client(QObject* parent) : discovery::Client(parent) {
   const auto slot_e   = &Client::OnErrorOccurred;
   connect(this, signal_e, this, slot_e);
 
-  // connected signal to emit the signal for
-  // server state changed
-  const auto signal_c = &QSslSocket::connected;
-  const auto slot_c   = [&]() { emit OnServerStatusChanged(true); };
-  connect(m_ssl_socket, signal_c, this, slot_c);
+  // connect the signals of the socket
+  this->attachSocket(m_ssl_socket);
 
-  // connect the signals and slots for the socket
-  // readyRead signal to process the packet
-  const auto signal_r = &QSslSocket::readyRead;
-  const auto slot_r   = &Client::processReadyRead;
-  connect(m_ssl_socket, signal_r, this, slot_r);
+  // the default filter accepts all the items
+  m_filter.setPacketLength(m_filter.size());
 
   // connect the signal to emit the signal for
   // timer to update the server list
@@ -144,13 +803,7 @@ Client::Client(QObject* parent) : discovery::Client(parent) {
   connect(m_timer, signal_t, this, slot_t);
 
   // start the timer to update the server list
-  m_timer->start(m_threshold);
-
-  // disconnected signal to emit the signal for
-  // server state changed
-  const auto signal_d = &QSslSocket::disconnected;
-  const auto slot_d   = [&]() { emit OnServerStatusChanged(false); };
-  connect(m_ssl_socket, signal_d, this, slot_d);
+  m_timer->start(m_interval);
 }
 
 /**
@@ -160,20 +813,118 @@ Client::Client(QObject* parent) : discovery::Client(parent) {
  * @param items QVector<QPair<QString, QByteArray>>
  */
 void Client::syncItems(QVector<QPair<QString, QByteArray>> items) {
+  // correlate with the capture if any else a new id
+  auto syncId = tracing::currentSyncId();
+  if (syncId == 0) syncId = QRandomGenerator::global()->generate64();
+
+  // the sync starts at this node with a new generation
+  this->relayItems(items, syncId, m_nodeId, 0, m_generation.next(m_nodeId));
+}
+
+/**
+ * @brief Send the items of a sync that started at other node
+ * to the server, it is used by the relays to keep the header,
+ * the latest sync is held till the server says hello
+ *
+ * @param items mime type and payload
+ * @param syncId id of the sync
+ * @param originId id of the node the sync started at
+ * @param hopCount number of relays the sync went through
+ * @param generation generation of the copy
+ */
+void Client::relayItems(
+    QVector<QPair<QString, QByteArray>> items,
+    quint64 syncId,
+    quint64 originId,
+    quint8 hopCount,
+    quint64 generation
+) {
   // check if the socket is connected else throw error
   if (!m_ssl_socket->isOpen()) {
     throw std::runtime_error("Socket is not connected");
   }
 
-  // using createPacket to create the packet
-  using utility::functions::createPacket;
+  // hold the latest sync till the server says the version it reads
+  if (m_version == 0) {
+    m_held = {items, syncId, originId, hopCount, generation};
+    return;
+  }
+
+  // using the createSyncingPacket from namespace
+  using utility::functions::createSyncingPacket;
 
-  // create the packet
-  packets::SyncingPacket packet =
-      createPacket({packets::SyncingPacket::PacketType::SyncPacket, items});
+  // create the packet, the server is offered the large payloads
+  // by the hash and the large text as a delta if it is smaller
+  // as far as the version and the features agreed allow
+  auto packet = createSyncingPacket(items, syncId, *m_blobs, m_bases, m_features, m_version);
+
+  // keep the origin, the hops and the generation of the sync
+  packet.setOriginId(originId);
+  packet.setHopCount(hopCount);
+  packet.setGeneration(generation);
+
+  // the copy is the newest this node has seen if not stale
+  const auto isNewest = m_generation.advance(generation, originId);
+
+  // the server has the text now
+  utility::functions::updateBases(m_bases, items, *m_blobs);
+
+  // correlate the spans of the send
+  tracing::SyncScope scope(packet.getSyncId());
+
+  // the older transfers to the server are stale now, the stale
+  // sync must not cancel the transfer of a newer one
+  if (isNewest) m_scheduler->supersede(syncId);
 
   // send the packet to the server
-  this->sendPacket(packet);
+  this->sendPacket(packet, syncId);
+}
+
+/**
+ * @brief Is the client connected to the server and verified
+ *
+ * @return bool
+ */
+bool Client::isConnected() const {
+  return m_verified && m_ssl_socket->state() == QAbstractSocket::ConnectedState;
+}
+
+/**
+ * @brief Get the protocol version agreed with the server, 0 till
+ * the server says hello
+ *
+ * @return quint16
+ */
+quint16 Client::getVersion() const {
+  return m_version;
+}
+
+/**
+ * @brief Get the features agreed with the server
+ *
+ * @return quint32 bits of the HelloPacket::Feature
+ */
+quint32 Client::getFeatures() const {
+  return m_features;
+}
+
+/**
+ * @brief Set the Node Id object, the syncs with the id as the
+ * origin are dropped since they came back to this node
+ *
+ * @param id
+ */
+void Client::setNodeId(quint64 id) {
+  m_nodeId = id;
+}
+
+/**
+ * @brief Get the Node Id object
+ *
+ * @return quint64
+ */
+quint64 Client::getNodeId() const {
+  return m_nodeId;
 }
 
 /**
@@ -186,8 +937,8 @@ QList<QPair<QHostAddress, quint16>> Client::getServerList() const {
   QList<QPair<QHostAddress, quint16>> list;
 
   // iterate and add the server
-  for (auto& [host, port, _] : m_servers) {
-    list.append({host, port});
+  for (const auto& found : m_servers) {
+    list.append({found.host, found.port});
   }
 
   // return the list
@@ -212,10 +963,17 @@ void Client::connectToServer(QPair<QHostAddress, quint16> client) {
     this->disconnectFromServer();
   }
 
+  // the user wants to be connected
+  m_leaving = false;
+  m_target  = client;
+
   // create the host address
   const auto host = client.first.toString();
   const auto port = client.second;
 
+  // start of the handshake
+  m_handshakeStart = QDeadlineTimer::current().deadlineNSecs();
+
   // connect to the server as encrypted
   m_ssl_socket->connectToHostEncrypted(host, port);
 }
@@ -232,15 +990,89 @@ QPair<QHostAddress, quint16> Client::getConnectedServer() const {
  * @brief Disconnect from the server
  */
 void Client::disconnectFromServer() {
+  m_leaving = true;
+  this->dropStandby();
   m_ssl_socket->disconnectFromHost();
 }
 
+/**
+ * @brief Set the Failover, if enabled the client connects to
+ * the best server when it is not connected, the connected server
+ * that stops answering the discovery for the threshold is left
+ * for the next best one
+ *
+ * @param enabled
+ */
+void Client::setFailover(bool enabled) {
+  m_failover = enabled;
+}
+
+/**
+ * @brief Is the Failover enabled
+ *
+ * @return bool
+ */
+bool Client::isFailover() const {
+  return m_failover;
+}
+
+/**
+ * @brief Set the Standby, if enabled a connection to the next
+ * best pinned server is held so the failover is only a switch
+ *
+ * @param enabled
+ */
+void Client::setStandby(bool enabled) {
+  m_standby = enabled;
+  this->updateStandby();
+}
+
+/**
+ * @brief Is the Standby enabled
+ *
+ * @return bool
+ */
+bool Client::isStandby() const {
+  return m_standby;
+}
+
+/**
+ * @brief Set the Filter, the server sends only the items the
+ * filter accepts e.g. only the text to a tethered laptop, it is
+ * sent again on every connect, the servers that don't support
+ * the filters send all the items
+ *
+ * @param filter FilterPacket
+ */
+void Client::setFilter(const packets::FilterPacket& filter) {
+  // keep the filter for the connects
+  m_filter = filter;
+  m_filter.setPacketLength(m_filter.size());
+
+  // send it to the servers
+  this->sendFilter();
+}
+
+/**
+ * @brief Get the Filter object
+ *
+ * @return packets::FilterPacket
+ */
+packets::FilterPacket Client::getFilter() const {
+  return m_filter;
+}
+
 /**
  * @brief Set the SSL Configuration object
  *
  * @param config SSL Configuration
  */
 void Client::setSSLConfiguration(QSslConfiguration config) {
+  // the certificates are self-signed so the server is
+  // verified by the pinned fingerprint instead of a CA
+  config.setPeerVerifyMode(QSslSocket::QueryPeer);
+
+  // set the configuration
   m_ssl_socket->setSslConfiguration(config);
 }
 
@@ -253,24 +1085,121 @@ QSslConfiguration Client::getSSLConfiguration() const {
   return m_ssl_socket->sslConfiguration();
 }
 
+/**
+ * @brief Set the Authenticator that verifies the servers
+ * that are not pinned in the trust store
+ *
+ * @param auth Authenticator
+ */
+void Client::setAuthenticator(Authenticator auth) {
+  m_authenticator = auth;
+}
+
+/**
+ * @brief Get the Authenticator object
+ *
+ * @return Authenticator
+ */
+Client::Authenticator Client::getAuthenticator() const {
+  return m_authenticator;
+}
+
+/**
+ * @brief Set the Trust Store, the servers pinned in the store
+ * are trusted and verified servers are pinned to it
+ *
+ * @param store Trust store
+ */
+void Client::setTrustStore(storage::TrustStore* store) {
+  m_trustStore = store;
+}
+
+/**
+ * @brief Get the Trust Store object
+ *
+ * @return storage::TrustStore*
+ */
+storage::TrustStore* Client::getTrustStore() const {
+  return m_trustStore;
+}
+
+/**
+ * @brief Set the Blob Store, the payloads in the store are not
+ * asked from the server and the large payloads are offered by
+ * the hash through it
+ *
+ * @param store Blob store
+ */
+void Client::setBlobStore(storage::BlobStore* store) {
+  m_blobs = store != nullptr ? store : &m_ownBlobs;
+}
+
+/**
+ * @brief Get the Blob Store object
+ *
+ * @return storage::BlobStore*
+ */
+storage::BlobStore* Client::getBlobStore() const {
+  return m_blobs;
+}
+
 /**
  * @brief On server found function that That Called by the
  * discovery client when the server is found
  *
- * @param host Host address
- * @param port Port number
+ * @param server Host address and port number
+ * @param rtt time from the broadcast to the response in nanoseconds
+ * @param packet response with the load and the version of the server
  */
-void Client::onServerFound(QPair<QHostAddress, quint16> server) {
+void Client::onServerFound(
+    QPair<QHostAddress, quint16> server, qint64 rtt, const packets::DiscoveryPacket& packet
+) {
+  // encodings this client sends
+  const auto codecs = utility::functions::supportedCodecs;
+
+  // skip the server that can't read the packets of this client
+  if (packet.getProtocolVersion() < constants::getMinProtocolVersion() ||
+      (packet.getCodecs() & codecs) != codecs) {
+    return;
+  }
+
   // current timestamp in milliseconds
   const auto current = QDateTime::currentMSecsSinceEpoch();
 
-  // emit the signal
-  emit OnServerFound(server);
+  // order of the servers before the update
+  const auto before  = getServerList();
+
+  // is the server already found
+  const auto isFound = [&](const Found& found) {
+    return found.host == server.first && found.port == server.second;
+  };
 
-  // add the server to the list
-  m_servers.append({server.first, server.second, current});
+  // find the server
+  const auto it = std::find_if(m_servers.begin(), m_servers.end(), isFound);
 
-  // emit the signal
-  emit OnServerListChanged(getServerList());
+  // update the server else add it
+  if (it != m_servers.end()) {
+    it->seenAt      = current;
+    it->rtt         = (it->rtt * 3 + rtt) / 4;
+    it->clientCount = packet.getClientCount();
+    it->capacity    = packet.getCapacity();
+  } else {
+    const auto count    = packet.getClientCount();
+    const auto capacity = packet.getCapacity();
+    m_servers.append({server.first, server.second, current, rtt, count, capacity});
+    emit OnServerFound(server);
+  }
+
+  // sort the servers from the best
+  this->rankServers();
+
+  // emit the signal if changed
+  if (getServerList() != before) emit OnServerListChanged(getServerList());
+
+  // connect if not connected
+  this->failover();
+
+  // keep the standby
+  this->updateStandby();
 }
 }  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
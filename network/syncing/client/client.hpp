@@ -7,9 +7,14 @@
 
 // Qt headers
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <QDateTime>
+#include <QDeadlineTimer>
+#include <QHash>
 #include <QList>
 #include <QObject>
+#include <QPointer>
+#include <QRandomGenerator>
 #include <QSslConfiguration>
 #include <QSslServer>
 #include <QSslSocket>
@@ -17,15 +22,25 @@
 #include <QVector>
 
 // standard headers
-#include <tuple>
+#include <algorithm>
 #include <utility>
 
 // Local headers
+#include "constants/constants.hpp"
 #include "network/discovery/client/client.hpp"
+#include "network/syncing/generation/generation.hpp"
+#include "network/syncing/scheduler/scheduler.hpp"
+#include "storage/blobstore/blobstore.hpp"
+#include "storage/truststore/truststore.hpp"
+#include "types/callback/callback.hpp"
 #include "types/enums/enums.hpp"
+#include "utility/functions/blobs/blobs.hpp"
 #include "utility/functions/ipconv/ipconv.hpp"
 #include "utility/functions/nbytes/nbytes.hpp"
 #include "utility/functions/packet/packet.hpp"
+#include "utility/logging/logging.hpp"
+#include "utility/metrics/metrics.hpp"
+#include "utility/tracing/tracing.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::network::syncing {
 /**
@@ -50,8 +65,18 @@ class Client : public discovery::Client {
   void OnServerStatusChanged(bool isConnected);
 
  signals:  // signals for this class
-  /// @brief On Sync Request
-  void OnSyncRequest(QVector<QPair<QString, QByteArray>> items);
+  /// @brief On Sync Request with the address of the peer it came from
+  void OnSyncRequest(QVector<QPair<QString, QByteArray>> items, QString origin);
+
+ signals:  // signals for this class
+  /// @brief On Sync Relay with the header a relay needs to forward it
+  void OnSyncRelay(
+      QVector<QPair<QString, QByteArray>> items,
+      quint64 syncId,
+      quint64 originId,
+      quint8 hopCount,
+      quint64 generation
+  );
 
  private:  // just for Qt
 
@@ -63,10 +88,29 @@ class Client : public discovery::Client {
   /// @brief Disable copy and move
   Q_DISABLE_COPY_MOVE(Client)
 
+ public:  // Authenticator Type
+
+  /// @brief Authenticator
+  using Authenticator = types::callback::Authenticator;
+
+ private:  // Types
+
+  /**
+   * @brief Server found by the discovery
+   */
+  struct Found {
+    QHostAddress host;
+    quint16 port;
+    qint64 seenAt;
+    qint64 rtt;
+    quint32 clientCount;
+    quint32 capacity;
+  };
+
  private:  // Member variables
 
-  /// @brief List of Found servers and timestamp
-  QList<std::tuple<QHostAddress, quint16, qint64>> m_servers;
+  /// @brief Found servers from the best
+  QList<Found> m_servers;
 
   /// @brief SSL socket
   QSslSocket* m_ssl_socket = new QSslSocket(this);
@@ -77,16 +121,149 @@ class Client : public discovery::Client {
   /// @brief Threshold times
   const qint64 m_threshold = 10000;
 
+  /// @brief Interval of the checks of the servers
+  const int m_interval     = 2500;
+
+  /// @brief Cost of a full server in nanoseconds of the rtt
+  const qint64 m_loadCost  = 10000000;
+
+  /// @brief Authenticator to verify the unknown servers
+  Authenticator m_authenticator     = nullptr;
+
+  /// @brief Store of the pinned peers
+  storage::TrustStore* m_trustStore = nullptr;
+
+  /// @brief Is the connected server verified
+  bool m_verified                   = false;
+
+  /// @brief Start of the TLS handshake in nanoseconds
+  qint64 m_handshakeStart           = 0;
+
+  /// @brief Id of this node in the syncs it starts
+  quint64 m_nodeId                  = QRandomGenerator::global()->generate64();
+
+  /// @brief Clock of the generations of the copies
+  Generation m_generation;
+
+ private:  // Blobs of the syncing
+
+  /// @brief Store used if none is set
+  storage::BlobStore m_ownBlobs;
+
+  /// @brief Store of the payloads
+  storage::BlobStore* m_blobs = &m_ownBlobs;
+
+  /// @brief Packets waiting for the payloads from the oldest
+  QList<packets::SyncingPacket> m_waiting;
+
+  /// @brief Hash of the last text the server has by the mime type
+  QHash<QString, QByteArray> m_bases;
+
+  /// @brief Maximum number of packets waiting for the payloads
+  const qsizetype m_maxWaiting = 16;
+
+ private:  // Failover of the servers
+
+  /// @brief Connect to the best server if the server is lost
+  bool m_failover                    = false;
+
+  /// @brief Hold a connection to the next best server
+  bool m_standby                     = false;
+
+  /// @brief Is disconnected by the user
+  bool m_leaving                     = false;
+
+  /// @brief Server that is connected or being connected
+  QPair<QHostAddress, quint16> m_target;
+
+  /// @brief Server that was lost last
+  QPair<QHostAddress, quint16> m_lost;
+
+  /// @brief Connection to the next best server
+  QSslSocket* m_standbySocket        = nullptr;
+
+  /// @brief Server of the standby connection
+  QPair<QHostAddress, quint16> m_standbyTarget;
+
+  /// @brief Is the standby connection verified
+  bool m_standbyVerified             = false;
+
+  /// @brief Servers that are not pinned so can't be the standby
+  QList<QPair<QHostAddress, quint16>> m_notPinned;
+
+ private:  // Negotiation with the server
+
+  /**
+   * @brief Sync that waits for the hello of the server
+   */
+  struct Held {
+    QVector<QPair<QString, QByteArray>> items;
+    quint64 syncId     = 0;
+    quint64 originId   = 0;
+    quint8 hopCount    = 0;
+    quint64 generation = 0;
+  };
+
+  /// @brief Version agreed with the server, 0 till it says hello
+  quint16 m_version         = 0;
+
+  /// @brief Features agreed with the server, only the inline items till it says hello
+  quint32 m_features        = packets::HelloPacket::Feature::InlineItems;
+
+  /// @brief Version agreed with the standby server, 0 till it says hello
+  quint16 m_standbyVersion  = 0;
+
+  /// @brief Features agreed with the standby server
+  quint32 m_standbyFeatures = packets::HelloPacket::Feature::InlineItems;
+
+  /// @brief Filter of the items the server sends, accepts all by default
+  packets::FilterPacket m_filter;
+
+  /// @brief Scheduler of the writes to the server
+  Scheduler* m_scheduler    = nullptr;
+
+  /// @brief Latest sync made before the server said hello
+  Held m_held;
+
+  /// @brief Traffic counters of the server, set once it is verified
+  metrics::Traffic m_trafficIn;
+  metrics::Traffic m_trafficOut;
+
  private:  // private functions
 
   /**
    * @brief Create the packet and send it to the client
    *
    * @param packet Packet to send
+   * @param syncId id of the sync the packet is part of if any
    */
   template <typename Packet>
-  void sendPacket(const Packet& pack) {
-    m_ssl_socket->write(utility::functions::toQByteArray(pack));
+  void sendPacket(const Packet& pack, quint64 syncId = 0) {
+    // time to encode the packets
+    static auto& encodeTime = metrics::Registry::instance().histogram("clipbird_encode_ns");
+
+    // encode the packet
+    const auto data = metrics::measure(encodeTime, [&] {
+      CLIPBIRD_TRACE_SPAN("encode");
+      return m_scheduler->getEncoder().encode(pack);
+    });
+
+    // write to the server
+    {
+      CLIPBIRD_TRACE_SPAN("write");
+      m_scheduler->send(data, syncId);
+    }
+
+    // record the traffic
+    m_trafficOut.record(data.size());
+
+    // log the packet, only formatted if the category is enabled
+    qCDebug(logging::lcNetwork).noquote() << logging::withFields("packet sent", {
+      {"peer", m_ssl_socket->peerAddress().toString()},
+      {"type", pack.getPacketType()},
+      {"bytes", data.size()},
+      {"backlog", m_ssl_socket->bytesToWrite()},
+    });
   }
 
   /**
@@ -97,6 +274,26 @@ class Client : public discovery::Client {
    */
   void processSyncingPacket(const packets::SyncingPacket& packet);
 
+  /**
+   * @brief Process the items of the syncing packet that has all
+   * of its payloads and emit the signals
+   *
+   * @param items mime type and payload
+   * @param packet packet the items came in
+   */
+  void processSyncingItems(
+      const QVector<QPair<QString, QByteArray>>& items, const packets::SyncingPacket& packet
+  );
+
+  /**
+   * @brief Process the BlobPacket from the server, the wanted
+   * payloads are sent and the sent payloads resume the waiting
+   * syncing packet
+   *
+   * @param packet BlobPacket
+   */
+  void processBlobPacket(const packets::BlobPacket& packet);
+
   /**
    * @brief Process the Invalid packet that has been received
    * from the server and emit the signal
@@ -105,6 +302,29 @@ class Client : public discovery::Client {
    */
   void processInvalidPacket(const packets::InvalidRequest& packet);
 
+  /**
+   * @brief Process the HelloPacket from the server, the server is
+   * left if the versions don't overlap else the lower version and
+   * the common features are used with it
+   *
+   * @param packet HelloPacket
+   */
+  void processHelloPacket(const packets::HelloPacket& packet);
+
+  /**
+   * @brief Send the filter to the server and the standby server
+   * if they agreed on the filters
+   */
+  void sendFilter();
+
+  /**
+   * @brief Get the filter of the standby server, it is the filter
+   * paused so the standby sends no syncs till it is promoted
+   *
+   * @return packets::FilterPacket
+   */
+  packets::FilterPacket standbyFilter() const;
+
   /**
    * @brief Updates the server list by removing the
    * server that that has exceeded the threshold
@@ -112,12 +332,105 @@ class Client : public discovery::Client {
    */
   void updateServerList();
 
+  /**
+   * @brief Process the packet from the server by its type, the
+   * chunks are joined and the whole packet is processed
+   *
+   * @param data packet
+   */
+  void processPacket(const QByteArray& data);
+
   /**
    * @brief Process the packet that has been received
    * from the server
    */
   void processReadyRead();
 
+  /**
+   * @brief Get the certificate fingerprint of the server
+   *
+   * @return QByteArray SHA-256 fingerprint or empty
+   */
+  QByteArray getFingerprint() const;
+
+  /**
+   * @brief Verify the server once the TLS handshake is done, the
+   * pinned servers are trusted immediately others are verified
+   * by the authenticator
+   */
+  void processEncrypted();
+
+  /**
+   * @brief Process the result of the authenticator for the
+   * server with the fingerprint
+   *
+   * @param fingerprint fingerprint of the verified server
+   * @param accepted Result of the authenticator
+   */
+  void processVerification(const QByteArray& fingerprint, bool accepted);
+
+  /**
+   * @brief Process the disconnection from the server
+   */
+  void processDisconnection();
+
+  /**
+   * @brief Connect the signals of the socket to the server
+   *
+   * @param socket socket to the server
+   */
+  void attachSocket(QSslSocket* socket);
+
+  /**
+   * @brief Look up the traffic counters of the server the socket
+   * is connected to
+   */
+  void setTraffic();
+
+  /**
+   * @brief Sort the servers from the best, the full servers are
+   * the last and the others are ranked by the rtt with the load
+   * added as the cost of a full server times the load
+   */
+  void rankServers();
+
+  /**
+   * @brief Connect to the standby server if it is ready else to
+   * the best server that is not lost, nothing is done if failover
+   * is disabled, the user disconnected or it is connected
+   */
+  void failover();
+
+  /**
+   * @brief Connect the standby to the next best server if there
+   * is none, drop it if not needed
+   */
+  void updateStandby();
+
+  /**
+   * @brief Drop the standby connection
+   */
+  void dropStandby();
+
+  /**
+   * @brief Use the standby connection as the connection to the
+   * server, the server has already verified it
+   */
+  void promoteStandby();
+
+  /**
+   * @brief Keep the standby connection only if the server is
+   * pinned, nobody is asked about a standby
+   */
+  void processStandbyEncrypted();
+
+  /**
+   * @brief Drop the packets that arrive on the standby connection
+   * keeping the stream at the start of a packet, only the hello
+   * is kept for the time the standby is promoted
+   */
+  void processStandbyReadyRead();
+
  public:
 
   /**
@@ -143,13 +456,118 @@ class Client : public discovery::Client {
    */
   void syncItems(QVector<QPair<QString, QByteArray>> items);
 
+  /**
+   * @brief Send the items of a sync that started at other node
+   * to the server, it is used by the relays to keep the header,
+   * the latest sync is held till the server says hello
+   *
+   * @param items mime type and payload
+   * @param syncId id of the sync
+   * @param originId id of the node the sync started at
+   * @param hopCount number of relays the sync went through
+   * @param generation generation of the copy
+   */
+  void relayItems(
+      QVector<QPair<QString, QByteArray>> items,
+      quint64 syncId,
+      quint64 originId,
+      quint8 hopCount,
+      quint64 generation
+  );
+
+  /**
+   * @brief Is the client connected to the server and verified
+   *
+   * @return bool
+   */
+  bool isConnected() const;
+
+  /**
+   * @brief Get the protocol version agreed with the server, 0 till
+   * the server says hello
+   *
+   * @return quint16
+   */
+  quint16 getVersion() const;
+
+  /**
+   * @brief Get the features agreed with the server
+   *
+   * @return quint32 bits of the HelloPacket::Feature
+   */
+  quint32 getFeatures() const;
+
+  /**
+   * @brief Set the Node Id object, the syncs with the id as the
+   * origin are dropped since they came back to this node
+   *
+   * @param id
+   */
+  void setNodeId(quint64 id);
+
+  /**
+   * @brief Get the Node Id object
+   *
+   * @return quint64
+   */
+  quint64 getNodeId() const;
+
   /**
    * @brief Get the Server List object
    *
-   * @return QList<QPair<QHostAddress, quint16>> List of servers
+   * @return QList<QPair<QHostAddress, quint16>> List of servers from the best
    */
   QList<QPair<QHostAddress, quint16>> getServerList() const;
 
+  /**
+   * @brief Set the Failover, if enabled the client connects to
+   * the best server when it is not connected, the connected server
+   * that stops answering the discovery for the threshold is left
+   * for the next best one
+   *
+   * @param enabled
+   */
+  void setFailover(bool enabled);
+
+  /**
+   * @brief Is the Failover enabled
+   *
+   * @return bool
+   */
+  bool isFailover() const;
+
+  /**
+   * @brief Set the Standby, if enabled a connection to the next
+   * best pinned server is held so the failover is only a switch
+   *
+   * @param enabled
+   */
+  void setStandby(bool enabled);
+
+  /**
+   * @brief Is the Standby enabled
+   *
+   * @return bool
+   */
+  bool isStandby() const;
+
+  /**
+   * @brief Set the Filter, the server sends only the items the
+   * filter accepts e.g. only the text to a tethered laptop, it is
+   * sent again on every connect, the servers that don't support
+   * the filters send all the items
+   *
+   * @param filter FilterPacket
+   */
+  void setFilter(const packets::FilterPacket& filter);
+
+  /**
+   * @brief Get the Filter object
+   *
+   * @return packets::FilterPacket
+   */
+  packets::FilterPacket getFilter() const;
+
   /**
    * @brief Connect to the server with the given host and port
    * number
@@ -184,15 +602,64 @@ class Client : public discovery::Client {
    */
   QSslConfiguration getSSLConfiguration() const;
 
+  /**
+   * @brief Set the Authenticator that verifies the servers
+   * that are not pinned in the trust store
+   *
+   * @param auth Authenticator
+   */
+  void setAuthenticator(Authenticator auth);
+
+  /**
+   * @brief Get the Authenticator object
+   *
+   * @return Authenticator
+   */
+  Authenticator getAuthenticator() const;
+
+  /**
+   * @brief Set the Trust Store, the servers pinned in the store
+   * are trusted and verified servers are pinned to it
+   *
+   * @param store Trust store
+   */
+  void setTrustStore(storage::TrustStore* store);
+
+  /**
+   * @brief Get the Trust Store object
+   *
+   * @return storage::TrustStore*
+   */
+  storage::TrustStore* getTrustStore() const;
+
+  /**
+   * @brief Set the Blob Store, the payloads in the store are not
+   * asked from the server and the large payloads are offered by
+   * the hash through it
+   *
+   * @param store Blob store
+   */
+  void setBlobStore(storage::BlobStore* store);
+
+  /**
+   * @brief Get the Blob Store object
+   *
+   * @return storage::BlobStore*
+   */
+  storage::BlobStore* getBlobStore() const;
+
  protected:  // abstract functions from the base class
 
   /**
    * @brief On server found function that That Called by the
    * discovery client when the server is found
    *
-   * @param host Host address
-   * @param port Port number
+   * @param server Host address and port number
+   * @param rtt time from the broadcast to the response in nanoseconds
+   * @param packet response with the load and the version of the server
    */
-  void onServerFound(QPair<QHostAddress, quint16> server) override;
+  void onServerFound(
+      QPair<QHostAddress, quint16> server, qint64 rtt, const packets::DiscoveryPacket& packet
+  ) override;
 };
 }  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
@@ -0,0 +1,44 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "encoder.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::syncing {
+/**
+ * @brief Start the frame over keeping its memory if it is not
+ * too large, the frame still shared by a write is detached
+ *
+ * @param size size of the next packet
+ */
+void Encoder::rewind(qsizetype size) {
+  // the device is opened again on the frame
+  m_device.close();
+
+  // don't hold the memory of a large packet
+  if (m_frame.capacity() > maxRetained) m_frame = QByteArray();
+
+  // truncate keeps the memory of the frame
+  m_device.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+  // grow once for the packet
+  m_frame.reserve(size);
+}
+
+/**
+ * @brief Construct a new Encoder object
+ */
+Encoder::Encoder() {
+  m_device.setBuffer(&m_frame);
+}
+
+/**
+ * @brief Get the bytes kept by the frame
+ *
+ * @return qsizetype
+ */
+qsizetype Encoder::getCapacity() const {
+  return m_frame.capacity();
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
@@ -0,0 +1,93 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QBuffer>
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QtTypes>
+
+namespace srilakshmikanthanp::clipbirdesk::network::syncing {
+/**
+ * @brief Encoder of the packets to a peer, the packets are written
+ * to a frame that is kept between the packets so the small syncs
+ * reuse its memory instead of allocating a buffer for each, the
+ * frame is free again once the device copied it on the write
+ */
+class Encoder {
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(Encoder)
+
+ public:  // Constants
+
+  /// @brief Frames larger than it are released instead of kept
+  static constexpr qsizetype maxRetained = 256 * 1024;
+
+ private:  // Member variables
+
+  /// @brief Frame the packets are written to
+  QByteArray m_frame;
+
+  /// @brief Device on the frame
+  QBuffer m_device;
+
+ private:  // Member functions
+
+  /**
+   * @brief Start the frame over keeping its memory if it is not
+   * too large, the frame still shared by a write is detached
+   *
+   * @param size size of the next packet
+   */
+  void rewind(qsizetype size);
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Encoder object
+   */
+  Encoder();
+
+  /**
+   * @brief Encode the packet to the frame, the returned bytes share
+   * the frame so it is to be written before the next packet
+   *
+   * @tparam Packet
+   * @param packet packet to encode
+   * @return QByteArray encoded packet
+   */
+  template <typename Packet>
+  QByteArray encode(const Packet& packet) {
+    // start the frame over
+    this->rewind(packet.size());
+
+    // create the data stream
+    QDataStream stream(&m_device);
+
+    // set the version
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    // set Byte Order
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    // write the packet
+    stream << packet;
+
+    // return the frame
+    return m_frame;
+  }
+
+  /**
+   * @brief Get the bytes kept by the frame
+   *
+   * @return qsizetype
+   */
+  qsizetype getCapacity() const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
@@ -0,0 +1,72 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "generation.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::syncing {
+/**
+ * @brief Get the generation of a new copy at the node
+ *
+ * @param nodeId id of the node the copy starts at
+ * @return quint64 generation of the copy
+ */
+quint64 Generation::next(quint64 nodeId) {
+  // after all the generations seen and not before the time
+  const auto now = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
+  m_value        = std::max(m_value + 1, now);
+  m_origin       = nodeId;
+
+  // the generation of the copy
+  return m_value;
+}
+
+/**
+ * @brief Is the sync older than the newest generation seen, the
+ * sync without a generation is never stale
+ *
+ * @param generation generation of the sync
+ * @param originId id of the node the sync started at
+ * @return true if the sync is to be dropped
+ */
+bool Generation::isStale(quint64 generation, quint64 originId) const {
+  // the sync of a peer that doesn't order them
+  if (generation == 0) return false;
+
+  // older or the same generation from a lower node
+  return generation < m_value || (generation == m_value && originId < m_origin);
+}
+
+/**
+ * @brief Move the clock to the generation of the sync if it is
+ * not stale
+ *
+ * @param generation generation of the sync
+ * @param originId id of the node the sync started at
+ * @return true if the sync is newer else it is to be dropped
+ */
+bool Generation::advance(quint64 generation, quint64 originId) {
+  // drop the stale sync
+  if (this->isStale(generation, originId)) return false;
+
+  // the sync without a generation doesn't move the clock
+  if (generation == 0) return true;
+
+  // the newest generation
+  m_value  = generation;
+  m_origin = originId;
+
+  // the sync is newer
+  return true;
+}
+
+/**
+ * @brief Get the newest generation seen
+ *
+ * @return quint64
+ */
+quint64 Generation::value() const {
+  return m_value;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
@@ -0,0 +1,70 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QDateTime>
+#include <QtTypes>
+
+// standard headers
+#include <algorithm>
+
+namespace srilakshmikanthanp::clipbirdesk::network::syncing {
+/**
+ * @brief Clock of the clipboard generations, a copy gets the next
+ * generation that is after all the generations seen so far and
+ * not before the time in milliseconds so the peers that haven't
+ * seen each other still order their copies, the sync of a lower
+ * generation than the last one is stale and the id of the node
+ * the copy started at breaks the ties
+ */
+class Generation {
+ private:  // Member variables
+
+  /// @brief Newest generation seen
+  quint64 m_value  = 0;
+
+  /// @brief Node the newest generation started at
+  quint64 m_origin = 0;
+
+ public:  // Member functions
+
+  /**
+   * @brief Get the generation of a new copy at the node
+   *
+   * @param nodeId id of the node the copy starts at
+   * @return quint64 generation of the copy
+   */
+  quint64 next(quint64 nodeId);
+
+  /**
+   * @brief Is the sync older than the newest generation seen, the
+   * sync without a generation is never stale
+   *
+   * @param generation generation of the sync
+   * @param originId id of the node the sync started at
+   * @return true if the sync is to be dropped
+   */
+  bool isStale(quint64 generation, quint64 originId) const;
+
+  /**
+   * @brief Move the clock to the generation of the sync if it is
+   * not stale
+   *
+   * @param generation generation of the sync
+   * @param originId id of the node the sync started at
+   * @return true if the sync is newer else it is to be dropped
+   */
+  bool advance(quint64 generation, quint64 originId);
+
+  /**
+   * @brief Get the newest generation seen
+   *
+   * @return quint64
+   */
+  quint64 value() const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
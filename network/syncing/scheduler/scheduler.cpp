@@ -0,0 +1,232 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "scheduler.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::syncing {
+/**
+ * @brief Write the chunks of the transfers while the device has
+ * little to write, the transfer with the least left goes first
+ */
+void Scheduler::pump() {
+  // using the functions from namespace
+  using utility::functions::createPacket;
+
+  // flags of the chunks
+  using Flag = packets::ChunkPacket::Flag;
+
+  // bytes left of the transfer
+  const auto isShorter = [](const Transfer& a, const Transfer& b) {
+    return a.data.size() - a.offset < b.data.size() - b.offset;
+  };
+
+  // write while the device has little to write
+  while (!m_transfers.isEmpty() && m_device->isOpen() &&
+         m_device->bytesToWrite() < m_lowWatermark) {
+    // the transfer with the least left
+    const auto it = std::min_element(m_transfers.begin(), m_transfers.end(), isShorter);
+
+    // next part of the transfer, not copied since it is encoded at once
+    const auto size = std::min(chunkSize, it->data.size() - it->offset);
+    const auto part = QByteArray::fromRawData(it->data.constData() + it->offset, size);
+    const auto last = it->offset + part.size() == it->data.size();
+    const auto type = packets::ChunkPacket::PacketType::Chunk;
+
+    // flags of the part
+    quint8 flags    = 0;
+    if (it->offset == 0) flags |= Flag::First;
+    if (last) flags |= Flag::Last;
+
+    // write the part
+    m_device->write(m_encoder.encode(createPacket({type, it->streamId, flags, part})));
+
+    // the transfer is done
+    if (last) {
+      m_transfers.erase(it);
+    } else {
+      it->offset += part.size();
+    }
+  }
+}
+
+/**
+ * @brief Construct a new Scheduler object for the device
+ *
+ * @param device device to write
+ * @param parent parent object
+ */
+Scheduler::Scheduler(QIODevice* device, QObject* parent) : QObject(parent), m_device(device) {
+  // write the next chunks once the device has written
+  const auto signal_w = &QIODevice::bytesWritten;
+  const auto slot_w   = &Scheduler::pump;
+  connect(m_device, signal_w, this, slot_w);
+}
+
+/**
+ * @brief Set the Chunking, only the peers that agreed on the
+ * chunks get them, else the packets are written as they are
+ *
+ * @param enabled
+ */
+void Scheduler::setChunking(bool enabled) {
+  m_chunking = enabled;
+}
+
+/**
+ * @brief Is the Chunking enabled
+ *
+ * @return bool
+ */
+bool Scheduler::isChunking() const {
+  return m_chunking;
+}
+
+/**
+ * @brief Get the Encoder of the packets to the device, the
+ * encoded packet is to be sent before the next is encoded
+ *
+ * @return Encoder&
+ */
+Encoder& Scheduler::getEncoder() {
+  return m_encoder;
+}
+
+/**
+ * @brief Send the encoded packet, the small packets are written
+ * at once and the large ones are cut into chunks
+ *
+ * @param data encoded packet
+ * @param syncId id of the sync the packet is part of if any
+ */
+void Scheduler::send(const QByteArray& data, quint64 syncId) {
+  // the small packets go ahead of the chunks
+  if (!m_chunking || data.size() <= chunkSize) {
+    m_device->write(data);
+    return;
+  }
+
+  // cut the large packet into chunks
+  m_transfers.append({m_nextStream++, syncId, data, 0});
+
+  // write the first chunks
+  this->pump();
+}
+
+/**
+ * @brief Cancel the transfers of the other syncs since the sync
+ * replaces them, the receiver drops what it got of them
+ *
+ * @param syncId id of the newer sync
+ */
+void Scheduler::supersede(quint64 syncId) {
+  // using the functions from namespace
+  using utility::functions::createPacket;
+
+  // count of the cancelled transfers
+  static auto& cancelled = metrics::Registry::instance().counter(
+      "clipbird_transfers_cancelled_total"
+  );
+
+  // is the transfer replaced by the sync
+  const auto isReplaced = [&](const Transfer& transfer) {
+    // the transfers that are not syncs are kept
+    if (transfer.syncId == 0 || transfer.syncId == syncId) return false;
+
+    // the receiver drops what it got
+    if (transfer.offset > 0) {
+      const auto type  = packets::ChunkPacket::PacketType::Chunk;
+      const auto flags = packets::ChunkPacket::Flag::Cancel;
+      const auto cancel = createPacket({type, transfer.streamId, flags, QByteArray()});
+      m_device->write(m_encoder.encode(cancel));
+    }
+
+    // cancel the transfer
+    cancelled.inc();
+    return true;
+  };
+
+  // drop the replaced transfers
+  m_transfers.removeIf(isReplaced);
+}
+
+/**
+ * @brief Join the chunk with the ones of its stream, the stream
+ * that grows past the maximum packet size is dropped
+ *
+ * @param chunk ChunkPacket
+ * @return QByteArray whole packet or empty if not complete yet
+ */
+QByteArray Scheduler::reassemble(const packets::ChunkPacket& chunk) {
+  // flags of the chunks
+  using Flag       = packets::ChunkPacket::Flag;
+  const auto flags = chunk.getFlags();
+
+  // is the stream of the chunk
+  const auto isStream = [&](const Stream& stream) {
+    return stream.streamId == chunk.getStreamId();
+  };
+
+  // find the stream
+  auto it = std::find_if(m_streams.begin(), m_streams.end(), isStream);
+
+  // drop the cancelled stream
+  if (flags & Flag::Cancel) {
+    if (it != m_streams.end()) m_streams.erase(it);
+    return QByteArray();
+  }
+
+  // the whole packet in one chunk
+  if ((flags & Flag::First) && (flags & Flag::Last)) {
+    return chunk.getPayload();
+  }
+
+  // start the stream
+  if (flags & Flag::First) {
+    if (it != m_streams.end()) m_streams.erase(it);
+    if (m_streams.size() >= m_maxStreams) m_streams.removeFirst();
+    m_streams.append({chunk.getStreamId(), chunk.getPayload()});
+    return QByteArray();
+  }
+
+  // the start of the stream is missed
+  if (it == m_streams.end()) return QByteArray();
+
+  // drop the stream that grows past the maximum packet size
+  if (it->data.size() + chunk.getPayload().size() > m_maxBytes) {
+    m_streams.erase(it);
+    return QByteArray();
+  }
+
+  // add the part
+  it->data.append(chunk.getPayload());
+
+  // not complete yet
+  if (!(flags & Flag::Last)) return QByteArray();
+
+  // the whole packet
+  return m_streams.takeAt(std::distance(m_streams.begin(), it)).data;
+}
+
+/**
+ * @brief Get the bytes of the transfers that are not written yet
+ *
+ * @return qint64
+ */
+qint64 Scheduler::getPendingBytes() const {
+  qint64 pending = 0;
+  for (const auto& transfer : m_transfers) pending += transfer.data.size() - transfer.offset;
+  return pending;
+}
+
+/**
+ * @brief Drop the transfers and the streams e.g. the device is
+ * connected to an other peer
+ */
+void Scheduler::reset() {
+  m_transfers.clear();
+  m_streams.clear();
+  m_chunking = false;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
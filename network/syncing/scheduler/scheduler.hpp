@@ -0,0 +1,180 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+#include <QObject>
+#include <QtTypes>
+
+// standard headers
+#include <algorithm>
+
+// Local headers
+#include "constants/constants.hpp"
+#include "network/packets/chunkpacket/chunkpacket.hpp"
+#include "network/syncing/encoder/encoder.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+#include "utility/metrics/metrics.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::network::syncing {
+/**
+ * @brief Scheduler of the writes to a peer, the small packets are
+ * written at once and the large ones are cut into chunks that are
+ * written only while the socket has little to write, so a text copy
+ * is not stuck behind a large image, the transfer with the least
+ * left goes first and the transfers of a sync that is replaced by
+ * a newer sync are cancelled, it also joins the chunks that arrive
+ * and keeps the encoder of the packets to the peer
+ */
+class Scheduler : public QObject {
+ private:  // just for Qt
+
+  /// @brief Qt meta object
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(Scheduler)
+
+ public:  // Constants
+
+  /// @brief Size of the chunks, the packets up to it are not cut
+  static constexpr qsizetype chunkSize = 64 * 1024;
+
+ private:  // Types
+
+  /**
+   * @brief Large packet that is being sent
+   */
+  struct Transfer {
+    quint32 streamId;
+    quint64 syncId;
+    QByteArray data;
+    qsizetype offset;
+  };
+
+  /**
+   * @brief Large packet that is being received
+   */
+  struct Stream {
+    quint32 streamId;
+    QByteArray data;
+  };
+
+ private:  // Member variables
+
+  /// @brief Device to write
+  QIODevice* m_device;
+
+  /// @brief Encoder of the packets to the device
+  Encoder m_encoder;
+
+  /// @brief Transfers that are being sent
+  QList<Transfer> m_transfers;
+
+  /// @brief Streams that are being received from the oldest
+  QList<Stream> m_streams;
+
+  /// @brief Id of the next transfer
+  quint32 m_nextStream         = 1;
+
+  /// @brief Are the large packets cut into chunks
+  bool m_chunking              = false;
+
+  /// @brief Chunks are written while the device has less to write
+  const qint64 m_lowWatermark  = 2 * chunkSize;
+
+  /// @brief Maximum number of the streams that are being received
+  const qsizetype m_maxStreams = 16;
+
+  /// @brief Maximum size of a stream that is being received
+  const qint64 m_maxBytes      = constants::getMaxPacketSize();
+
+ private:  // Member functions
+
+  /**
+   * @brief Write the chunks of the transfers while the device has
+   * little to write, the transfer with the least left goes first
+   */
+  void pump();
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Scheduler object for the device
+   *
+   * @param device device to write
+   * @param parent parent object
+   */
+  explicit Scheduler(QIODevice* device, QObject* parent = nullptr);
+
+  /**
+   * @brief Set the Chunking, only the peers that agreed on the
+   * chunks get them, else the packets are written as they are
+   *
+   * @param enabled
+   */
+  void setChunking(bool enabled);
+
+  /**
+   * @brief Is the Chunking enabled
+   *
+   * @return bool
+   */
+  bool isChunking() const;
+
+  /**
+   * @brief Get the Encoder of the packets to the device, the
+   * encoded packet is to be sent before the next is encoded
+   *
+   * @return Encoder&
+   */
+  Encoder& getEncoder();
+
+  /**
+   * @brief Send the encoded packet, the small packets are written
+   * at once and the large ones are cut into chunks
+   *
+   * @param data encoded packet
+   * @param syncId id of the sync the packet is part of if any
+   */
+  void send(const QByteArray& data, quint64 syncId = 0);
+
+  /**
+   * @brief Cancel the transfers of the other syncs since the sync
+   * replaces them, the receiver drops what it got of them
+   *
+   * @param syncId id of the newer sync
+   */
+  void supersede(quint64 syncId);
+
+  /**
+   * @brief Join the chunk with the ones of its stream, the stream
+   * that grows past the maximum packet size is dropped
+   *
+   * @param chunk ChunkPacket
+   * @return QByteArray whole packet or empty if not complete yet
+   */
+  QByteArray reassemble(const packets::ChunkPacket& chunk);
+
+  /**
+   * @brief Get the bytes of the transfers that are not written yet
+   *
+   * @return qint64
+   */
+  qint64 getPendingBytes() const;
+
+  /**
+   * @brief Drop the transfers and the streams e.g. the device is
+   * connected to an other peer
+   */
+  void reset();
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
@@ -7,25 +7,479 @@
 
 namespace srilakshmikanthanp::clipbirdesk::network::syncing {
 
+/**
+ * @brief Write the encoded packet to the client through its
+ * scheduler so the large packets don't hold the small ones
+ *
+ * @param client Client to write
+ * @param data encoded packet
+ * @param syncId id of the sync the packet is part of if any
+ */
+void Server::writeData(QAbstractSocket *client, const QByteArray &data, quint64 syncId) {
+  // find the scheduler of the client
+  const auto it = m_peers.constFind(qobject_cast<QSslSocket *>(client));
+
+  // the client that is not accepted has none
+  if (it == m_peers.constEnd() || it->scheduler == nullptr) {
+    client->write(data);
+  } else {
+    it->scheduler->send(data, syncId);
+  }
+}
+
+/**
+ * @brief Check the sync is new to this server, the sync that
+ * came back to this node, was seen recently or went through
+ * too many relays is dropped
+ *
+ * @param syncId id of the sync
+ * @param originId id of the node the sync started at
+ * @param hopCount number of relays the sync went through
+ *
+ * @return true if the sync is to be processed
+ */
+bool Server::acceptSync(quint64 syncId, quint64 originId, quint8 hopCount) {
+  // the sync came back or went around the mesh
+  if (originId == m_nodeId || hopCount >= m_maxHops || !this->markSeen(syncId)) {
+    metrics::Registry::instance().counter("clipbird_syncs_dropped_total").inc();
+    return false;
+  }
+
+  // process the sync
+  return true;
+}
+
+/**
+ * @brief Remember the sync so it is dropped if it comes again
+ *
+ * @param syncId id of the sync
+ * @return true if the sync was not seen recently
+ */
+bool Server::markSeen(quint64 syncId) {
+  // seen recently
+  if (m_seen.contains(syncId)) return false;
+
+  // forget the oldest if too many are seen
+  if (m_seenOrder.size() >= m_maxSeen) m_seen.remove(m_seenOrder.dequeue());
+
+  // remember the sync
+  m_seen.insert(syncId);
+  m_seenOrder.enqueue(syncId);
+
+  // not seen
+  return true;
+}
+
 /**
  * @brief Process the SyncingPacket from the client
  *
  * @param packet SyncingPacket
+ * @param client client the packet came from
+ */
+void Server::processSyncingPacket(const packets::SyncingPacket &packet, QSslSocket *client) {
+  // correlate the spans with the sender
+  tracing::SyncScope scope(packet.getSyncId());
+
+  // drop the sync that is not new to this server
+  if (!this->acceptSync(packet.getSyncId(), packet.getOriginId(), packet.getHopCount())) {
+    return;
+  }
+
+  // the sync is older than the copy this server has
+  if (m_generation.isStale(packet.getGeneration(), packet.getOriginId())) {
+    metrics::Registry::instance().counter("clipbird_syncs_stale_total").inc();
+    return;
+  }
+
+  // using the functions from namespace
+  using utility::functions::createPacket;
+  using utility::functions::getMissingBlobs;
+  using utility::functions::resolveItems;
+
+  // payloads that are referenced but not here
+  const auto missing = getMissingBlobs(packet, *m_blobs);
+
+  // if all the payloads are here then process it
+  if (missing.isEmpty()) {
+    return this->processSyncingItems(resolveItems(packet, *m_blobs), packet, client);
+  }
+
+  // drop the oldest if too many are waiting
+  if (m_waiting.size() >= m_maxWaiting) m_waiting.removeFirst();
+
+  // wait for the payloads
+  m_waiting.append({client, packet});
+
+  // ask the client for the payloads
+  const auto packType = packets::BlobPacket::PacketType::WantBlobs;
+  this->sendPacket(client, createPacket({packType, packet.getSyncId(), missing}));
+}
+
+/**
+ * @brief Process the items of the syncing packet that has all
+ * of its payloads, notify and forward them to the clients
+ *
+ * @param items mime type and payload
+ * @param packet packet the items came in
+ * @param client client the items came from
+ */
+void Server::processSyncingItems(
+    const QVector<QPair<QString, QByteArray>> &items,
+    const packets::SyncingPacket &packet,
+    QSslSocket *client
+) {
+  // the client has the text now
+  utility::functions::updateBases(m_bases[client], items, *m_blobs);
+
+  // drop the sync that a newer copy replaced meanwhile
+  if (!m_generation.advance(packet.getGeneration(), packet.getOriginId())) {
+    metrics::Registry::instance().counter("clipbird_syncs_stale_total").inc();
+    return;
+  }
+
+  // Notify the listeners to sync the data
+  emit OnSyncRequest(items, client->peerAddress().toString());
+
+  // header of the sync
+  const auto syncId     = packet.getSyncId();
+  const auto originId   = packet.getOriginId();
+  const auto hopCount   = static_cast<quint8>(packet.getHopCount() + 1);
+  const auto generation = packet.getGeneration();
+
+  // send the items to the others
+  this->sendItems(items, syncId, originId, hopCount, generation, client);
+}
+
+/**
+ * @brief Process the items that came from an other server
+ * through the relay, notify and forward them to the clients
+ *
+ * @param items mime type and payload
+ * @param syncId id of the sync
+ * @param originId id of the node the sync started at
+ * @param hopCount number of relays the sync went through
+ * @param generation generation of the copy
+ * @param relay relay the items came from
  */
-void Server::processSyncingPacket(const packets::SyncingPacket &packet) {
-  // Make the vector of QPair<QString, QByteArray>
-  QVector<QPair<QString, QByteArray>> items;
+void Server::processRelayItems(
+    const QVector<QPair<QString, QByteArray>> &items,
+    quint64 syncId,
+    quint64 originId,
+    quint8 hopCount,
+    quint64 generation,
+    Client *relay
+) {
+  // correlate the spans with the sender
+  tracing::SyncScope scope(syncId);
 
-  // Get the items from the packet
-  for (auto item : packet.getItems()) {
-    items.append({item.getMimeType().toStdString().c_str(), item.getPayload()});
+  // drop the sync that is not new to this server
+  if (!this->acceptSync(syncId, originId, hopCount)) return;
+
+  // drop the sync that is older than the copy this server has
+  if (!m_generation.advance(generation, originId)) {
+    metrics::Registry::instance().counter("clipbird_syncs_stale_total").inc();
+    return;
   }
 
   // Notify the listeners to sync the data
-  emit OnSyncRequest(items);
+  emit OnSyncRequest(items, relay->getConnectedServer().first.toString());
 
-  // send the packet to all the clients
-  this->sendPacket(packet);
+  // send the items to the others
+  const auto hops = static_cast<quint8>(hopCount + 1);
+  this->sendItems(items, syncId, originId, hops, generation, relay);
+}
+
+/**
+ * @brief Connect the relays that are not connected
+ */
+void Server::connectRelays() {
+  for (const auto &relay : std::as_const(m_relays)) {
+    if (!relay.client->isConnected()) relay.client->connectToServer(relay.peer);
+  }
+}
+
+/**
+ * @brief Send the items to all the clients and the relays but
+ * the one they came from, the large text is sent as a delta
+ * against the last text each client has, each client gets only
+ * the items its filter accepts
+ *
+ * @param items mime type and payload
+ * @param syncId id of the sync
+ * @param originId id of the node the sync started at
+ * @param hopCount number of relays the sync went through
+ * @param generation generation of the copy
+ * @param from client or relay the items came from if any
+ */
+void Server::sendItems(
+    const QVector<QPair<QString, QByteArray>> &items,
+    quint64 syncId,
+    quint64 originId,
+    quint8 hopCount,
+    quint64 generation,
+    const QObject *from
+) {
+  // packets by the version, the features and the items with their
+  // bases, the clients that have the same of them share the packet
+  QHash<QByteArray, packets::SyncingPacket> packets;
+
+  // the sync to send
+  const Sync sync{items, syncId, originId, hopCount, generation};
+
+  // send to all the clients but the sender
+  for (auto client : m_clients) {
+    if (client != from) this->sendItemsTo(client, sync, packets);
+  }
+
+  // send to the other servers but the sender
+  for (const auto &relay : std::as_const(m_relays)) {
+    if (relay.client != from && relay.client->isConnected()) {
+      relay.client->relayItems(items, syncId, originId, hopCount, generation);
+    }
+  }
+}
+
+/**
+ * @brief Send the sync to the client in the version it agreed on,
+ * the client that has not said hello yet gets the latest sync
+ * once it does since the version it reads is not known till then
+ *
+ * @param client client to send
+ * @param sync sync to send
+ * @param packets packets shared by the clients of a sync
+ */
+void Server::sendItemsTo(
+    QSslSocket *client, const Sync &sync, QHash<QByteArray, packets::SyncingPacket> &packets
+) {
+  // using the functions from namespace
+  using utility::functions::createSyncingPacket;
+  using utility::functions::filterItems;
+  using utility::functions::updateBases;
+
+  // version, features and filter of the client
+  const auto peer = m_peers.find(client);
+
+  // the client is not accepted yet
+  if (peer == m_peers.end()) return;
+
+  // hold the sync till the client says hello
+  if (peer->version == 0) {
+    peer->held = sync;
+    return;
+  }
+
+  // bases of the client
+  auto &bases = m_bases[client];
+
+  // the items the client wants, filtered before encoding
+  const auto accepted = filterItems(sync.items, peer->filter);
+
+  // the client wants none of them
+  if (accepted.isEmpty()) return;
+
+  // key of the version, the features and the items with their bases
+  QByteArray key(reinterpret_cast<const char *>(&peer->version), sizeof(peer->version));
+  key.append(reinterpret_cast<const char *>(&peer->features), sizeof(peer->features));
+  for (const auto &item : accepted) key += item.first.toUtf8() + '\0' + bases.value(item.first);
+
+  // create the packet if not created
+  auto it = packets.find(key);
+  if (it == packets.end()) {
+    auto packet = createSyncingPacket(
+        accepted, sync.syncId, *m_blobs, bases, peer->features, peer->version
+    );
+    it = packets.insert(key, packet);
+    it->setOriginId(sync.originId);
+    it->setHopCount(sync.hopCount);
+    it->setGeneration(sync.generation);
+  }
+
+  // the older transfers to the client are stale now, the stale
+  // sync must not cancel the transfer of a newer one
+  if (!m_generation.isStale(sync.generation, sync.originId)) {
+    peer->scheduler->supersede(sync.syncId);
+  }
+
+  // send the packet to the client
+  this->sendPacket(client, *it, sync.syncId);
+
+  // the client has the text now
+  updateBases(bases, accepted, *m_blobs);
+}
+
+/**
+ * @brief Process the BlobPacket from the client, the wanted
+ * payloads are sent and the sent payloads resume the waiting
+ * syncing packet
+ *
+ * @param packet BlobPacket
+ * @param client client the packet came from
+ */
+void Server::processBlobPacket(const packets::BlobPacket &packet, QSslSocket *client) {
+  // correlate the spans with the sender
+  tracing::SyncScope scope(packet.getSyncId());
+
+  // using the functions from namespace
+  using utility::functions::createPacket;
+  using utility::functions::getBlobs;
+  using utility::functions::getMissingBlobs;
+  using utility::functions::resolveItems;
+
+  // send the payloads the client wants
+  if (packet.getPacketType() == packets::BlobPacket::PacketType::WantBlobs) {
+    const auto packType = packets::BlobPacket::PacketType::SendBlobs;
+    const auto blobs    = getBlobs(packet.getBlobs(), *m_blobs);
+    const auto packet_s = createPacket({packType, packet.getSyncId(), blobs});
+    return this->sendPacket(client, packet_s, packet.getSyncId());
+  }
+
+  // is the packet waiting for the payloads
+  const auto isWaiting = [&](const Waiting &waiting) {
+    return waiting.client == client && waiting.packet.getSyncId() == packet.getSyncId();
+  };
+
+  // find the waiting packet
+  const auto it = std::find_if(m_waiting.begin(), m_waiting.end(), isWaiting);
+
+  // if not waiting then ignore
+  if (it == m_waiting.end()) return;
+
+  // take the waiting packet
+  const auto waiting = m_waiting.takeAt(std::distance(m_waiting.begin(), it));
+
+  // hold the payloads while the packet is processed
+  QVector<QByteArray> hashes;
+  for (const auto &blob : packet.getBlobs()) hashes.append(m_blobs->put(blob));
+
+  // process the packet if all the payloads are here
+  if (getMissingBlobs(waiting.packet, *m_blobs).isEmpty()) {
+    const auto items = resolveItems(waiting.packet, *m_blobs);
+    this->processSyncingItems(items, waiting.packet, client);
+  } else {
+    emit OnErrorOccurred("Payloads of the sync are not available");
+  }
+
+  // release the payloads
+  for (const auto &hash : hashes) m_blobs->release(hash);
+}
+
+/**
+ * @brief Process the HelloPacket from the client, the client is
+ * disconnected if the versions don't overlap else the lower
+ * version and the common features are used with it
+ *
+ * @param packet HelloPacket
+ * @param client client the packet came from
+ */
+void Server::processHelloPacket(const packets::HelloPacket &packet, QSslSocket *client) {
+  // versions of this server
+  const auto version    = constants::getProtocolVersion();
+  const auto minVersion = constants::getMinProtocolVersion();
+
+  // if the versions don't overlap then disconnect
+  if (packet.getVersion() < minVersion || packet.getMinVersion() > version) {
+    const auto packType = packets::InvalidRequest::PacketType::RequestFailed;
+    const auto code     = types::enums::ErrorCode::VersionError;
+    const auto message  = "Protocol Version is not supported";
+    this->sendPacket(client, utility::functions::createPacket({packType, code, message}));
+    client->disconnectFromHost();
+    return;
+  }
+
+  // the client is gone meanwhile
+  const auto peer = m_peers.find(client);
+  if (peer == m_peers.end()) return;
+
+  // use the lower version and the common features
+  peer->version  = std::min(packet.getVersion(), version);
+  peer->features = packet.getFeatures() & utility::functions::supportedFeatures;
+
+  // cut the large packets into chunks if agreed
+  peer->scheduler->setChunking(peer->features & packets::HelloPacket::Feature::Chunks);
+
+  // send the sync held till the hello
+  if (const auto held = std::exchange(peer->held, Sync()); !held.items.isEmpty()) {
+    QHash<QByteArray, packets::SyncingPacket> packets;
+    this->sendItemsTo(client, held, packets);
+  }
+}
+
+/**
+ * @brief Process the FilterPacket from the client, the items the
+ * filter doesn't accept are not sent to the client from now
+ *
+ * @param packet FilterPacket
+ * @param client client the packet came from
+ */
+void Server::processFilterPacket(const packets::FilterPacket &packet, QSslSocket *client) {
+  // the client is gone meanwhile
+  const auto peer = m_peers.find(client);
+  if (peer == m_peers.end()) return;
+
+  // the filter of the client
+  peer->filter = packet;
+}
+
+/**
+ * @brief Process the packet from the client by its type, the
+ * chunks are joined and the whole packet is processed
+ *
+ * @param data packet
+ * @param client client the packet came from
+ */
+void Server::processPacket(const QByteArray &data, QSslSocket *client) {
+  // using the fromQByteArray from namespace
+  using utility::functions::fromQByteArray;
+
+  // packet types
+  using SyncingType = packets::SyncingPacket::PacketType;
+  using BlobType    = packets::BlobPacket::PacketType;
+  using HelloType   = packets::HelloPacket::PacketType;
+  using FilterType  = packets::FilterPacket::PacketType;
+  using ChunkType   = packets::ChunkPacket::PacketType;
+
+  // time to decode the packets
+  static auto &decodeTime = metrics::Registry::instance().histogram("clipbird_decode_ns");
+
+  // the peer of the client
+  const auto peer = m_peers.constFind(client);
+
+  // the client is gone meanwhile
+  if (peer == m_peers.constEnd()) return;
+
+  // decode the syncing packet in the version agreed with the client,
+  // the version 1 has no sync id so the sync gets one here
+  const auto decode = [version = peer->version](const QByteArray &data) {
+    CLIPBIRD_TRACE_SPAN("decode");
+    auto packet = fromQByteArray<packets::SyncingPacket>(data, version);
+    if (packet.getSyncId() == 0) packet.setSyncId(QRandomGenerator::global()->generate64());
+    return packet;
+  };
+
+  // process the packet by the type
+  switch (static_cast<quint8>(data.at(0))) {
+  case SyncingType::SyncPacket:
+    processSyncingPacket(metrics::measure(decodeTime, [&] { return decode(data); }), client);
+    break;
+  case BlobType::WantBlobs:
+  case BlobType::SendBlobs:
+    processBlobPacket(fromQByteArray<packets::BlobPacket>(data), client);
+    break;
+  case HelloType::Hello:
+    processHelloPacket(fromQByteArray<packets::HelloPacket>(data), client);
+    break;
+  case FilterType::Filter:
+    processFilterPacket(fromQByteArray<packets::FilterPacket>(data), client);
+    break;
+  case ChunkType::Chunk: {
+    const auto chunk = fromQByteArray<packets::ChunkPacket>(data);
+    const auto whole = peer->scheduler->reassemble(chunk);
+    if (!whole.isEmpty()) processPacket(whole, client);
+    break;
+  }
+  default:
+    throw MalformedPacket(types::enums::ErrorCode::CodingError, "Unknown Packet Found");
+  }
 }
 
 /**
@@ -34,18 +488,35 @@ void Server::processSyncingPacket(const packets::SyncingPacket &packet) {
  */
 void Server::processReadyRead() {
   // Get the client that was ready to read
-  auto client     = qobject_cast<QSslSocket *>(sender());
-
-  // Get the data from the client
-  const auto data = client->readAll();
+  auto client = qobject_cast<QSslSocket *>(sender());
 
-  // using the fromQByteArray from namespace
+  // using the functions from namespace
   using utility::functions::createPacket;
-  using utility::functions::fromQByteArray;
+  using utility::functions::readPacket;
+
+  // address of the client for the log
+  const auto peer = client->peerAddress().toString();
 
-  // Deserialize the data to SyncingPacket
+  // Deserialize the packets that have fully arrived
   try {
-    this->processSyncingPacket(fromQByteArray<packets::SyncingPacket>(data));
+    for (auto data = readPacket(client); !data.isEmpty(); data = readPacket(client)) {
+      // the client is gone while processing the packets
+      const auto found = m_peers.constFind(client);
+      if (found == m_peers.constEnd()) break;
+
+      // record the traffic
+      found->in.record(data.size());
+
+      // log the packet, only formatted if the category is enabled
+      qCDebug(logging::lcNetwork).noquote() << logging::withFields("packet received", {
+        {"peer", peer},
+        {"type", static_cast<quint8>(data.at(0))},
+        {"bytes", data.size()},
+      });
+
+      // process the packet by the type
+      this->processPacket(data, client);
+    }
     return;
   } catch (const types::except::MalformedPacket &e) {
     const auto type = packets::InvalidRequest::PacketType::RequestFailed;
@@ -61,7 +532,125 @@ void Server::processReadyRead() {
 }
 
 /**
- * @brief Process the connections that are pending
+ * @brief Get the certificate fingerprint of the client
+ *
+ * @param client Client
+ * @return QByteArray SHA-256 fingerprint or empty
+ */
+QByteArray Server::getFingerprint(QSslSocket *client) const {
+  // get the certificate of the client
+  const auto certificate = client->peerCertificate();
+
+  // if the client has no certificate then return empty
+  if (certificate.isNull()) return QByteArray();
+
+  // return the fingerprint
+  return certificate.digest(QCryptographicHash::Sha256);
+}
+
+/**
+ * @brief Accept the client and start syncing with it
+ *
+ * @param client Client to accept
+ */
+void Server::acceptClient(QSslSocket *client) {
+  // Connect the client to the callback function that process
+  // the disconnection when the client is disconnected
+  // so the listener can be notified
+  const auto signal_d = &QSslSocket::disconnected;
+  const auto slot_d   = &Server::processDisconnection;
+  QObject::connect(client, signal_d, this, slot_d);
+
+  // Connect the socket to the callback function that
+  // process the ready read when the socket is ready
+  // to read so the listener can be notified
+  const auto signal_r = &QSslSocket::readyRead;
+  const auto slot_r   = &Server::processReadyRead;
+  QObject::connect(client, signal_r, this, slot_r);
+
+  // convert to QPair<QHostAddress, quint16>
+  auto client_info = QPair<QHostAddress, quint16>(client->peerAddress(), client->peerPort());
+
+  // Notify the listeners that the client is connected
+  emit OnCLientStateChanged(client_info, true);
+
+  // Add the client to the list of clients
+  m_clients.append(client);
+
+  // only the inline items till the client says hello
+  auto &peer     = m_peers[client];
+  peer.scheduler = new Scheduler(client, client);
+
+  // the traffic counters of the client
+  peer.in  = metrics::Traffic("in", client_info.first.toString());
+  peer.out = metrics::Traffic("out", client_info.first.toString());
+
+  // using the createPacket from namespace
+  using utility::functions::createPacket;
+
+  // tell the client the versions and the features
+  const auto packType = packets::HelloPacket::PacketType::Hello;
+  const auto version  = constants::getProtocolVersion();
+  const auto minimum  = constants::getMinProtocolVersion();
+  const auto features = utility::functions::supportedFeatures;
+  this->sendPacket(client, createPacket({packType, version, minimum, features}));
+
+  // Notify the listeners that the client list is changed
+  emit OnClientListChanged(getConnectedClientsList());
+
+  // process the data that arrived while pending
+  if (client->bytesAvailable() > 0) {
+    QMetaObject::invokeMethod(client, &QSslSocket::readyRead, Qt::QueuedConnection);
+  }
+}
+
+/**
+ * @brief Reject the client and release it
+ *
+ * @param client Client to reject
+ */
+void Server::rejectClient(QSslSocket *client) {
+  client->disconnectFromHost();
+  client->deleteLater();
+}
+
+/**
+ * @brief Process the result of the authenticator for the
+ * pending client, if the client is no longer pending (e.g.
+ * timed out or disconnected) the result is ignored
+ *
+ * @param client Pending client
+ * @param accepted Result of the authenticator
+ */
+void Server::processAuthentication(QSslSocket *client, bool accepted) {
+  // if the client is not pending then ignore
+  if (!m_pending.removeOne(client)) return;
+
+  // if rejected or gone meanwhile then release it
+  if (!accepted || client->state() != QAbstractSocket::ConnectedState) {
+    return this->rejectClient(client);
+  }
+
+  // get the fingerprint of the client
+  const auto fingerprint = this->getFingerprint(client);
+
+  // pin the client so it is not asked again
+  if (m_trustStore != nullptr && !fingerprint.isEmpty()) {
+    try {
+      m_trustStore->trust(fingerprint, client->peerAddress().toString());
+    } catch (const std::exception &e) {
+      emit OnErrorOccurred(e.what());
+    }
+  }
+
+  // accept the client
+  this->acceptClient(client);
+}
+
+/**
+ * @brief Process the connections that are pending, clients
+ * that are pinned in the trust store are accepted immediately
+ * others are parked until the authenticator answers
  */
 void Server::processConnections() {
   while (m_ssl_server->hasPendingConnections()) {
@@ -71,6 +660,18 @@ void Server::processConnections() {
     // Convert the client to SSL client
     auto client_tls = qobject_cast<QSslSocket *>(client_tcp);
 
+    // record the handshake time
+    if (const auto start = client_tcp->property("handshakeStart"); start.isValid()) {
+      const auto end     = QDeadlineTimer::current().deadlineNSecs();
+      const auto labels  = metrics::Labels{{"role", "server"}};
+      auto &registry     = metrics::Registry::instance();
+      registry.histogram("clipbird_tls_handshake_ns", labels).record(end - start.toLongLong());
+      qCDebug(logging::lcNetwork).noquote() << logging::withFields("handshake done", {
+        {"peer", client_tcp->peerAddress().toString()},
+        {"latency_us", (end - start.toLongLong()) / 1000},
+      });
+    }
+
     // using the createPacket from namespace
     using utility::functions::createPacket;
 
@@ -84,41 +685,60 @@ void Server::processConnections() {
       continue;
     }
 
-    // Peer info
-    const auto peerAddress = client_tls->peerAddress();
-    const auto peerPort    = client_tls->peerPort();
+    // if the server is full then reject it
+    if (static_cast<quint32>(m_clients.size()) >= m_capacity) {
+      this->rejectClient(client_tls);
+      continue;
+    }
 
-    // Authenticate the client
-    if (!m_authenticator({peerAddress, peerPort})) {
-      client_tls->disconnectFromHost();
+    // if the client is pinned then accept it
+    if (m_trustStore && m_trustStore->isTrusted(getFingerprint(client_tls))) {
+      this->acceptClient(client_tls);
+      continue;
+    }
+
+    // if too many clients are waiting then reject it
+    if (m_pending.size() >= m_maxPending) {
+      this->rejectClient(client_tls);
       continue;
     }
 
-    // Connect the client to the callback function that process
-    // the disconnection when the client is disconnected
-    // so the listener can be notified
+    // park the client until the authenticator answers
+    m_pending.append(client_tls);
+
+    // reject the client if not answered in time
+    const auto timeout = [this, client_tls]() {
+      this->processAuthentication(client_tls, false);
+    };
+
+    // start the timeout
+    QTimer::singleShot(m_authTimeout, client_tls, timeout);
+
+    // free the slot at once if the client leaves while waiting
     const auto signal_d = &QSslSocket::disconnected;
-    const auto slot_d   = &Server::processDisconnection;
-    QObject::connect(client_tls, signal_d, this, slot_d);
+    const auto slot_d   = [this, client_tls]() {
+      this->processAuthentication(client_tls, false);
+    };
 
-    // Connect the socket to the callback function that
-    // process the ready read when the socket is ready
-    // to read so the listener can be notified
-    const auto signal_r = &QSslSocket::readyRead;
-    const auto slot_r   = &Server::processReadyRead;
-    QObject::connect(client_tls, signal_r, this, slot_r);
+    // connect the disconnected signal
+    connect(client_tls, signal_d, this, slot_d);
 
-    // convert to QPair<QHostAddress, quint16>
-    auto client_info = QPair<QHostAddress, quint16>(peerAddress, peerPort);
+    // Peer info
+    const auto peerAddress = client_tls->peerAddress();
+    const auto peerPort    = client_tls->peerPort();
 
-    // Notify the listeners that the client is connected
-    emit OnCLientStateChanged(client_info, true);
+    // the result may arrive after this server or the
+    // client is destroyed so guard both of them
+    const auto server      = QPointer<Server>(this);
+    const auto client      = QPointer<QSslSocket>(client_tls);
 
-    // Add the client to the list of clients
-    m_clients.append(client_tls);
+    // callback that receives the result
+    const auto result      = [server, client](bool accepted) {
+      if (server && client) server->processAuthentication(client, accepted);
+    };
 
-    // Notify the listeners that the client list is changed
-    emit OnClientListChanged(getConnectedClientsList());
+    // Authenticate the client
+    m_authenticator({peerAddress, peerPort}, result);
   }
 }
 
@@ -138,10 +758,69 @@ void Server::processDisconnection() {
   // Remove the client from the list of clients
   m_clients.removeOne(client);
 
+  // drop the packets waiting for the client
+  m_waiting.removeIf([client](const Waiting &waiting) { return waiting.client == client; });
+
+  // forget the version and the features of the client
+  m_peers.remove(client);
+
+  // release the bases of the client
+  auto bases = m_bases.take(client);
+  utility::functions::releaseBases(bases, *m_blobs);
+
+  // release the client
+  client->deleteLater();
+
   // Notify the listeners that the client list is changed
   emit OnClientListChanged(getConnectedClientsList());
 }
 
+/**
+ * @brief Mark the start of the TLS handshake of the client
+ * to measure the handshake time
+ *
+ * @param client Client that started the handshake
+ */
+void Server::processHandshakeStarted(QSslSocket *client) {
+  client->setProperty("handshakeStart", QDeadlineTimer::current().deadlineNSecs());
+}
+
+/**
+ * @brief Update the queue depth gauges of the server, it is
+ * called by the metrics registry before the export
+ */
+void Server::collectMetrics() {
+  // registry of the metrics
+  auto &registry = metrics::Registry::instance();
+
+  // clients waiting for the authenticator and connected
+  registry.gauge("clipbird_pending_clients").set(m_pending.size());
+  registry.gauge("clipbird_connected_clients").set(m_clients.size());
+
+  // bytes waiting to be written to each peer, the peers
+  // that have gone since the last export are reset to 0
+  QHash<QString, qint64> backlog;
+
+  // reset the gone peers
+  for (const auto &peer : std::as_const(m_backlogPeers)) backlog.insert(peer, 0);
+
+  // sum the clients of the same peer
+  for (auto client : m_clients) {
+    const auto pending = m_peers.value(client).scheduler->getPendingBytes();
+    backlog[client->peerAddress().toString()] += client->bytesToWrite() + pending;
+  }
+
+  // set the gauges
+  for (auto it = backlog.cbegin(); it != backlog.cend(); ++it) {
+    const auto labels = metrics::Labels{{"peer", it.key()}};
+    registry.gauge("clipbird_backlog_bytes", labels).set(it.value());
+  }
+
+  // remember the peers of this export
+  m_backlogPeers.clear();
+  for (auto client : m_clients) m_backlogPeers.insert(client->peerAddress().toString());
+}
+
 /**
  * @brief Construct a new Syncing Server object and
  * bind to any available port and any available
@@ -162,6 +841,26 @@ Server::Server(QObject *p) : discovery::Server(p) {
   const auto signal_e = &discovery::Server::OnErrorOccurred;
   const auto slot_e   = &Server::OnErrorOccurred;
   QObject::connect(this, signal_e, this, slot_e);
+
+  // mark the start of the handshake to measure it
+  const auto signal_h = &QSslServer::startedEncryptionHandshake;
+  const auto slot_h   = &Server::processHandshakeStarted;
+  QObject::connect(m_ssl_server, signal_h, this, slot_h);
+
+  // connect the relays again if the link drops
+  const auto signal_t = &QTimer::timeout;
+  const auto slot_t   = &Server::connectRelays;
+  QObject::connect(m_relayTimer, signal_t, this, slot_t);
+
+  // sample the queue depths on export
+  m_collector = metrics::Registry::instance().addCollector([this] { collectMetrics(); });
+}
+
+/**
+ * @brief Destroy the Syncing Server object
+ */
+Server::~Server() {
+  metrics::Registry::instance().removeCollector(m_collector);
 }
 
 /**
@@ -170,8 +869,18 @@ Server::Server(QObject *p) : discovery::Server(p) {
  * @param data QVector<QPair<QString, QByteArray>>
  */
 void Server::syncItems(QVector<QPair<QString, QByteArray>> items) {
-  const auto packType = packets::SyncingPacket::PacketType::SyncPacket;
-  this->sendPacket(utility::functions::createPacket(packType, items));
+  // correlate with the capture if any else a new id
+  auto syncId = tracing::currentSyncId();
+  if (syncId == 0) syncId = QRandomGenerator::global()->generate64();
+
+  // correlate the spans of the send
+  tracing::SyncScope scope(syncId);
+
+  // the sync that came in is already forwarded
+  if (!this->markSeen(syncId)) return;
+
+  // the sync starts at this node with a new generation
+  this->sendItems(items, syncId, m_nodeId, 0, m_generation.next(m_nodeId));
 }
 
 /**
@@ -187,6 +896,22 @@ QList<QPair<QHostAddress, quint16>> Server::getConnectedClientsList() const {
   return list;
 }
 
+/**
+ * @brief Get the bytes that are waiting to be written to
+ * each of the connected clients in the same order as the
+ * getConnectedClientsList, it is the queue depth of the
+ * clients that can't keep up with the broadcasts
+ *
+ * @return QList<qint64> bytes per client
+ */
+QList<qint64> Server::getClientsBacklog() const {
+  QList<qint64> list;
+  for (auto client : m_clients) {
+    list.append(client->bytesToWrite() + m_peers.value(client).scheduler->getPendingBytes());
+  }
+  return list;
+}
+
 /**
  * @brief Disconnect the client from the server and delete
  * the client
@@ -224,6 +949,11 @@ QPair<QHostAddress, quint16> Server::getServerInfo() const {
  * @param config SSL Configuration
  */
 void Server::setSSLConfiguration(QSslConfiguration config) {
+  // ask the client for its certificate so pinned
+  // clients can be recognised by the fingerprint
+  config.setPeerVerifyMode(QSslSocket::QueryPeer);
+
+  // set the configuration
   m_ssl_server->setSslConfiguration(config);
 }
 
@@ -254,6 +984,165 @@ Server::Authenticator Server::getAuthenticator() const {
   return m_authenticator;
 }
 
+/**
+ * @brief Set the Trust Store, the clients pinned in the store
+ * are accepted without asking the authenticator and approved
+ * clients are pinned to it
+ *
+ * @param store Trust store
+ */
+void Server::setTrustStore(storage::TrustStore *store) {
+  m_trustStore = store;
+}
+
+/**
+ * @brief Get the Trust Store object
+ *
+ * @return storage::TrustStore*
+ */
+storage::TrustStore *Server::getTrustStore() const {
+  return m_trustStore;
+}
+
+/**
+ * @brief Set the Blob Store, the payloads in the store are not
+ * asked from the clients and the large payloads are offered by
+ * the hash through it
+ *
+ * @param store Blob store
+ */
+void Server::setBlobStore(storage::BlobStore *store) {
+  m_blobs = store != nullptr ? store : &m_ownBlobs;
+}
+
+/**
+ * @brief Get the Blob Store object
+ *
+ * @return storage::BlobStore*
+ */
+storage::BlobStore *Server::getBlobStore() const {
+  return m_blobs;
+}
+
+/**
+ * @brief Set the Capacity, the clients over it are rejected and
+ * it is advertised with the client count so the clients can
+ * pick a lightly loaded server
+ *
+ * @param capacity maximum number of clients
+ */
+void Server::setCapacity(quint32 capacity) {
+  m_capacity = capacity;
+}
+
+/**
+ * @brief Add a relay to the other server, this server joins it
+ * as a client with the SSL configuration, the authenticator and
+ * the stores of this server so the syncs of the clients of both
+ * servers reach each other, the relay is connected again if the
+ * link drops
+ *
+ * @param peer host and port of the other server
+ * @throw std::runtime_error if the SSL Configuration is not set
+ */
+void Server::addRelay(QPair<QHostAddress, quint16> peer) {
+  // check if the SSL configuration is set
+  if (m_ssl_server->sslConfiguration().isNull()) {
+    throw std::runtime_error("SSL Configuration is not set");
+  }
+
+  // if already relayed then ignore
+  for (const auto &relay : std::as_const(m_relays)) {
+    if (relay.peer == peer) return;
+  }
+
+  // the other server is joined as a client
+  auto client = new Client(this);
+
+  // same identity and stores as this server
+  client->setSSLConfiguration(m_ssl_server->sslConfiguration());
+  client->setAuthenticator(m_authenticator);
+  client->setTrustStore(m_trustStore);
+  client->setBlobStore(m_blobs);
+
+  // the syncs of this server that come back are dropped
+  client->setNodeId(m_nodeId);
+
+  // forward the syncs of the other server
+  const auto signal_s = &Client::OnSyncRelay;
+  const auto slot_s   = [this, client](
+      QVector<QPair<QString, QByteArray>> items,
+      quint64 syncId,
+      quint64 originId,
+      quint8 hopCount,
+      quint64 generation
+  ) { this->processRelayItems(items, syncId, originId, hopCount, generation, client); };
+  QObject::connect(client, signal_s, this, slot_s);
+
+  // connect OnErrorOccurred of the relay
+  const auto signal_e = &Client::OnErrorOccurred;
+  const auto slot_e   = &Server::OnErrorOccurred;
+  QObject::connect(client, signal_e, this, slot_e);
+
+  // add the relay
+  m_relays.append({peer, client});
+
+  // connect to the other server
+  client->connectToServer(peer);
+
+  // keep the relays connected
+  if (!m_relayTimer->isActive()) m_relayTimer->start(m_relayRetry);
+}
+
+/**
+ * @brief Remove the relay to the other server
+ *
+ * @param peer host and port of the other server
+ */
+void Server::removeRelay(QPair<QHostAddress, quint16> peer) {
+  // is the relay to the peer
+  const auto isPeer = [&](const Relay &relay) { return relay.peer == peer; };
+
+  // find the relay
+  const auto it = std::find_if(m_relays.begin(), m_relays.end(), isPeer);
+
+  // if not relayed then ignore
+  if (it == m_relays.end()) return;
+
+  // release the relay
+  it->client->disconnectFromServer();
+  it->client->deleteLater();
+
+  // remove the relay
+  m_relays.erase(it);
+
+  // no relay to keep connected
+  if (m_relays.isEmpty()) m_relayTimer->stop();
+}
+
+/**
+ * @brief Get the other servers that this server relays to
+ *
+ * @return QList<QPair<QHostAddress, quint16>> List of servers
+ */
+QList<QPair<QHostAddress, quint16>> Server::getRelays() const {
+  QList<QPair<QHostAddress, quint16>> list;
+  for (const auto &relay : m_relays) {
+    list.append(relay.peer);
+  }
+  return list;
+}
+
+/**
+ * @brief Get the Node Id object, it is the origin of the syncs
+ * that start at this server
+ *
+ * @return quint64
+ */
+quint64 Server::getNodeId() const {
+  return m_nodeId;
+}
+
 /**
  * @brief Start the server
  */
@@ -333,4 +1222,32 @@ quint16 Server::getPort() const {
 QHostAddress Server::getIPAddress() const {
   return m_ssl_server->serverAddress();
 }
+
+/**
+ * @brief Get the number of the clients connected to the server
+ *
+ * @return quint32 number of the clients
+ */
+quint32 Server::getClientCount() const {
+  return m_clients.size();
+}
+
+/**
+ * @brief Get the number of the clients the server accepts
+ *
+ * @return quint32 number of the clients
+ */
+quint32 Server::getCapacity() const {
+  return m_capacity;
+}
+
+/**
+ * @brief Get the encodings of the syncing items the server
+ * supports, bit n is set if the encoding n is supported
+ *
+ * @return quint32 bits of the encodings
+ */
+quint32 Server::getCodecs() const {
+  return utility::functions::supportedCodecs;
+}
 }  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
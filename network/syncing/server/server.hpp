@@ -6,19 +6,38 @@
 // https://opensource.org/licenses/MIT
 
 #include <QByteArray>
+#include <QCryptographicHash>
+#include <QHash>
+#include <QDeadlineTimer>
 #include <QList>
 #include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QRandomGenerator>
+#include <QSet>
 #include <QSslConfiguration>
 #include <QSslServer>
 #include <QSslSocket>
+#include <QTimer>
 #include <QVector>
 
+#include "constants/constants.hpp"
 #include "network/discovery/server/server.hpp"
+#include "network/syncing/client/client.hpp"
+#include "network/syncing/generation/generation.hpp"
+#include "network/syncing/scheduler/scheduler.hpp"
+#include "storage/blobstore/blobstore.hpp"
+#include "storage/truststore/truststore.hpp"
 #include "types/callback/callback.hpp"
 #include "types/enums/enums.hpp"
+#include "utility/functions/blobs/blobs.hpp"
+#include "utility/functions/filter/filter.hpp"
 #include "utility/functions/ipconv/ipconv.hpp"
 #include "utility/functions/nbytes/nbytes.hpp"
 #include "utility/functions/packet/packet.hpp"
+#include "utility/logging/logging.hpp"
+#include "utility/metrics/metrics.hpp"
+#include "utility/tracing/tracing.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::network::syncing {
 /**
@@ -43,8 +62,9 @@ class Server : public discovery::Server {
   void OnClientListChanged(QList<QPair<QHostAddress, quint16>> clients);
 
  signals:  // signals
-  /// @brief On Sync Request
-  void OnSyncRequest(QVector<QPair<QString, QByteArray>> items);
+  /// @brief On Sync Request with the address of the peer it came from
+  void OnSyncRequest(QVector<QPair<QString, QByteArray>> items, QString origin);
+
 
  private:  // just for Qt
 
@@ -73,21 +93,198 @@ class Server : public discovery::Server {
   /// @brief Authenticator
   Authenticator m_authenticator = nullptr;
 
+  /// @brief Clients that are waiting for the authenticator
+  QList<QSslSocket*> m_pending;
+
+  /// @brief Store of the pinned peers
+  storage::TrustStore* m_trustStore = nullptr;
+
+  /// @brief Maximum number of clients waiting for the authenticator
+  const qsizetype m_maxPending = 16;
+
+  /// @brief Maximum number of clients that are accepted
+  quint32 m_capacity           = 1024;
+
+  /// @brief Time in milliseconds the authenticator has to answer
+  const int m_authTimeout      = 30000;
+
+  /// @brief Id of the metrics collector of the queue depths
+  int m_collector              = -1;
+
+  /// @brief Peers that had the backlog reported on last export
+  QSet<QString> m_backlogPeers;
+
+ private:  // Blobs of the syncing
+
+  /**
+   * @brief Syncing packet that waits for the payloads it references
+   */
+  struct Waiting {
+    QSslSocket* client;
+    packets::SyncingPacket packet;
+  };
+
+  /// @brief Store used if none is set
+  storage::BlobStore m_ownBlobs;
+
+  /// @brief Store of the payloads
+  storage::BlobStore* m_blobs = &m_ownBlobs;
+
+  /// @brief Packets waiting for the payloads from the oldest
+  QList<Waiting> m_waiting;
+
+  /// @brief Hash of the last text each client has by the mime type
+  QHash<QSslSocket*, QHash<QString, QByteArray>> m_bases;
+
+  /// @brief Maximum number of packets waiting for the payloads
+  const qsizetype m_maxWaiting = 16;
+
+ private:  // Negotiation with the clients
+
+  /**
+   * @brief Sync that is sent to the clients
+   */
+  struct Sync {
+    QVector<QPair<QString, QByteArray>> items;
+    quint64 syncId     = 0;
+    quint64 originId   = 0;
+    quint8 hopCount    = 0;
+    quint64 generation = 0;
+  };
+
+  /**
+   * @brief Version and features the client and this server agreed
+   * on by the hello, the version is 0 till the client sends the
+   * hello so its packets are read as the version 1 and the latest
+   * sync is held for it, the filter of the client accepts all till
+   * the client sends one, the scheduler orders the writes
+   */
+  struct Peer {
+    quint16 version      = 0;
+    quint32 features     = packets::HelloPacket::Feature::InlineItems;
+    packets::FilterPacket filter;
+    Scheduler* scheduler = nullptr;
+    Sync held;
+    metrics::Traffic in;
+    metrics::Traffic out;
+  };
+
+  /// @brief Agreed version, features, filter, scheduler and traffic by the client
+  QHash<QSslSocket*, Peer> m_peers;
+
+ private:  // Federation of the servers
+
+  /**
+   * @brief Link to an other server that this server joins as a
+   * client so the syncs are forwarded between their clients
+   */
+  struct Relay {
+    QPair<QHostAddress, quint16> peer;
+    Client* client;
+  };
+
+  /// @brief Id of this node in the syncs it starts
+  quint64 m_nodeId          = QRandomGenerator::global()->generate64();
+
+  /// @brief Clock of the generations of the copies
+  Generation m_generation;
+
+  /// @brief Links to the other servers
+  QList<Relay> m_relays;
+
+  /// @brief Timer to connect the relays that are not connected
+  QTimer* m_relayTimer      = new QTimer(this);
+
+  /// @brief Ids of the recent syncs
+  QSet<quint64> m_seen;
+
+  /// @brief Ids of the recent syncs from the oldest
+  QQueue<quint64> m_seenOrder;
+
+  /// @brief Maximum number of the recent syncs
+  const qsizetype m_maxSeen = 1024;
+
+  /// @brief Maximum number of relays a sync is forwarded through
+  const quint8 m_maxHops    = 8;
+
+  /// @brief Time in milliseconds between the connects of a relay
+  const int m_relayRetry    = 5000;
+
  private:  // some typedefs
 
   using MalformedPacket = types::except::MalformedPacket;
 
  private:  // member functions
 
+  /**
+   * @brief Write the encoded packet to the client through its
+   * scheduler so the large packets don't hold the small ones
+   *
+   * @param client Client to write
+   * @param data encoded packet
+   * @param syncId id of the sync the packet is part of if any
+   */
+  void writeData(QAbstractSocket* client, const QByteArray& data, quint64 syncId);
+
+  /**
+   * @brief Encode the packet with the encoder of the client so its
+   * frame is reused, the client that is not accepted has none
+   *
+   * @param client Client to send
+   * @param packet Packet to encode
+   * @return QByteArray encoded packet
+   */
+  template <typename Packet>
+  QByteArray encodeFor(QAbstractSocket* client, const Packet& pack) {
+    // find the scheduler of the client
+    const auto it = m_peers.constFind(qobject_cast<QSslSocket*>(client));
+
+    // the client that is not accepted has none
+    if (it == m_peers.constEnd() || it->scheduler == nullptr) {
+      return utility::functions::toQByteArray(pack);
+    } else {
+      return it->scheduler->getEncoder().encode(pack);
+    }
+  }
+
   /**
    * @brief Create the packet and send it to the client
    *
    * @param client Client to send
    * @param packet Packet to send
+   * @param syncId id of the sync the packet is part of if any
    */
   template <typename Client, typename Packet>
-  void sendPacket(Client* client, const Packet& pack) {
-    client->write(utility::functions::toQByteArray(pack));
+  void sendPacket(Client* client, const Packet& pack, quint64 syncId = 0) {
+    // time to encode the packets
+    static auto& encodeTime = metrics::Registry::instance().histogram("clipbird_encode_ns");
+
+    // encode the packet
+    const auto data = metrics::measure(encodeTime, [&] {
+      CLIPBIRD_TRACE_SPAN("encode");
+      return this->encodeFor(client, pack);
+    });
+
+    // write to the client
+    {
+      CLIPBIRD_TRACE_SPAN("write");
+      this->writeData(client, data, syncId);
+    }
+
+    // record the traffic, the client that is not accepted is rare
+    if (const auto peer = m_peers.constFind(client); peer != m_peers.constEnd()) {
+      peer->out.record(data.size());
+    } else {
+      metrics::Traffic("out", client->peerAddress().toString()).record(data.size());
+    }
+
+    // log the packet, only formatted if the category is enabled
+    qCDebug(logging::lcNetwork).noquote() << logging::withFields("packet sent", {
+      {"peer", client->peerAddress().toString()},
+      {"type", pack.getPacketType()},
+      {"bytes", data.size()},
+      {"backlog", client->bytesToWrite()},
+    });
   }
 
   /**
@@ -103,12 +300,146 @@ class Server : public discovery::Server {
     }
   }
 
+  /**
+   * @brief Check the sync is new to this server, the sync that
+   * came back to this node, was seen recently or went through
+   * too many relays is dropped
+   *
+   * @param syncId id of the sync
+   * @param originId id of the node the sync started at
+   * @param hopCount number of relays the sync went through
+   *
+   * @return true if the sync is to be processed
+   */
+  bool acceptSync(quint64 syncId, quint64 originId, quint8 hopCount);
+
+  /**
+   * @brief Remember the sync so it is dropped if it comes again
+   *
+   * @param syncId id of the sync
+   * @return true if the sync was not seen recently
+   */
+  bool markSeen(quint64 syncId);
+
   /**
    * @brief Process the SyncingPacket from the client
    *
    * @param packet SyncingPacket
+   * @param client client the packet came from
+   */
+  void processSyncingPacket(const packets::SyncingPacket& packet, QSslSocket* client);
+
+  /**
+   * @brief Process the items of the syncing packet that has all
+   * of its payloads, notify and forward them to the clients
+   *
+   * @param items mime type and payload
+   * @param packet packet the items came in
+   * @param client client the items came from
+   */
+  void processSyncingItems(
+      const QVector<QPair<QString, QByteArray>>& items,
+      const packets::SyncingPacket& packet,
+      QSslSocket* client
+  );
+
+  /**
+   * @brief Process the items that came from an other server
+   * through the relay, notify and forward them to the clients
+   *
+   * @param items mime type and payload
+   * @param syncId id of the sync
+   * @param originId id of the node the sync started at
+   * @param hopCount number of relays the sync went through
+   * @param generation generation of the copy
+   * @param relay relay the items came from
+   */
+  void processRelayItems(
+      const QVector<QPair<QString, QByteArray>>& items,
+      quint64 syncId,
+      quint64 originId,
+      quint8 hopCount,
+      quint64 generation,
+      Client* relay
+  );
+
+  /**
+   * @brief Connect the relays that are not connected
+   */
+  void connectRelays();
+
+  /**
+   * @brief Send the items to all the clients and the relays but
+   * the one they came from, the large text is sent as a delta
+   * against the last text each client has, each client gets only
+   * the items its filter accepts
+   *
+   * @param items mime type and payload
+   * @param syncId id of the sync
+   * @param originId id of the node the sync started at
+   * @param hopCount number of relays the sync went through
+   * @param generation generation of the copy
+   * @param from client or relay the items came from if any
+   */
+  void sendItems(
+      const QVector<QPair<QString, QByteArray>>& items,
+      quint64 syncId,
+      quint64 originId,
+      quint8 hopCount,
+      quint64 generation,
+      const QObject* from = nullptr
+  );
+
+  /**
+   * @brief Send the sync to the client in the version it agreed on,
+   * the client that has not said hello yet gets the latest sync
+   * once it does since the version it reads is not known till then
+   *
+   * @param client client to send
+   * @param sync sync to send
+   * @param packets packets shared by the clients of a sync
    */
-  void processSyncingPacket(const packets::SyncingPacket& packet);
+  void sendItemsTo(
+      QSslSocket* client, const Sync& sync, QHash<QByteArray, packets::SyncingPacket>& packets
+  );
+
+  /**
+   * @brief Process the BlobPacket from the client, the wanted
+   * payloads are sent and the sent payloads resume the waiting
+   * syncing packet
+   *
+   * @param packet BlobPacket
+   * @param client client the packet came from
+   */
+  void processBlobPacket(const packets::BlobPacket& packet, QSslSocket* client);
+
+  /**
+   * @brief Process the HelloPacket from the client, the client is
+   * disconnected if the versions don't overlap else the lower
+   * version and the common features are used with it
+   *
+   * @param packet HelloPacket
+   * @param client client the packet came from
+   */
+  void processHelloPacket(const packets::HelloPacket& packet, QSslSocket* client);
+
+  /**
+   * @brief Process the FilterPacket from the client, the items the
+   * filter doesn't accept are not sent to the client from now
+   *
+   * @param packet FilterPacket
+   * @param client client the packet came from
+   */
+  void processFilterPacket(const packets::FilterPacket& packet, QSslSocket* client);
+
+  /**
+   * @brief Process the packet from the client by its type, the
+   * chunks are joined and the whole packet is processed
+   *
+   * @param data packet
+   * @param client client the packet came from
+   */
+  void processPacket(const QByteArray& data, QSslSocket* client);
 
   /**
    * @brief Callback function that process the ready
@@ -117,14 +448,63 @@ class Server : public discovery::Server {
   void processReadyRead();
 
   /**
-   * @brief Process the connections that are pending
+   * @brief Get the certificate fingerprint of the client
+   *
+   * @param client Client
+   * @return QByteArray SHA-256 fingerprint or empty
+   */
+  QByteArray getFingerprint(QSslSocket* client) const;
+
+  /**
+   * @brief Accept the client and start syncing with it
+   *
+   * @param client Client to accept
+   */
+  void acceptClient(QSslSocket* client);
+
+  /**
+   * @brief Reject the client and release it
+   *
+   * @param client Client to reject
+   */
+  void rejectClient(QSslSocket* client);
+
+  /**
+   * @brief Process the result of the authenticator for the
+   * pending client, if the client is no longer pending (e.g.
+   * timed out or disconnected) the result is ignored
+   *
+   * @param client Pending client
+   * @param accepted Result of the authenticator
+   */
+  void processAuthentication(QSslSocket* client, bool accepted);
+
+  /**
+   * @brief Process the connections that are pending, clients
+   * that are pinned in the trust store are accepted immediately
+   * others are parked until the authenticator answers
    */
   void processConnections();
+
   /**
    * @brief Process the disconnection from the client
    */
   void processDisconnection();
 
+  /**
+   * @brief Mark the start of the TLS handshake of the client
+   * to measure the handshake time
+   *
+   * @param client Client that started the handshake
+   */
+  void processHandshakeStarted(QSslSocket* client);
+
+  /**
+   * @brief Update the queue depth gauges of the server, it is
+   * called by the metrics registry before the export
+   */
+  void collectMetrics();
+
  public:  // constructors and destructors
 
   /**
@@ -140,7 +520,7 @@ class Server : public discovery::Server {
   /**
    * @brief Destroy the Syncing Server object
    */
-  virtual ~Server() = default;
+  virtual ~Server();
 
   /**
    * @brief Request the clients to sync the clipboard items
@@ -156,6 +536,16 @@ class Server : public discovery::Server {
    */
   QList<QPair<QHostAddress, quint16>> getConnectedClientsList() const;
 
+  /**
+   * @brief Get the bytes that are waiting to be written to
+   * each of the connected clients in the same order as the
+   * getConnectedClientsList, it is the queue depth of the
+   * clients that can't keep up with the broadcasts
+   *
+   * @return QList<qint64> bytes per client
+   */
+  QList<qint64> getClientsBacklog() const;
+
   /**
    * @brief Disconnect the client from the server and delete
    * the client
@@ -203,6 +593,81 @@ class Server : public discovery::Server {
    */
   Authenticator getAuthenticator() const;
 
+  /**
+   * @brief Set the Trust Store, the clients pinned in the store
+   * are accepted without asking the authenticator and approved
+   * clients are pinned to it
+   *
+   * @param store Trust store
+   */
+  void setTrustStore(storage::TrustStore* store);
+
+  /**
+   * @brief Get the Trust Store object
+   *
+   * @return storage::TrustStore*
+   */
+  storage::TrustStore* getTrustStore() const;
+
+  /**
+   * @brief Set the Blob Store, the payloads in the store are not
+   * asked from the clients and the large payloads are offered by
+   * the hash through it
+   *
+   * @param store Blob store
+   */
+  void setBlobStore(storage::BlobStore* store);
+
+  /**
+   * @brief Get the Blob Store object
+   *
+   * @return storage::BlobStore*
+   */
+  storage::BlobStore* getBlobStore() const;
+
+  /**
+   * @brief Set the Capacity, the clients over it are rejected and
+   * it is advertised with the client count so the clients can
+   * pick a lightly loaded server
+   *
+   * @param capacity maximum number of clients
+   */
+  void setCapacity(quint32 capacity);
+
+  /**
+   * @brief Add a relay to the other server, this server joins it
+   * as a client with the SSL configuration, the authenticator and
+   * the stores of this server so the syncs of the clients of both
+   * servers reach each other, the relay is connected again if the
+   * link drops
+   *
+   * @param peer host and port of the other server
+   * @throw std::runtime_error if the SSL Configuration is not set
+   */
+  void addRelay(QPair<QHostAddress, quint16> peer);
+
+  /**
+   * @brief Remove the relay to the other server
+   *
+   * @param peer host and port of the other server
+   */
+  void removeRelay(QPair<QHostAddress, quint16> peer);
+
+  /**
+   * @brief Get the other servers that this server relays to
+   *
+   * @return QList<QPair<QHostAddress, quint16>> List of servers
+   */
+  QList<QPair<QHostAddress, quint16>> getRelays() const;
+
+  /**
+   * @brief Get the Node Id object, it is the origin of the syncs
+   * that start at this server
+   *
+   * @return quint64
+   */
+  quint64 getNodeId() const;
+
   /**
    * @brief Start the server
    */
@@ -248,5 +713,27 @@ class Server : public discovery::Server {
    * @throw Any Exception If any error occurs
    */
   virtual QHostAddress getIPAddress() const override;
+
+  /**
+   * @brief Get the number of the clients connected to the server
+   *
+   * @return quint32 number of the clients
+   */
+  virtual quint32 getClientCount() const override;
+
+  /**
+   * @brief Get the number of the clients the server accepts
+   *
+   * @return quint32 number of the clients
+   */
+  virtual quint32 getCapacity() const override;
+
+  /**
+   * @brief Get the encodings of the syncing items the server
+   * supports, bit n is set if the encoding n is supported
+   *
+   * @return quint32 bits of the encodings
+   */
+  virtual quint32 getCodecs() const override;
 };
 }  // namespace srilakshmikanthanp::clipbirdesk::network::syncing
@@ -0,0 +1,165 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "blobstore.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Hash of the payload
+ *
+ * @param payload payload
+ * @return QByteArray SHA-256 of the payload
+ */
+QByteArray BlobStore::hashOf(const QByteArray& payload) {
+  return QCryptographicHash::hash(payload, QCryptographicHash::Sha256);
+}
+
+/**
+ * @brief Set the History to look up the payloads that are not
+ * in memory
+ *
+ * @param history History or nullptr
+ */
+void BlobStore::setHistory(const History* history) {
+  m_history = history;
+}
+
+/**
+ * @brief Get the History object
+ *
+ * @return const History*
+ */
+const History* BlobStore::getHistory() const {
+  return m_history;
+}
+
+/**
+ * @brief Put the payload and take a reference to it, the payload
+ * is shared with the caller so it is not copied
+ *
+ * @param payload payload
+ * @return QByteArray hash of the payload
+ */
+QByteArray BlobStore::put(const QByteArray& payload) {
+  // hash of the payload
+  const auto hash = hashOf(payload);
+
+  // add the payload or take a reference
+  if (auto it = m_blobs.find(hash); it != m_blobs.end()) {
+    it->refs += 1;
+  } else {
+    m_blobs.insert(hash, {payload, 1});
+  }
+
+  // return the hash
+  return hash;
+}
+
+/**
+ * @brief Take one more reference to the payload in memory
+ *
+ * @param hash hash of the payload
+ * @return true if the payload is in memory
+ */
+bool BlobStore::retain(const QByteArray& hash) {
+  // payload of the hash
+  const auto it = m_blobs.find(hash);
+
+  // if not in memory
+  if (it == m_blobs.end()) return false;
+
+  // take the reference
+  it->refs += 1;
+
+  // retained
+  return true;
+}
+
+/**
+ * @brief Release a reference to the payload, it is dropped from
+ * the memory on the last one
+ *
+ * @param hash hash of the payload
+ */
+void BlobStore::release(const QByteArray& hash) {
+  // payload of the hash
+  const auto it = m_blobs.find(hash);
+
+  // if not in memory
+  if (it == m_blobs.end()) return;
+
+  // drop on the last reference
+  if (--it->refs == 0) m_blobs.erase(it);
+}
+
+/**
+ * @brief Put the payload that is offered to the peers by the hash,
+ * the reference is released after the next offers so the peers
+ * have time to ask for it
+ *
+ * @param payload payload
+ * @return QByteArray hash of the payload
+ */
+QByteArray BlobStore::offer(const QByteArray& payload) {
+  // put the payload
+  const auto hash = this->put(payload);
+
+  // remember the offer
+  m_offered.enqueue(hash);
+
+  // release the oldest offers
+  while (m_offered.size() > maxOffered) this->release(m_offered.dequeue());
+
+  // return the hash
+  return hash;
+}
+
+/**
+ * @brief Is the payload in memory or in the history
+ *
+ * @param hash hash of the payload
+ */
+bool BlobStore::has(const QByteArray& hash) const {
+  return m_blobs.contains(hash) || (m_history != nullptr && m_history->has(hash));
+}
+
+/**
+ * @brief Get the payload from the memory or the history
+ *
+ * @param hash hash of the payload
+ * @throw std::out_of_range if not in the store
+ */
+QByteArray BlobStore::get(const QByteArray& hash) const {
+  // from the memory
+  if (const auto it = m_blobs.constFind(hash); it != m_blobs.constEnd()) {
+    return it->payload;
+  }
+
+  // from the history
+  if (m_history != nullptr && m_history->has(hash)) {
+    return m_history->find(hash);
+  }
+
+  // not in the store
+  throw std::out_of_range("Payload is not in the store");
+}
+
+/**
+ * @brief Get the references to the payload in memory
+ *
+ * @param hash hash of the payload
+ */
+qsizetype BlobStore::getRefCount(const QByteArray& hash) const {
+  const auto it = m_blobs.constFind(hash);
+  return it == m_blobs.constEnd() ? 0 : it->refs;
+}
+
+/**
+ * @brief Get the count of the payloads in memory
+ */
+qsizetype BlobStore::size() const {
+  return m_blobs.size();
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
@@ -0,0 +1,142 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QHash>
+#include <QQueue>
+
+// C++ headers
+#include <stdexcept>
+
+// project headers
+#include "storage/history/history.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Content addressed store of the payloads keyed by their
+ * SHA-256, the payloads in memory are refcounted and dropped when
+ * the last reference is released, the payloads that are not in
+ * memory are looked up in the history so a payload that was ever
+ * copied or synced is not transferred again
+ */
+class BlobStore {
+ public:  // Constants
+
+  /// @brief Payloads that are offered to the peers and kept for their wants
+  static constexpr qsizetype maxOffered = 64;
+
+ private:  // Types
+
+  /**
+   * @brief Payload and its references
+   */
+  struct Blob {
+    QByteArray payload;
+    qsizetype refs;
+  };
+
+ private:  // Member variables
+
+  /// @brief Payloads in memory by the hash
+  QHash<QByteArray, Blob> m_blobs;
+
+  /// @brief Hashes of the offered payloads from the oldest
+  QQueue<QByteArray> m_offered;
+
+  /// @brief History to look up the payloads that are not in memory
+  const History* m_history = nullptr;
+
+ public:  // Member functions
+
+  /**
+   * @brief Hash of the payload
+   *
+   * @param payload payload
+   * @return QByteArray SHA-256 of the payload
+   */
+  static QByteArray hashOf(const QByteArray& payload);
+
+  /**
+   * @brief Set the History to look up the payloads that are not
+   * in memory
+   *
+   * @param history History or nullptr
+   */
+  void setHistory(const History* history);
+
+  /**
+   * @brief Get the History object
+   *
+   * @return const History*
+   */
+  const History* getHistory() const;
+
+  /**
+   * @brief Put the payload and take a reference to it, the payload
+   * is shared with the caller so it is not copied
+   *
+   * @param payload payload
+   * @return QByteArray hash of the payload
+   */
+  QByteArray put(const QByteArray& payload);
+
+  /**
+   * @brief Take one more reference to the payload in memory
+   *
+   * @param hash hash of the payload
+   * @return true if the payload is in memory
+   */
+  bool retain(const QByteArray& hash);
+
+  /**
+   * @brief Release a reference to the payload, it is dropped from
+   * the memory on the last one
+   *
+   * @param hash hash of the payload
+   */
+  void release(const QByteArray& hash);
+
+  /**
+   * @brief Put the payload that is offered to the peers by the hash,
+   * the reference is released after the next offers so the peers
+   * have time to ask for it
+   *
+   * @param payload payload
+   * @return QByteArray hash of the payload
+   */
+  QByteArray offer(const QByteArray& payload);
+
+  /**
+   * @brief Is the payload in memory or in the history
+   *
+   * @param hash hash of the payload
+   */
+  bool has(const QByteArray& hash) const;
+
+  /**
+   * @brief Get the payload from the memory or the history
+   *
+   * @param hash hash of the payload
+   * @throw std::out_of_range if not in the store
+   */
+  QByteArray get(const QByteArray& hash) const;
+
+  /**
+   * @brief Get the references to the payload in memory
+   *
+   * @param hash hash of the payload
+   */
+  qsizetype getRefCount(const QByteArray& hash) const;
+
+  /**
+   * @brief Get the count of the payloads in memory
+   */
+  qsizetype size() const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
@@ -0,0 +1,623 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "history.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/// @brief Magic number of the index file "CBHI"
+constexpr quint32 indexMagic = 0x43424849;
+
+/// @brief Version of the index file
+constexpr quint32 indexVersion = 2;
+
+/**
+ * @brief Overloaded operator<< for QDataStream
+ */
+QDataStream& operator<<(QDataStream& out, const History::Item& item) {
+  return out << item.mimeType << item.hash << item.offset << item.length;
+}
+
+/**
+ * @brief Overloaded operator>> for QDataStream
+ */
+QDataStream& operator>>(QDataStream& in, History::Item& item) {
+  return in >> item.mimeType >> item.hash >> item.offset >> item.length;
+}
+
+/**
+ * @brief Overloaded operator<< for QDataStream
+ */
+QDataStream& operator<<(QDataStream& out, const History::Entry& entry) {
+  return out << entry.time << entry.origin << entry.hash << entry.items;
+}
+
+/**
+ * @brief Overloaded operator>> for QDataStream
+ */
+QDataStream& operator>>(QDataStream& in, History::Entry& entry) {
+  return in >> entry.time >> entry.origin >> entry.hash >> entry.items;
+}
+
+/**
+ * @brief Get the path of the log file of the generation
+ */
+QString History::getLogFile(quint64 generation) const {
+  return QDir(m_dir).filePath(QString("log.%1").arg(generation));
+}
+
+/**
+ * @brief Write the header of the index
+ */
+void History::writeHeader(QDataStream& stream) const {
+  stream << indexMagic << indexVersion << m_generation;
+}
+
+/**
+ * @brief Hash of the items
+ */
+QByteArray History::hashOf(const QVector<QPair<QString, QByteArray>>& items) {
+  // hash of the content
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+
+  // the lengths keep the items apart
+  for (const auto& [mime, payload] : items) {
+    const auto mimeType = mime.toUtf8();
+    const auto lengths  = QString("%1:%2:").arg(mimeType.size()).arg(payload.size()).toLatin1();
+    hash.addData(lengths);
+    hash.addData(mimeType);
+    hash.addData(payload);
+  }
+
+  // return the hash
+  return hash.result();
+}
+
+/**
+ * @brief Read the payload of the item from the log, the lock
+ * must be held
+ */
+QByteArray History::readLocked(const Item& item, qint64 maxBytes) const {
+  // where the payload is now
+  const auto it = m_blobs.constFind(item.hash);
+
+  // check the hash
+  if (it == m_blobs.constEnd()) {
+    throw std::out_of_range("Payload is not in the history");
+  }
+
+  // bytes to read
+  const auto length = maxBytes < 0 ? it->length : std::min(it->length, maxBytes);
+
+  // nothing to map
+  if (length <= 0) return QByteArray();
+
+  // map the payload
+  const auto data = m_reader.map(it->offset, length);
+
+  // if can't map then throw
+  if (data == nullptr) {
+    throw std::runtime_error("Can't map the history log");
+  }
+
+  // copy the payload
+  QByteArray payload(reinterpret_cast<const char*>(data), length);
+
+  // unmap the payload
+  m_reader.unmap(data);
+
+  // return the payload
+  return payload;
+}
+
+/**
+ * @brief Write the items to the log and the index on the thread
+ */
+void History::write(const QVector<QPair<QString, QByteArray>>& items, const QString& origin) {
+  // if not open then can't add
+  if (!m_index.isOpen() || !m_log.isOpen()) {
+    throw std::runtime_error("History is not open");
+  }
+
+  // the entry larger than the log would be kept alone by every
+  // compaction and compact the log on every add after it
+  qint64 size = 0;
+  for (const auto& item : items) size += item.second.size();
+  if (size > m_maxBytes) return;
+
+  // hash of the content
+  const auto hash = hashOf(items);
+
+  // ignore if same as the newest, only this thread writes
+  if (!m_entries.isEmpty() && m_entries.last().hash == hash) {
+    return;
+  }
+
+  // create the entry
+  Entry entry{QDateTime::currentMSecsSinceEpoch(), origin, hash, {}};
+
+  // payloads that are new to the log
+  QList<Item> written;
+
+  // append to the end of the log
+  m_log.seek(m_log.size());
+
+  // share the payloads that are stored else append them
+  for (const auto& [mime, payload] : items) {
+    // hash of the payload
+    const auto blob = QCryptographicHash::hash(payload, QCryptographicHash::Sha256);
+
+    // if already stored then point to it
+    if (const auto it = m_blobs.constFind(blob); it != m_blobs.constEnd()) {
+      entry.items.append({mime, blob, it->offset, it->length});
+      continue;
+    }
+
+    // if written for this entry then point to it
+    const auto same = std::find_if(written.cbegin(), written.cend(), [&blob](const Item& item) {
+      return item.hash == blob;
+    });
+    if (same != written.cend()) {
+      entry.items.append({mime, blob, same->offset, same->length});
+      continue;
+    }
+
+    // write the payload
+    entry.items.append({mime, blob, m_log.pos(), payload.size()});
+    if (m_log.write(payload) != payload.size()) {
+      throw std::runtime_error("Can't write the history log");
+    }
+
+    // the payload is new
+    written.append(entry.items.last());
+  }
+
+  // the reader maps from the file
+  m_log.flush();
+
+  // append to the end of the index
+  m_index.seek(m_index.size());
+
+  // stream of the index
+  QDataStream stream(&m_index);
+  stream.setVersion(QDataStream::Qt_6_0);
+
+  // write the entry
+  stream << entry;
+  m_index.flush();
+
+  // check if written
+  if (stream.status() != QDataStream::Ok) {
+    throw std::runtime_error("Can't write the history index");
+  }
+
+  // add the entry and index the payloads
+  {
+    QMutexLocker locker(&m_lock);
+    m_entries.append(entry);
+    for (const auto& item : written) m_blobs.insert(item.hash, item);
+  }
+
+  // compact if over the limits
+  const auto isOld = entry.time - m_entries.first().time > m_maxAge;
+  if (m_log.size() > m_maxBytes || isOld) this->compactLog();
+
+  // notify the listeners
+  emit OnAdded(hash, items);
+}
+
+/**
+ * @brief Compact the log on the thread
+ */
+void History::compactLog() {
+  // current time
+  const auto now = QDateTime::currentMSecsSinceEpoch();
+
+  // keep the newest entries that are within the age and
+  // 3/4 of the size so the next compaction is not soon
+  QList<Entry> kept;
+  QSet<QPair<qint64, qint64>> counted;
+  qint64 bytes = 0;
+
+  // walk from the newest, only this thread writes the entries
+  for (auto it = m_entries.crbegin(); it != m_entries.crend(); ++it) {
+    // stop at the first old entry
+    if (now - it->time > m_maxAge) break;
+
+    // bytes that are not shared with the kept entries
+    qint64 extra = 0;
+    for (const auto& item : it->items) {
+      if (!counted.contains({item.offset, item.length})) extra += item.length;
+    }
+
+    // stop when over the size, the newest is always kept
+    if (!kept.isEmpty() && bytes + extra > m_maxBytes / 4 * 3) break;
+
+    // keep the entry
+    for (const auto& item : it->items) counted.insert({item.offset, item.length});
+    bytes += extra;
+    kept.prepend(*it);
+  }
+
+  // log of the next generation
+  const auto generation = m_generation + 1;
+  QFile log(this->getLogFile(generation));
+
+  // open the log to write
+  if (!log.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    throw std::runtime_error("Can't open the history log");
+  }
+
+  // new offsets of the copied content
+  QHash<QPair<qint64, qint64>, qint64> moved;
+
+  // copy the content of the kept entries
+  for (auto& entry : kept) {
+    for (auto& item : entry.items) {
+      // if already copied then point to it
+      const auto key = qMakePair(item.offset, item.length);
+      if (const auto it = moved.constFind(key); it != moved.constEnd()) {
+        item.offset = *it;
+        continue;
+      }
+
+      // offset in the new log
+      const auto offset = log.pos();
+
+      // copy the payload through the map
+      if (item.length > 0) {
+        const auto data = m_log.map(item.offset, item.length);
+        const auto size = data ? log.write(reinterpret_cast<const char*>(data), item.length) : -1;
+        if (data) m_log.unmap(data);
+        if (size != item.length) throw std::runtime_error("Can't write the history log");
+      }
+
+      // update the offset
+      moved.insert(key, offset);
+      item.offset = offset;
+    }
+  }
+
+  // close the new log
+  log.close();
+
+  // index of the next generation
+  QSaveFile index(m_index.fileName());
+
+  // open the index to write
+  if (!index.open(QIODevice::WriteOnly)) {
+    QFile::remove(log.fileName());
+    throw std::runtime_error("Can't open the history index");
+  }
+
+  // stream of the index
+  QDataStream stream(&index);
+  stream.setVersion(QDataStream::Qt_6_0);
+
+  // write the header and the entries
+  stream << indexMagic << indexVersion << generation;
+  for (const auto& entry : kept) stream << entry;
+
+  // the index is replaced atomically so a crash leaves either
+  // the old or the new generation, never a mix of them
+  m_index.close();
+  if (!index.commit()) {
+    QFile::remove(log.fileName());
+    m_index.open(QIODevice::ReadWrite);
+    throw std::runtime_error("Can't save the history index");
+  }
+
+  // switch the readers to the new generation
+  {
+    QMutexLocker locker(&m_lock);
+    m_entries = kept;
+    m_blobs.clear();
+    for (const auto& entry : m_entries) {
+      for (const auto& item : entry.items) m_blobs.insert(item.hash, item);
+    }
+    m_reader.close();
+    m_reader.setFileName(log.fileName());
+    m_reader.open(QIODevice::ReadOnly);
+  }
+
+  // switch to the new generation
+  m_log.close();
+  QFile::remove(m_log.fileName());
+  m_generation = generation;
+
+  // open the new files
+  m_log.setFileName(log.fileName());
+  m_log.open(QIODevice::ReadWrite);
+  m_index.open(QIODevice::ReadWrite);
+}
+
+/**
+ * @brief Construct a new History object, start the thread of
+ * the writer and load the index from the directory if it exists
+ *
+ * @param dir Directory that keeps the history
+ * @param parent parent object
+ */
+History::History(const QString& dir, QObject* parent)
+    : QObject(parent), m_dir(dir), m_worker(new QObject) {
+  // run the work on the thread
+  m_worker->moveToThread(&m_thread);
+
+  // the history never competes with the sync
+  m_thread.start(QThread::LowPriority);
+
+  // load the index
+  this->load();
+}
+
+/**
+ * @brief Destroy the History object after the queued work
+ */
+History::~History() {
+  // quit after the queued work
+  QMetaObject::invokeMethod(m_worker, [this] { m_thread.quit(); }, Qt::QueuedConnection);
+
+  // wait for the thread
+  m_thread.wait();
+
+  // delete the context
+  delete m_worker;
+}
+
+/**
+ * @brief Get the Default Directory of the history under app home
+ *
+ * @return QString path of the directory
+ */
+QString History::getDefaultDir() {
+  return QDir(QString::fromStdString(constants::getAppHome())).filePath("history");
+}
+
+/**
+ * @brief Load the index on the thread and wait for it, a torn
+ * record at the end is dropped along with the entries that point
+ * outside of the log
+ */
+void History::load() {
+  QMetaObject::invokeMethod(m_worker, [this] {
+    // entries and payloads that are loaded
+    QList<Entry> entries;
+    QHash<QByteArray, Item> blobs;
+
+    // close the files
+    m_index.close();
+    m_log.close();
+
+    // make sure the directory exists
+    QDir().mkpath(m_dir);
+
+    // open the index to read and append
+    m_index.setFileName(QDir(m_dir).filePath("index"));
+
+    // if can't open then nothing is loaded
+    if (m_index.open(QIODevice::ReadWrite)) {
+      // stream of the index
+      QDataStream stream(&m_index);
+      stream.setVersion(QDataStream::Qt_6_0);
+
+      // read the header
+      quint32 magic      = 0;
+      quint32 version    = 0;
+      quint64 generation = 0;
+      stream >> magic >> version >> generation;
+
+      // if not valid then start over
+      if (stream.status() != QDataStream::Ok || magic != indexMagic || version != indexVersion) {
+        m_generation = 0;
+        m_index.resize(0);
+        m_index.seek(0);
+        stream.resetStatus();
+        this->writeHeader(stream);
+        m_index.flush();
+      } else {
+        m_generation = generation;
+      }
+
+      // end of the last whole record
+      auto good = m_index.pos();
+
+      // read the entries
+      while (!stream.atEnd()) {
+        Entry entry;
+        stream >> entry;
+        if (stream.status() != QDataStream::Ok) break;
+        entries.append(entry);
+        good = m_index.pos();
+      }
+
+      // drop the torn record
+      if (good != m_index.size()) m_index.resize(good);
+
+      // open the log of the generation
+      m_log.setFileName(this->getLogFile(m_generation));
+
+      // if can't open then nothing is loaded
+      if (!m_log.open(QIODevice::ReadWrite)) entries.clear();
+    }
+
+    // drop the entries that point outside of the log
+    const auto size = m_log.isOpen() ? m_log.size() : 0;
+    entries.removeIf([size](const Entry& entry) {
+      return std::any_of(entry.items.begin(), entry.items.end(), [size](const Item& item) {
+        return item.offset < 0 || item.length < 0 || item.offset + item.length > size;
+      });
+    });
+
+    // index the stored payloads
+    for (const auto& entry : entries) {
+      for (const auto& item : entry.items) blobs.insert(item.hash, item);
+    }
+
+    // swap the entries and the reader
+    {
+      QMutexLocker locker(&m_lock);
+      m_entries = entries;
+      m_blobs   = blobs;
+      m_reader.close();
+      m_reader.setFileName(m_log.fileName());
+      if (m_log.isOpen()) m_reader.open(QIODevice::ReadOnly);
+    }
+
+    // nothing else to clean if not open
+    if (!m_log.isOpen()) return;
+
+    // remove the logs of the other generations left by a crash
+    const auto current = QFileInfo(m_log).fileName();
+    for (const auto& name : QDir(m_dir).entryList({"log.*"}, QDir::Files)) {
+      if (name != current) QDir(m_dir).remove(name);
+    }
+  }, Qt::BlockingQueuedConnection);
+}
+
+/**
+ * @brief Set the limits, the log is compacted when it goes
+ * over the size or its oldest entry is older than the age
+ *
+ * @param maxBytes maximum size of the log
+ * @param maxAge maximum age of the entries in milliseconds
+ */
+void History::setLimits(qint64 maxBytes, qint64 maxAge) {
+  QMetaObject::invokeMethod(m_worker, [this, maxBytes, maxAge] {
+    m_maxBytes = maxBytes;
+    m_maxAge   = maxAge;
+  }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Add the items to the history on the thread, the call
+ * returns at once, it is ignored if it is the same as the newest
+ * entry e.g. the item that was synced and came back as a
+ * clipboard change or if it is larger than the maximum size of
+ * the log, the payloads that are already in the log are not
+ * written again, OnAdded is emitted once it is written
+ *
+ * @param items mime type and payload
+ * @param origin peer the items came from
+ */
+void History::add(QVector<QPair<QString, QByteArray>> items, QString origin) {
+  QMetaObject::invokeMethod(m_worker, [this, items, origin] {
+    try {
+      this->write(items, origin);
+    } catch (const std::exception& e) {
+      emit OnErrorOccurred(e.what());
+    }
+  }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Wait till the queued work is done, must not be called
+ * from the thread of the writer
+ */
+void History::waitForIdle() {
+  QMetaObject::invokeMethod(m_worker, [] {}, Qt::BlockingQueuedConnection);
+}
+
+/**
+ * @brief Get the entries from the oldest to the newest, the
+ * entries don't have the payloads
+ */
+QList<History::Entry> History::getEntries() const {
+  QMutexLocker locker(&m_lock);
+  return m_entries;
+}
+
+/**
+ * @brief Read the payload of the item from the log, the item is
+ * found by its hash so it is read after a compaction too
+ *
+ * @param item item of the entry
+ * @param maxBytes read at most the bytes, -1 for all
+ * @throw std::out_of_range if not in the log
+ */
+QByteArray History::read(const Item& item, qint64 maxBytes) const {
+  QMutexLocker locker(&m_lock);
+  return this->readLocked(item, maxBytes);
+}
+
+/**
+ * @brief Is the payload with the hash in the log
+ *
+ * @param hash SHA-256 of the payload
+ */
+bool History::has(const QByteArray& hash) const {
+  QMutexLocker locker(&m_lock);
+  return m_blobs.contains(hash);
+}
+
+/**
+ * @brief Read the payload with the hash from the log
+ *
+ * @param hash SHA-256 of the payload
+ * @throw std::out_of_range if not in the log
+ */
+QByteArray History::find(const QByteArray& hash) const {
+  QMutexLocker locker(&m_lock);
+  return this->readLocked(Item{QString(), hash, 0, -1}, -1);
+}
+
+/**
+ * @brief Read the items of the entry to restore them
+ *
+ * @param index index of the entry
+ * @return mime type and payload
+ */
+QVector<QPair<QString, QByteArray>> History::restore(qsizetype index) const {
+  QMutexLocker locker(&m_lock);
+
+  // check the index
+  if (index < 0 || index >= m_entries.size()) {
+    throw std::out_of_range("Invalid history index");
+  }
+
+  // items of the entry
+  QVector<QPair<QString, QByteArray>> items;
+
+  // read the payloads
+  for (const auto& item : m_entries.at(index).items) {
+    items.append({item.mimeType, this->readLocked(item, -1)});
+  }
+
+  // return the items
+  return items;
+}
+
+/**
+ * @brief Drop the entries over the limits and rewrite the log
+ * with only the content that is still used on the thread
+ */
+void History::compact() {
+  QMetaObject::invokeMethod(m_worker, [this] {
+    try {
+      this->compactLog();
+    } catch (const std::exception& e) {
+      emit OnErrorOccurred(e.what());
+    }
+  }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Remove all the entries on the thread
+ */
+void History::clear() {
+  QMetaObject::invokeMethod(m_worker, [this] {
+    // drop the entries
+    {
+      QMutexLocker locker(&m_lock);
+      m_entries.clear();
+    }
+
+    // rewrite the log without them
+    try {
+      this->compactLog();
+    } catch (const std::exception& e) {
+      emit OnErrorOccurred(e.what());
+    }
+  }, Qt::QueuedConnection);
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
@@ -0,0 +1,265 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QSaveFile>
+#include <QSet>
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+// C++ headers
+#include <algorithm>
+#include <stdexcept>
+
+// project headers
+#include "constants/constants.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Append only history of the clipboard, the payloads are
+ * appended to a log file and only read back through a memory map
+ * when restored, the index of the entries (time, origin, hash and
+ * the offsets of the items) is the only thing kept in memory so
+ * large images in the history don't bloat the process, the same
+ * payload is stored once by its hash and shared by the entries
+ * that have it, the writes and the compaction run on a background
+ * thread and the reads only take the lock
+ */
+class History : public QObject {
+ signals:  // signals for this class
+  /// @brief On Added
+  void OnAdded(QByteArray hash, QVector<QPair<QString, QByteArray>> items);
+
+ signals:  // signals for this class
+  /// @brief On Error Occurred
+  void OnErrorOccurred(QString error);
+
+ private:  // just for Qt
+
+  /// @brief Qt meta object
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(History)
+
+ public:  // Types
+
+  /**
+   * @brief Item of the entry that points into the log
+   */
+  struct Item {
+    QString mimeType;
+    QByteArray hash;
+    qint64 offset;
+    qint64 length;
+  };
+
+  /**
+   * @brief Entry of the history
+   */
+  struct Entry {
+    qint64 time;
+    QString origin;
+    QByteArray hash;
+    QList<Item> items;
+  };
+
+ private:  // Member variables
+
+  /// @brief Directory of the files
+  QString m_dir;
+
+  /// @brief Thread of the writer
+  QThread m_thread;
+
+  /// @brief Context of the work on the thread
+  QObject* m_worker;
+
+  /// @brief Generation of the log, changed by compaction
+  quint64 m_generation = 0;
+
+  /// @brief Index file, used on the thread
+  QFile m_index;
+
+  /// @brief Log file of the payloads, used on the thread
+  QFile m_log;
+
+  /// @brief Lock of the entries, the payloads and the reader,
+  /// the map of a file is not safe to share so it is a mutex
+  mutable QMutex m_lock;
+
+  /// @brief Log file of the payloads opened to read
+  mutable QFile m_reader;
+
+  /// @brief Entries from the oldest to the newest
+  QList<Entry> m_entries;
+
+  /// @brief Stored payloads by the hash
+  QHash<QByteArray, Item> m_blobs;
+
+  /// @brief Maximum size of the log
+  qint64 m_maxBytes = 256 * 1024 * 1024;
+
+  /// @brief Maximum age of the entries in milliseconds
+  qint64 m_maxAge = 30ll * 24 * 60 * 60 * 1000;
+
+ private:  // Member functions
+
+  /**
+   * @brief Get the path of the log file of the generation
+   */
+  QString getLogFile(quint64 generation) const;
+
+  /**
+   * @brief Write the header of the index
+   */
+  void writeHeader(QDataStream& stream) const;
+
+  /**
+   * @brief Hash of the items
+   */
+  static QByteArray hashOf(const QVector<QPair<QString, QByteArray>>& items);
+
+  /**
+   * @brief Read the payload of the item from the log, the lock
+   * must be held
+   */
+  QByteArray readLocked(const Item& item, qint64 maxBytes) const;
+
+  /**
+   * @brief Write the items to the log and the index on the thread
+   */
+  void write(const QVector<QPair<QString, QByteArray>>& items, const QString& origin);
+
+  /**
+   * @brief Compact the log on the thread
+   */
+  void compactLog();
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new History object, start the thread of
+   * the writer and load the index from the directory if it exists
+   *
+   * @param dir Directory that keeps the history
+   * @param parent parent object
+   */
+  explicit History(const QString& dir = getDefaultDir(), QObject* parent = nullptr);
+
+  /**
+   * @brief Destroy the History object after the queued work
+   */
+  ~History();
+
+  /**
+   * @brief Get the Default Directory of the history under app home
+   *
+   * @return QString path of the directory
+   */
+  static QString getDefaultDir();
+
+  /**
+   * @brief Load the index on the thread and wait for it, a torn
+   * record at the end is dropped along with the entries that point
+   * outside of the log
+   */
+  void load();
+
+  /**
+   * @brief Set the limits, the log is compacted when it goes
+   * over the size or its oldest entry is older than the age
+   *
+   * @param maxBytes maximum size of the log
+   * @param maxAge maximum age of the entries in milliseconds
+   */
+  void setLimits(qint64 maxBytes, qint64 maxAge);
+
+  /**
+   * @brief Add the items to the history on the thread, the call
+   * returns at once, it is ignored if it is the same as the newest
+   * entry e.g. the item that was synced and came back as a
+   * clipboard change or if it is larger than the maximum size of
+   * the log, the payloads that are already in the log are not
+   * written again, OnAdded is emitted once it is written
+   *
+   * @param items mime type and payload
+   * @param origin peer the items came from
+   */
+  void add(QVector<QPair<QString, QByteArray>> items, QString origin);
+
+  /**
+   * @brief Wait till the queued work is done, must not be called
+   * from the thread of the writer
+   */
+  void waitForIdle();
+
+  /**
+   * @brief Get the entries from the oldest to the newest, the
+   * entries don't have the payloads
+   */
+  QList<Entry> getEntries() const;
+
+  /**
+   * @brief Read the payload of the item from the log, the item is
+   * found by its hash so it is read after a compaction too
+   *
+   * @param item item of the entry
+   * @param maxBytes read at most the bytes, -1 for all
+   * @throw std::out_of_range if not in the log
+   */
+  QByteArray read(const Item& item, qint64 maxBytes = -1) const;
+
+  /**
+   * @brief Is the payload with the hash in the log
+   *
+   * @param hash SHA-256 of the payload
+   */
+  bool has(const QByteArray& hash) const;
+
+  /**
+   * @brief Read the payload with the hash from the log
+   *
+   * @param hash SHA-256 of the payload
+   * @throw std::out_of_range if not in the log
+   */
+  QByteArray find(const QByteArray& hash) const;
+
+  /**
+   * @brief Read the items of the entry to restore them
+   *
+   * @param index index of the entry
+   * @return mime type and payload
+   */
+  QVector<QPair<QString, QByteArray>> restore(qsizetype index) const;
+
+  /**
+   * @brief Drop the entries over the limits and rewrite the log
+   * with only the content that is still used on the thread
+   */
+  void compact();
+
+  /**
+   * @brief Remove all the entries on the thread
+   */
+  void clear();
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
@@ -0,0 +1,300 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "searchindex.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Add the document with its trigrams
+ */
+void SearchIndex::Index::insert(const Document& document, const QSet<quint64>& trigrams) {
+  // id of the document
+  const auto id = documents.size();
+
+  // add the document
+  documents.append(document);
+  ids.insert(document.hash, id);
+
+  // the ids are increasing so the lists stay sorted
+  for (const auto trigram : trigrams) postings[trigram].append(id);
+}
+
+/**
+ * @brief Get the trigrams of the text
+ */
+QSet<quint64> SearchIndex::trigramsOf(const QString& text) {
+  // trigrams of the text
+  QSet<quint64> trigrams;
+
+  // three UTF-16 units make the key
+  for (qsizetype i = 0; i + 3 <= text.size(); i++) {
+    const auto a = quint64(text.at(i).unicode());
+    const auto b = quint64(text.at(i + 1).unicode());
+    const auto c = quint64(text.at(i + 2).unicode());
+    trigrams.insert((a << 32) | (b << 16) | c);
+  }
+
+  // return the trigrams
+  return trigrams;
+}
+
+/**
+ * @brief Get the text to index from the items
+ */
+QString SearchIndex::textOf(const QVector<QPair<QString, QByteArray>>& items) {
+  // markup and entities of the html
+  static const QRegularExpression tags("<[^>]*>");
+  static const QRegularExpression spaces("\\s+");
+
+  // texts of the items
+  QStringList texts;
+
+  // take the plain text and the text of the html
+  for (const auto& [mime, payload] : items) {
+    if (mime.startsWith("text/plain")) {
+      texts.append(QString::fromUtf8(payload.left(maxTextLength * 4)));
+    } else if (mime.startsWith("text/html")) {
+      auto text = QString::fromUtf8(payload.left(maxTextLength * 8)).remove(tags);
+      text.replace("&lt;", "<").replace("&gt;", ">").replace("&quot;", "\"");
+      text.replace("&#39;", "'").replace("&nbsp;", " ").replace("&amp;", "&");
+      texts.append(text);
+    }
+  }
+
+  // the html is mostly the same text so it is added only if
+  // it is not already in the plain text
+  if (texts.size() > 1 && texts.first().simplified().contains(texts.last().simplified())) {
+    texts.removeLast();
+  }
+
+  // join, fold the case and limit the size
+  return texts.join('\n').replace(spaces, " ").left(maxTextLength).toCaseFolded();
+}
+
+/**
+ * @brief Construct a new Search Index object and start the
+ * thread of the indexer
+ *
+ * @param file File that keeps the documents
+ * @param parent parent object
+ */
+SearchIndex::SearchIndex(const QString& file, QObject* parent)
+    : QObject(parent), m_file(file), m_worker(new QObject) {
+  // run the work on the thread
+  m_worker->moveToThread(&m_thread);
+
+  // the index never competes with the sync
+  m_thread.start(QThread::LowPriority);
+}
+
+/**
+ * @brief Destroy the Search Index object after the queued work
+ */
+SearchIndex::~SearchIndex() {
+  // quit after the queued work
+  QMetaObject::invokeMethod(m_worker, [this] { m_thread.quit(); }, Qt::QueuedConnection);
+
+  // wait for the thread
+  m_thread.wait();
+
+  // delete the context
+  delete m_worker;
+}
+
+/**
+ * @brief Get the Default File of the index next to the history
+ *
+ * @return QString path of the file
+ */
+QString SearchIndex::getDefaultFile() {
+  return QDir(History::getDefaultDir()).filePath("search");
+}
+
+/**
+ * @brief Load the documents on the thread, the documents whose
+ * content is no longer in the history are dropped from the file
+ *
+ * @param live hashes of the content in the history
+ */
+void SearchIndex::load(QSet<QByteArray> live) {
+  QMetaObject::invokeMethod(m_worker, [this, live] {
+    // index that is built
+    Index index;
+
+    // is any document dropped
+    auto isDropped = false;
+
+    // read the documents
+    if (QFile file(m_file); file.open(QIODevice::ReadOnly)) {
+      // stream of the file
+      QDataStream stream(&file);
+      stream.setVersion(QDataStream::Qt_6_0);
+
+      // read till the end or a torn record
+      while (!stream.atEnd()) {
+        Document document;
+        stream >> document.hash >> document.text;
+
+        // a torn record ends the file
+        if (stream.status() != QDataStream::Ok) {
+          isDropped = true;
+          break;
+        }
+
+        // drop the content that is gone
+        if (!live.contains(document.hash) || index.ids.contains(document.hash)) {
+          isDropped = true;
+          continue;
+        }
+
+        // add the document
+        index.insert(document, trigramsOf(document.text));
+      }
+    }
+
+    // rewrite the file with the documents that are kept
+    if (isDropped) {
+      QSaveFile file(m_file);
+      if (file.open(QIODevice::WriteOnly)) {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_6_0);
+        for (const auto& document : index.documents) stream << document.hash << document.text;
+        file.commit();
+      }
+    }
+
+    // swap the index
+    {
+      QWriteLocker locker(&m_lock);
+      m_index = std::move(index);
+    }
+
+    // open the file to append
+    QDir().mkpath(QFileInfo(m_file).absolutePath());
+    m_store.setFileName(m_file);
+    if (!m_store.open(QIODevice::WriteOnly | QIODevice::Append)) {
+      emit OnErrorOccurred("Can't open the search index");
+    }
+  }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Index the text of the items on the thread, the call
+ * returns at once so the sync is never delayed
+ *
+ * @param hash hash of the content
+ * @param items mime type and payload
+ */
+void SearchIndex::add(QByteArray hash, QVector<QPair<QString, QByteArray>> items) {
+  QMetaObject::invokeMethod(m_worker, [this, hash, items] {
+    // only this thread writes so the check holds
+    {
+      QReadLocker locker(&m_lock);
+      if (m_index.ids.contains(hash)) return;
+    }
+
+    // text of the items
+    const auto text = textOf(items);
+
+    // nothing to index
+    if (text.isEmpty()) return;
+
+    // trigrams are made out of the lock
+    const auto trigrams = trigramsOf(text);
+
+    // add the document
+    {
+      QWriteLocker locker(&m_lock);
+      m_index.insert({hash, text}, trigrams);
+    }
+
+    // persist the document
+    if (m_store.isOpen()) {
+      QDataStream stream(&m_store);
+      stream.setVersion(QDataStream::Qt_6_0);
+      stream << hash << text;
+      m_store.flush();
+    }
+
+    // notify the listeners
+    emit OnIndexed(hash);
+  }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Wait till the queued work is done, must not be called
+ * from the thread of the indexer
+ */
+void SearchIndex::waitForIdle() {
+  QMetaObject::invokeMethod(m_worker, [] {}, Qt::BlockingQueuedConnection);
+}
+
+/**
+ * @brief Find the content that has the query as a substring, a
+ * prefix is a substring too, case is ignored
+ *
+ * @param query text to find
+ * @param limit maximum number of results
+ *
+ * @return QList<QByteArray> hashes from the newest
+ */
+QList<QByteArray> SearchIndex::search(const QString& query, qsizetype limit) const {
+  // the text is folded and spaces collapsed like the index
+  static const QRegularExpression spaces("\\s+");
+  const auto needle = QString(query).replace(spaces, " ").toCaseFolded();
+
+  // results from the newest
+  QList<QByteArray> results;
+
+  // nothing to find
+  if (needle.isEmpty() || limit <= 0) return results;
+
+  // lock for reading the index
+  QReadLocker locker(&m_lock);
+
+  // documents of the index
+  const auto& documents = m_index.documents;
+
+  // too short for a trigram so scan from the newest
+  if (needle.size() < 3) {
+    for (auto id = documents.size() - 1; id >= 0 && results.size() < limit; id--) {
+      if (documents.at(id).text.contains(needle)) results.append(documents.at(id).hash);
+    }
+    return results;
+  }
+
+  // lists of the trigrams of the query
+  QList<const QList<qsizetype>*> lists;
+  for (const auto trigram : trigramsOf(needle)) {
+    const auto it = m_index.postings.constFind(trigram);
+    if (it == m_index.postings.constEnd()) return results;
+    lists.append(&*it);
+  }
+
+  // the shortest list is walked and the others are searched
+  std::sort(lists.begin(), lists.end(), [](auto a, auto b) { return a->size() < b->size(); });
+
+  // has the list the id
+  const auto has = [](const QList<qsizetype>* list, qsizetype id) {
+    return std::binary_search(list->begin(), list->end(), id);
+  };
+
+  // walk from the newest
+  const auto& shortest = *lists.first();
+  for (auto it = shortest.crbegin(); it != shortest.crend() && results.size() < limit; ++it) {
+    // every trigram must be in the document
+    const auto in  = [&](const QList<qsizetype>* list) { return has(list, *it); };
+    const auto all = std::all_of(lists.begin() + 1, lists.end(), in);
+
+    // the trigrams may be in other order so check the text
+    if (all && documents.at(*it).text.contains(needle)) {
+      results.append(documents.at(*it).hash);
+    }
+  }
+
+  // return the results
+  return results;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
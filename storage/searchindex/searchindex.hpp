@@ -0,0 +1,182 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+
+// C++ headers
+#include <algorithm>
+
+// project headers
+#include "storage/history/history.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Trigram index over the text of the history so a substring
+ * is found by intersecting the lists of its trigrams instead of a
+ * scan of the payloads, the documents are keyed by the hash of the
+ * content like the history, the index is built and persisted on a
+ * background thread and the queries only take a read lock
+ */
+class SearchIndex : public QObject {
+ signals:  // signals for this class
+  /// @brief On Indexed
+  void OnIndexed(QByteArray hash);
+
+ signals:  // signals for this class
+  /// @brief On Error Occurred
+  void OnErrorOccurred(QString error);
+
+ private:  // just for Qt
+
+  /// @brief Qt meta object
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(SearchIndex)
+
+ public:  // Constants
+
+  /// @brief Characters of a document that are indexed
+  static constexpr qsizetype maxTextLength = 4096;
+
+ private:  // Types
+
+  /**
+   * @brief Document of the index
+   */
+  struct Document {
+    QByteArray hash;
+    QString text;
+  };
+
+  /**
+   * @brief Documents and the lists of their trigrams
+   */
+  struct Index {
+    /// @brief Documents by the id
+    QList<Document> documents;
+
+    /// @brief Id of the documents by the hash
+    QHash<QByteArray, qsizetype> ids;
+
+    /// @brief Sorted ids of the documents by the trigram
+    QHash<quint64, QList<qsizetype>> postings;
+
+    /**
+     * @brief Add the document with its trigrams
+     */
+    void insert(const Document& document, const QSet<quint64>& trigrams);
+  };
+
+ private:  // Member variables
+
+  /// @brief File that keeps the documents
+  QString m_file;
+
+  /// @brief File opened to append, used on the thread
+  QFile m_store;
+
+  /// @brief Thread of the indexer
+  QThread m_thread;
+
+  /// @brief Context of the work on the thread
+  QObject* m_worker;
+
+  /// @brief Lock of the index
+  mutable QReadWriteLock m_lock;
+
+  /// @brief Index that is written on the thread
+  Index m_index;
+
+ private:  // Member functions
+
+  /**
+   * @brief Get the trigrams of the text
+   */
+  static QSet<quint64> trigramsOf(const QString& text);
+
+  /**
+   * @brief Get the text to index from the items
+   */
+  static QString textOf(const QVector<QPair<QString, QByteArray>>& items);
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Search Index object and start the
+   * thread of the indexer
+   *
+   * @param file File that keeps the documents
+   * @param parent parent object
+   */
+  explicit SearchIndex(const QString& file = getDefaultFile(), QObject* parent = nullptr);
+
+  /**
+   * @brief Destroy the Search Index object after the queued work
+   */
+  ~SearchIndex();
+
+  /**
+   * @brief Get the Default File of the index next to the history
+   *
+   * @return QString path of the file
+   */
+  static QString getDefaultFile();
+
+  /**
+   * @brief Load the documents on the thread, the documents whose
+   * content is no longer in the history are dropped from the file
+   *
+   * @param live hashes of the content in the history
+   */
+  void load(QSet<QByteArray> live);
+
+  /**
+   * @brief Index the text of the items on the thread, the call
+   * returns at once so the sync is never delayed
+   *
+   * @param hash hash of the content
+   * @param items mime type and payload
+   */
+  void add(QByteArray hash, QVector<QPair<QString, QByteArray>> items);
+
+  /**
+   * @brief Wait till the queued work is done, must not be called
+   * from the thread of the indexer
+   */
+  void waitForIdle();
+
+  /**
+   * @brief Find the content that has the query as a substring, a
+   * prefix is a substring too, case is ignored
+   *
+   * @param query text to find
+   * @param limit maximum number of results
+   *
+   * @return QList<QByteArray> hashes from the newest
+   */
+  QList<QByteArray> search(const QString& query, qsizetype limit = 50) const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
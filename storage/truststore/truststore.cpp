@@ -0,0 +1,131 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "truststore.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Construct a new Trust Store object and load the
+ * pinned peers from the file if it exists
+ *
+ * @param file File that keeps the pinned peers
+ */
+TrustStore::TrustStore(const QString& file) : m_file(file) {
+  this->load();
+}
+
+/**
+ * @brief Get the Default File of the store under app home
+ *
+ * @return QString path of the file
+ */
+QString TrustStore::getDefaultFile() {
+  return QDir(QString::fromStdString(constants::getAppHome())).filePath("trusted");
+}
+
+/**
+ * @brief Load the pinned peers from the file, each line is
+ * the hex fingerprint and the name separated by a tab
+ */
+void TrustStore::load() {
+  // clear the peers
+  m_peers.clear();
+
+  // open the file to read
+  QFile file(m_file);
+
+  // if not exists then nothing is pinned
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    return;
+  }
+
+  // read the peers line by line
+  while (!file.atEnd()) {
+    // read the line
+    const auto line = QString::fromUtf8(file.readLine()).trimmed();
+
+    // skip the empty lines
+    if (line.isEmpty()) continue;
+
+    // split the fingerprint and name
+    const auto sep  = line.indexOf('\t');
+    const auto hex  = sep < 0 ? line : line.left(sep);
+    const auto name = sep < 0 ? QString() : line.mid(sep + 1);
+
+    // add the peer
+    m_peers.insert(QByteArray::fromHex(hex.toLatin1()), name);
+  }
+}
+
+/**
+ * @brief Save the pinned peers to the file
+ *
+ * @throw std::runtime_error if failed to save
+ */
+void TrustStore::save() const {
+  // make sure the directory exists
+  QDir().mkpath(QFileInfo(m_file).absolutePath());
+
+  // file is replaced atomically on commit
+  QSaveFile file(m_file);
+
+  // open the file to write
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    throw std::runtime_error("Can't open the trust store");
+  }
+
+  // write the peers
+  for (auto it = m_peers.constBegin(); it != m_peers.constEnd(); ++it) {
+    file.write(it.key().toHex() + '\t' + it.value().toUtf8() + '\n');
+  }
+
+  // commit the file
+  if (!file.commit()) {
+    throw std::runtime_error("Can't save the trust store");
+  }
+}
+
+/**
+ * @brief Is the peer with the fingerprint pinned
+ *
+ * @param fingerprint SHA-256 certificate fingerprint
+ */
+bool TrustStore::isTrusted(const QByteArray& fingerprint) const {
+  return !fingerprint.isEmpty() && m_peers.contains(fingerprint);
+}
+
+/**
+ * @brief Pin the peer with the fingerprint and save
+ *
+ * @param fingerprint SHA-256 certificate fingerprint
+ * @param name Name of the peer for display
+ *
+ * @throw std::runtime_error if failed to save
+ */
+void TrustStore::trust(const QByteArray& fingerprint, const QString& name) {
+  m_peers.insert(fingerprint, name);
+  this->save();
+}
+
+/**
+ * @brief Unpin the peer with the fingerprint and save
+ *
+ * @param fingerprint SHA-256 certificate fingerprint
+ *
+ * @throw std::runtime_error if failed to save
+ */
+void TrustStore::revoke(const QByteArray& fingerprint) {
+  if (m_peers.remove(fingerprint)) this->save();
+}
+
+/**
+ * @brief Get the pinned peers
+ *
+ * @return QHash<QByteArray, QString> fingerprint -> name
+ */
+QHash<QByteArray, QString> TrustStore::getPeers() const {
+  return m_peers;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
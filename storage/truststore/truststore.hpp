@@ -0,0 +1,101 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QString>
+
+// C++ headers
+#include <stdexcept>
+
+// project headers
+#include "constants/constants.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::storage {
+/**
+ * @brief Persistent store of the pinned peers keyed by the SHA-256
+ * fingerprint of their certificate, the store is kept in memory as
+ * a hash so the lookup at handshake time is O(1) and every change
+ * is written back to the file
+ */
+class TrustStore {
+ private:  // Member variables
+
+  /// @brief File that keeps the pinned peers
+  QString m_file;
+
+  /// @brief Pinned peers fingerprint -> name
+  QHash<QByteArray, QString> m_peers;
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Construct a new Trust Store object and load the
+   * pinned peers from the file if it exists
+   *
+   * @param file File that keeps the pinned peers
+   */
+  explicit TrustStore(const QString& file = getDefaultFile());
+
+  /**
+   * @brief Get the Default File of the store under app home
+   *
+   * @return QString path of the file
+   */
+  static QString getDefaultFile();
+
+  /**
+   * @brief Load the pinned peers from the file
+   */
+  void load();
+
+  /**
+   * @brief Save the pinned peers to the file
+   *
+   * @throw std::runtime_error if failed to save
+   */
+  void save() const;
+
+  /**
+   * @brief Is the peer with the fingerprint pinned
+   *
+   * @param fingerprint SHA-256 certificate fingerprint
+   */
+  bool isTrusted(const QByteArray& fingerprint) const;
+
+  /**
+   * @brief Pin the peer with the fingerprint and save
+   *
+   * @param fingerprint SHA-256 certificate fingerprint
+   * @param name Name of the peer for display
+   *
+   * @throw std::runtime_error if failed to save
+   */
+  void trust(const QByteArray& fingerprint, const QString& name);
+
+  /**
+   * @brief Unpin the peer with the fingerprint and save
+   *
+   * @param fingerprint SHA-256 certificate fingerprint
+   *
+   * @throw std::runtime_error if failed to save
+   */
+  void revoke(const QByteArray& fingerprint);
+
+  /**
+   * @brief Get the pinned peers
+   *
+   * @return QHash<QByteArray, QString> fingerprint -> name
+   */
+  QHash<QByteArray, QString> getPeers() const;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::storage
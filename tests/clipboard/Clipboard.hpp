@@ -0,0 +1,55 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QCoreApplication>
+#include <QGuiApplication>
+
+// Local header files
+#include "clipboard/clipboard.hpp"
+#include "utility/tracing/tracing.hpp"
+
+/**
+ * @brief testing the change notified by the Clipboard
+ */
+TEST(Clipboard, TestingAppliedSync) {
+  // using the Clipboard
+  using srilakshmikanthanp::clipbirdesk::clipboard::Clipboard;
+
+  // using the tracing namespace
+  namespace tracing = srilakshmikanthanp::clipbirdesk::tracing;
+
+  // the clipboard of the application
+  Clipboard clipboard(QGuiApplication::clipboard());
+
+  // items of the clipboard
+  using Items = QVector<QPair<QString, QByteArray>>;
+
+  // count the copies notified
+  int copies = 0;
+  QObject::connect(&clipboard, &Clipboard::OnClipboardChange, [&](Items) { copies++; });
+
+  // the sync that is applied is not a new copy
+  {
+    tracing::SyncScope scope(tracing::newSyncId());
+    clipboard.set({{"text/plain", "synced"}});
+  }
+  QCoreApplication::processEvents();
+  EXPECT_EQ(copies, 0);
+
+  // the items set outside a sync e.g. from the history are
+  clipboard.set({{"text/plain", "restored"}});
+  QCoreApplication::processEvents();
+  EXPECT_EQ(copies, 1);
+
+  // and so is the copy of an other application
+  QGuiApplication::clipboard()->setText("copied");
+  QCoreApplication::processEvents();
+  EXPECT_EQ(copies, 2);
+}
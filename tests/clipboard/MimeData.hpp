@@ -0,0 +1,50 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QVector>
+
+// Local header files
+#include "clipboard/mimedata/mimedata.hpp"
+
+/**
+ * @brief testing the MimeData
+ */
+TEST(MimeData, TestingMimeData) {
+  // using the MimeData
+  using srilakshmikanthanp::clipbirdesk::clipboard::MimeData;
+
+  // the large image is spilled and the large text is not
+  const QVector<QPair<QString, QByteArray>> items = {
+    {"text/plain", QByteArray(MimeData::spillSize + 1, 't')},
+    {"image/png", QByteArray(MimeData::spillSize + 1, 'p')},
+    {"image/bmp", QByteArray(16, 'b')},
+  };
+
+  // create the mime data
+  MimeData mimeData(items);
+
+  // the formats are served from the buffers till spilled
+  EXPECT_EQ(mimeData.data("image/png"), items[1].second);
+
+  // only the image is spilled
+  mimeData.waitForSpill();
+  EXPECT_EQ(mimeData.getSpilledBytes(), items[1].second.size());
+
+  // the formats in the order they came
+  EXPECT_EQ(mimeData.formats(), (QStringList{"text/plain", "image/png", "image/bmp"}));
+  EXPECT_TRUE(mimeData.hasFormat("image/bmp"));
+  EXPECT_FALSE(mimeData.hasFormat("text/html"));
+
+  // the formats are served when asked for
+  EXPECT_EQ(mimeData.data("image/png"), items[1].second);
+  EXPECT_EQ(mimeData.data("text/plain"), items[0].second);
+  EXPECT_EQ(mimeData.items(), items);
+}
@@ -0,0 +1,34 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// C++ header files
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Allocations of at least this size are counted
+inline constexpr std::size_t largeAllocationSize = 1024 * 1024;
+
+/**
+ * @brief Number of heap allocations of at least the large size
+ * made by the process, it is incremented by the allocation hooks
+ * defined in test.cpp
+ */
+inline std::atomic<std::uint64_t> largeAllocations{0};
+
+/**
+ * @brief Are the allocations counted, Qt containers allocate with
+ * malloc/realloc so they are hooked only on glibc
+ *
+ * @return bool
+ */
+inline constexpr bool isAllocationCounted() {
+#if defined(__GLIBC__)
+  return true;
+#else
+  return false;
+#endif
+}
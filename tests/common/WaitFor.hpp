@@ -0,0 +1,28 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt header files
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QEventLoop>
+
+// C++ header files
+#include <functional>
+
+/**
+ * @brief Run the events till the condition holds or the time is up
+ *
+ * @param condition condition to wait for
+ * @param ms time to wait in milliseconds
+ * @return bool condition at the end
+ */
+inline bool waitFor(const std::function<bool()>& condition, int ms) {
+  for (QDeadlineTimer deadline(ms); !condition() && !deadline.hasExpired();) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+
+  return condition();
+}
@@ -0,0 +1,68 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QVector>
+
+// Local header files
+#include "network/packets/blobpacket/blobpacket.hpp"
+#include "types/except/except.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+
+/**
+ * @brief testing the BlobPacket
+ */
+TEST(BlobPacket, TestingBlobPacket) {
+  // using the BlobPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::BlobPacket;
+
+  // using the MalformedPacket
+  using srilakshmikanthanp::clipbirdesk::types::except::MalformedPacket;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // creating the packet
+  BlobPacket packet_send, packet_recv;
+
+  // constant values
+  const auto packetType = BlobPacket::PacketType::SendBlobs;
+  const auto syncId     = Q_UINT64_C(0x0123456789abcdef);
+  const auto blobs      = QVector<QByteArray>{QByteArray(2048, 'x'), QByteArray(), "Hello"};
+
+  // setting the packet type
+  packet_send.setPacketType(packetType);
+
+  // setting the sync id
+  packet_send.setSyncId(syncId);
+
+  // setting the blob count
+  packet_send.setBlobCount(blobs.size());
+
+  // setting the blobs
+  packet_send.setBlobs(blobs);
+
+  // setting the packet length
+  packet_send.setPacketLength(packet_send.size());
+
+  // load the packet from network byte order
+  const auto data = toQByteArray(packet_send);
+  packet_recv     = fromQByteArray<BlobPacket>(data);
+
+  // check the packet
+  EXPECT_EQ(packet_recv.getPacketType(), packetType);
+  EXPECT_EQ(packet_recv.getPacketLength(), data.size());
+  EXPECT_EQ(packet_recv.getSyncId(), syncId);
+  EXPECT_EQ(packet_recv.getBlobCount(), blobs.size());
+  EXPECT_EQ(packet_recv.getBlobs(), blobs);
+
+  // a truncated packet is malformed
+  EXPECT_THROW(fromQByteArray<BlobPacket>(data.left(data.size() - 1)), MalformedPacket);
+}
@@ -0,0 +1,113 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QBuffer>
+#include <QByteArray>
+#include <QtEndian>
+
+// Local header files
+#include "network/packets/chunkpacket/chunkpacket.hpp"
+#include "network/syncing/scheduler/scheduler.hpp"
+#include "types/except/except.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+/**
+ * @brief testing the ChunkPacket
+ */
+TEST(ChunkPacket, TestingChunkPacket) {
+  // using the ChunkPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::ChunkPacket;
+
+  // using the MalformedPacket
+  using srilakshmikanthanp::clipbirdesk::types::except::MalformedPacket;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // constant values
+  const auto packetType = ChunkPacket::PacketType::Chunk;
+  const auto streamId   = quint32(7);
+  const auto flags      = quint8(ChunkPacket::Flag::First);
+  const auto payload    = QByteArray(1024, 'c');
+
+  // creating the packet
+  const auto packet_send = createPacket({packetType, streamId, flags, payload});
+
+  // load the packet from network byte order
+  const auto data        = toQByteArray(packet_send);
+  const auto packet_recv = fromQByteArray<ChunkPacket>(data);
+
+  // check the packet
+  EXPECT_EQ(packet_recv.getPacketType(), packetType);
+  EXPECT_EQ(packet_recv.getPacketLength(), data.size());
+  EXPECT_EQ(packet_recv.getStreamId(), streamId);
+  EXPECT_EQ(packet_recv.getFlags(), flags);
+  EXPECT_EQ(packet_recv.getPayloadLength(), payload.size());
+  EXPECT_EQ(packet_recv.getPayload(), payload);
+
+  // a truncated packet is malformed
+  EXPECT_THROW(fromQByteArray<ChunkPacket>(data.left(data.size() - 1)), MalformedPacket);
+}
+
+/**
+ * @brief testing the chunks of the Scheduler
+ */
+TEST(ChunkPacket, TestingScheduler) {
+  // using the ChunkPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::ChunkPacket;
+
+  // using the Scheduler
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Scheduler;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // device the sender writes to
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+
+  // sender and receiver
+  Scheduler sender(&buffer), receiver(&buffer);
+  sender.setChunking(true);
+
+  // the large packet is cut and the small one is not
+  const auto large = QByteArray(3 * Scheduler::chunkSize + 10, 'l');
+  const auto small = QByteArray(16, 's');
+  sender.send(large, 1);
+  sender.send(small);
+
+  // split the written data into the packets
+  QList<QByteArray> packets;
+  for (qsizetype at = 0; at < buffer.data().size();) {
+    const auto length = qFromBigEndian<qint32>(buffer.data().constData() + at + 1);
+    packets.append(buffer.data().mid(at, length));
+    at += length;
+  }
+
+  // the large packet in four chunks and then the small one
+  ASSERT_EQ(packets.size(), 5);
+  EXPECT_EQ(packets.last(), small);
+
+  // join the chunks back
+  QByteArray whole;
+  for (qsizetype i = 0; i < 4; ++i) {
+    EXPECT_TRUE(whole.isEmpty());
+    whole = receiver.reassemble(fromQByteArray<ChunkPacket>(packets[i]));
+  }
+
+  // the whole packet is back
+  EXPECT_EQ(whole, large);
+
+  // the cancelled stream is dropped by the receiver
+  receiver.reassemble(fromQByteArray<ChunkPacket>(packets[0]));
+  receiver.reassemble(createPacket({ChunkPacket::Chunk, 1, ChunkPacket::Cancel, QByteArray()}));
+  EXPECT_TRUE(receiver.reassemble(fromQByteArray<ChunkPacket>(packets[3])).isEmpty());
+}
@@ -70,3 +70,61 @@ TEST(DiscoveryPacketTest, TestingDiscoveryPacket) {
   // check the port
   EXPECT_EQ(packet_recv.getHostPort(), port);
 }
+
+/**
+ * @brief testing the fields of the DiscoveryPacket response
+ */
+TEST(DiscoveryPacketTest, TestingDiscoveryPacketFields) {
+  // using the ServiceDiscoveryPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::DiscoveryPacket;
+
+  // using the IPType
+  typedef srilakshmikanthanp::clipbirdesk::types::enums::IPType IPType;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // creating the packet
+  DiscoveryPacket packet_send, packet_recv;
+
+  // setting the header and the host
+  packet_send.setPacketType(DiscoveryPacket::PacketType::Response);
+  packet_send.setIpType(IPType::IPv4);
+  packet_send.setHostIp(QByteArray("\x7F\x00\x00\x01", 4));
+  packet_send.setHostPort(1234);
+
+  // setting the known fields
+  packet_send.setClientCount(12);
+  packet_send.setCapacity(64);
+  packet_send.setProtocolVersion(1);
+  packet_send.setCodecs(0x07);
+
+  // setting a field that is not known yet
+  packet_send.setField(0xF0, QByteArray("future"));
+
+  // setting the packet length
+  packet_send.setPacketLength(packet_send.size());
+
+  // load the packet from network byte order
+  packet_recv = fromQByteArray<DiscoveryPacket>(toQByteArray(packet_send));
+
+  // check the packet length
+  EXPECT_EQ(packet_recv.getPacketLength(), packet_send.size());
+
+  // check the host
+  EXPECT_EQ(packet_recv.getHostPort(), 1234);
+
+  // check the known fields
+  EXPECT_EQ(packet_recv.getClientCount(), 12u);
+  EXPECT_EQ(packet_recv.getCapacity(), 64u);
+  EXPECT_EQ(packet_recv.getProtocolVersion(), 1);
+  EXPECT_EQ(packet_recv.getCodecs(), 0x07u);
+
+  // the field that is not known is kept
+  EXPECT_EQ(packet_recv.getField(0xF0), QByteArray("future"));
+
+  // the missing field reads as 0
+  DiscoveryPacket packet_old;
+  EXPECT_FALSE(packet_old.hasField(DiscoveryPacket::Field::ClientCount));
+  EXPECT_EQ(packet_old.getClientCount(), 0u);
+}
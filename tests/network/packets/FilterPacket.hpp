@@ -0,0 +1,98 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QVector>
+
+// Local header files
+#include "network/packets/filterpacket/filterpacket.hpp"
+#include "types/except/except.hpp"
+#include "utility/functions/filter/filter.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+/**
+ * @brief testing the FilterPacket
+ */
+TEST(FilterPacket, TestingFilterPacket) {
+  // using the FilterPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::FilterPacket;
+
+  // using the MalformedPacket
+  using srilakshmikanthanp::clipbirdesk::types::except::MalformedPacket;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // constant values
+  const auto packetType  = FilterPacket::PacketType::Filter;
+  const auto flags       = quint8(FilterPacket::Flag::TextOnly);
+  const auto maxItemSize = quint32(4096);
+  const auto mimeTypes   = QVector<QByteArray>{"text/plain", "image/*"};
+
+  // creating the packet
+  const auto packet_send = createPacket({packetType, flags, maxItemSize, mimeTypes});
+
+  // load the packet from network byte order
+  const auto data        = toQByteArray(packet_send);
+  const auto packet_recv = fromQByteArray<FilterPacket>(data);
+
+  // check the packet
+  EXPECT_EQ(packet_recv.getPacketType(), packetType);
+  EXPECT_EQ(packet_recv.getPacketLength(), data.size());
+  EXPECT_EQ(packet_recv.getFlags(), flags);
+  EXPECT_EQ(packet_recv.getMaxItemSize(), maxItemSize);
+  EXPECT_EQ(packet_recv.getMimeCount(), mimeTypes.size());
+  EXPECT_EQ(packet_recv.getMimeTypes(), mimeTypes);
+
+  // a truncated packet is malformed
+  EXPECT_THROW(fromQByteArray<FilterPacket>(data.left(data.size() - 1)), MalformedPacket);
+}
+
+/**
+ * @brief testing the items accepted by the filter
+ */
+TEST(FilterPacket, TestingFilterItems) {
+  // using the FilterPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::FilterPacket;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // items to filter
+  const QVector<QPair<QString, QByteArray>> items = {
+    {"text/plain", "Hello World"},
+    {"text/html", QByteArray(8192, 'h')},
+    {"image/png", QByteArray(1024, 'x')},
+  };
+
+  // the default filter accepts all
+  EXPECT_EQ(filterItems(items, FilterPacket()), items);
+
+  // only the text
+  FilterPacket filter;
+  filter.setFlags(FilterPacket::Flag::TextOnly);
+  EXPECT_EQ(filterItems(items, filter), items.mid(0, 2));
+
+  // only the small text
+  filter.setMaxItemSize(4096);
+  EXPECT_EQ(filterItems(items, filter), items.mid(0, 1));
+
+  // the types and the prefixes
+  filter.setFlags(0);
+  filter.setMaxItemSize(0);
+  filter.setMimeCount(2);
+  filter.setMimeTypes({"text/plain", "image/*"});
+  EXPECT_EQ(filterItems(items, filter), (QVector<QPair<QString, QByteArray>>{items[0], items[2]}));
+
+  // the paused gets nothing
+  filter.setFlags(FilterPacket::Flag::Paused);
+  EXPECT_TRUE(filterItems(items, filter).isEmpty());
+}
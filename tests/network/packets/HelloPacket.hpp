@@ -0,0 +1,62 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+
+// Local header files
+#include "network/packets/hellopacket/hellopacket.hpp"
+#include "types/except/except.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+/**
+ * @brief testing the HelloPacket
+ */
+TEST(HelloPacket, TestingHelloPacket) {
+  // using the HelloPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::HelloPacket;
+
+  // using the MalformedPacket
+  using srilakshmikanthanp::clipbirdesk::types::except::MalformedPacket;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // constant values
+  const auto packetType = HelloPacket::PacketType::Hello;
+  const auto version    = quint16(3);
+  const auto minVersion = quint16(1);
+  const auto features   = quint32(HelloPacket::Feature::InlineItems | 0x100);
+
+  // creating the packet
+  const auto packet_send = createPacket({packetType, version, minVersion, features});
+
+  // load the packet from network byte order
+  const auto data        = toQByteArray(packet_send);
+  const auto packet_recv = fromQByteArray<HelloPacket>(data);
+
+  // check the packet
+  EXPECT_EQ(packet_recv.getPacketType(), packetType);
+  EXPECT_EQ(packet_recv.getPacketLength(), data.size());
+  EXPECT_EQ(packet_recv.getVersion(), version);
+  EXPECT_EQ(packet_recv.getMinVersion(), minVersion);
+  EXPECT_EQ(packet_recv.getFeatures(), features);
+
+  // the unknown features are kept for the peer to drop
+  EXPECT_EQ(packet_recv.getFeatures() & supportedFeatures, HelloPacket::Feature::InlineItems);
+
+  // a truncated packet is malformed
+  EXPECT_THROW(fromQByteArray<HelloPacket>(data.left(data.size() - 1)), MalformedPacket);
+
+  // the oldest version can't be newer than the newest
+  auto invalid = data;
+  invalid[8]   = 0x04;
+  EXPECT_THROW(fromQByteArray<HelloPacket>(invalid), MalformedPacket);
+}
@@ -11,9 +11,14 @@
 #include <QByteArray>
 
 // Local header files
+#include "clipboard/mimedata/mimedata.hpp"
 #include "network/packets/syncingpacket/syncingpacket.hpp"
+#include "storage/blobstore/blobstore.hpp"
+#include "tests/common/Allocations.hpp"
 #include "types/enums/enums.hpp"
+#include "utility/functions/blobs/blobs.hpp"
 #include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
 
 /**
  * @brief testing the ServiceDiscoveryPacket
@@ -31,6 +36,10 @@ TEST(SyncingPacket, TestingSyncingPacket) {
 
   // constant values
   const auto packetType = SyncingPacket::PacketType::SyncPacket;
+  const auto syncId     = Q_UINT64_C(0x0123456789abcdef);
+  const auto originId   = Q_UINT64_C(0xfedcba9876543210);
+  const auto hopCount   = quint8(3);
+  const auto generation = Q_UINT64_C(1700000000000);
   const auto itemCount  = 2;
   const auto mimeType   = QByteArray("text/plain", 10);
   const auto payload    = QByteArray("Hello World", 11);
@@ -47,6 +56,11 @@ TEST(SyncingPacket, TestingSyncingPacket) {
     // setting the mime type
     item.setMimeType(mimeType);
 
+    // setting the encoding, the last one as a reference
+    item.setEncoding(
+        i == itemCount - 1 ? SyncingItem::Encoding::Reference : SyncingItem::Encoding::Inline
+    );
+
     // setting the payload length
     item.setPayloadLength(payload.size());
 
@@ -60,6 +74,14 @@ TEST(SyncingPacket, TestingSyncingPacket) {
   // setting the packet type
   packet_send.setPacketType(packetType);
 
+  // setting the sync id
+  packet_send.setSyncId(syncId);
+
+  // setting the origin and the hops
+  packet_send.setOriginId(originId);
+  packet_send.setHopCount(hopCount);
+  packet_send.setGeneration(generation);
+
   // setting the item count
   packet_send.setItemCount(itemCount);
 
@@ -70,7 +92,8 @@ TEST(SyncingPacket, TestingSyncingPacket) {
   packet_send.setPacketLength(packet_send.size());
 
   // load the packet from network byte order
-  packet_recv = fromQByteArray<SyncingPacket>(toQByteArray(packet_send));
+  const auto data = toQByteArray(packet_send);
+  packet_recv     = fromQByteArray<SyncingPacket>(data);
 
   // check the packet type
   EXPECT_EQ(packet_recv.getPacketType(), packetType);
@@ -78,9 +101,27 @@ TEST(SyncingPacket, TestingSyncingPacket) {
   // check the packet length
   EXPECT_EQ(packet_recv.getPacketLength(), packet_send.size());
 
+  // check the sync id
+  EXPECT_EQ(packet_recv.getSyncId(), syncId);
+
+  // check the origin and the hops
+  EXPECT_EQ(packet_recv.getOriginId(), originId);
+  EXPECT_EQ(packet_recv.getHopCount(), hopCount);
+
+  // check the generation
+  EXPECT_EQ(packet_recv.getGeneration(), generation);
+
+  // the generation is a field of the version 2
+  const auto older = data.left(data.size() - qsizetype(sizeof(generation)));
+  EXPECT_ANY_THROW(fromQByteArray<SyncingPacket>(older));
+
   // check the item count
   EXPECT_EQ(packet_recv.getItemCount(), itemCount);
 
+  // check the encodings
+  EXPECT_EQ(packet_recv.getItems().first().getEncoding(), SyncingItem::Encoding::Inline);
+  EXPECT_EQ(packet_recv.getItems().last().getEncoding(), SyncingItem::Encoding::Reference);
+
   // check the items
   for (const auto &item : packet_recv.getItems()) {
     // check the mime length
@@ -96,3 +137,100 @@ TEST(SyncingPacket, TestingSyncingPacket) {
     EXPECT_EQ(item.getPayload(), payload);
   }
 }
+
+/**
+ * @brief testing the SyncingPacket of the version 1 has only the
+ * inline items
+ */
+TEST(SyncingPacket, TestingVersionOne) {
+  // using the ClipboardSyncPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingItem;
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // the packet of the version 1
+  auto packet_send = createPacket({
+      SyncingPacket::PacketType::SyncPacket, {{"text/plain", "Hello World"}, {"text/html", "<b>"}}
+  });
+  packet_send.setSyncId(Q_UINT64_C(0x0123456789abcdef));
+  packet_send.setGeneration(Q_UINT64_C(1700000000000));
+  packet_send.setVersion(1);
+  packet_send.setPacketLength(packet_send.size());
+
+  // the length has only the items
+  const auto data = toQByteArray(packet_send);
+  EXPECT_EQ(data.size(), packet_send.size());
+  EXPECT_EQ(data.size(), 1 + 4 + 4 + (4 + 10 + 4 + 11) + (4 + 9 + 4 + 3));
+
+  // read in the version 1 without the fields of the version 2
+  const auto packet_recv = fromQByteArray<SyncingPacket>(data, 1);
+  EXPECT_EQ(packet_recv.getPacketLength(), data.size());
+  EXPECT_EQ(packet_recv.getSyncId(), quint64(0));
+  EXPECT_EQ(packet_recv.getGeneration(), quint64(0));
+  EXPECT_EQ(packet_recv.getItemCount(), 2);
+  EXPECT_EQ(packet_recv.getItems().last().getPayload(), QByteArray("<b>"));
+
+  // the reference has no coding in the version 1
+  auto reference = packet_send;
+  auto items     = reference.getItems();
+  items.last().setEncoding(SyncingItem::Encoding::Reference);
+  reference.setItems(items);
+  EXPECT_ANY_THROW(toQByteArray(reference));
+}
+
+/**
+ * @brief testing the payloads are copied only once out of the frame
+ * on the receive path and shared from there to the mime data
+ */
+TEST(SyncingPacket, TestingBorrowedItems) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using the BlobStore
+  using srilakshmikanthanp::clipbirdesk::storage::BlobStore;
+
+  // using the MimeData
+  using srilakshmikanthanp::clipbirdesk::clipboard::MimeData;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // the allocations are counted only on glibc
+  if (!isAllocationCounted()) GTEST_SKIP() << "allocations are not counted";
+
+  // items to sync, the image is first so it is not spilled
+  const QVector<QPair<QString, QByteArray>> items = {
+    {"image/png", QByteArray(4 * largeAllocationSize, 'x')},
+    {"text/plain", "Hello World"},
+  };
+
+  // the frame as it is received
+  const auto type  = SyncingPacket::PacketType::SyncPacket;
+  const auto frame = toQByteArray(createPacket({type, items}));
+
+  // the decode copies the image out of the frame once
+  auto start  = largeAllocations.load();
+  auto packet = fromQByteArray<SyncingPacket>(frame);
+  EXPECT_EQ(largeAllocations.load() - start, 1u);
+
+  // the resolved items and the mime data share the decoded image
+  start = largeAllocations.load();
+  BlobStore store;
+  const auto resolved = resolveItems(packet, store);
+  MimeData mimeData(resolved, 1);
+  EXPECT_EQ(largeAllocations.load() - start, 0u);
+
+  // check the items
+  ASSERT_EQ(resolved, items);
+  EXPECT_EQ(mimeData.getSpilledBytes(), 0);
+  EXPECT_TRUE(resolved[0].second.isSharedWith(packet.getItems().at(0).getPayload()));
+
+  // the payload taken out of the packet is not copied
+  start            = largeAllocations.load();
+  auto taken       = std::move(packet).takeItems();
+  const auto image = std::move(taken[0]).takePayload();
+  EXPECT_EQ(largeAllocations.load() - start, 0u);
+  EXPECT_EQ(image, items[0].second);
+}
@@ -0,0 +1,96 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QHostAddress>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+// Local header files
+#include "network/resolver/resolver.hpp"
+#include "tests/common/WaitFor.hpp"
+
+/**
+ * @brief testing the cache of the Resolver
+ */
+TEST(Resolver, TestingCache) {
+  // using the Resolver
+  using srilakshmikanthanp::clipbirdesk::network::resolver::Resolver;
+
+  // creating the resolver
+  Resolver resolver;
+
+  // the names that arrived
+  QList<QPair<QHostAddress, QString>> resolved;
+  const auto signal_r = &Resolver::OnHostNameResolved;
+  const auto slot_r   = [&](QHostAddress address, QString name) {
+    resolved.append({address, name});
+  };
+  QObject::connect(&resolver, signal_r, slot_r);
+
+  // the address is returned till the name arrives
+  const auto loopback = QHostAddress(QHostAddress::LocalHost);
+  EXPECT_EQ(resolver.resolve(loopback), loopback.toString());
+  EXPECT_EQ(resolver.resolve(loopback), loopback.toString());
+
+  // one lookup is in flight for the address
+  ASSERT_TRUE(waitFor([&] { return !resolved.isEmpty(); }, 10000));
+  waitFor([] { return false; }, 100);
+  ASSERT_EQ(resolved.size(), 1);
+  EXPECT_EQ(resolved[0].first, loopback);
+
+  // the fresh name is served from the cache without a lookup
+  const auto name = resolved[0].second;
+  EXPECT_EQ(resolver.resolve(loopback), name);
+  waitFor([] { return false; }, 100);
+  EXPECT_EQ(resolved.size(), 1);
+
+  // the names cached from now expire at once
+  resolver.setTimeToLive(0);
+  resolver.clearCache();
+  resolver.resolve(loopback);
+  ASSERT_TRUE(waitFor([&] { return resolved.size() == 2; }, 10000));
+
+  // the expired name is served while it is looked up again
+  EXPECT_EQ(resolver.resolve(loopback), resolved[1].second);
+  ASSERT_TRUE(waitFor([&] { return resolved.size() == 3; }, 10000));
+}
+
+/**
+ * @brief testing the failed lookups are cached too
+ */
+TEST(Resolver, TestingNegativeCache) {
+  // using the Resolver
+  using srilakshmikanthanp::clipbirdesk::network::resolver::Resolver;
+
+  // creating the resolver
+  Resolver resolver;
+
+  // count the names that arrived
+  int resolved = 0;
+  const auto signal_r = &Resolver::OnHostNameResolved;
+  const auto slot_r   = [&](QHostAddress, QString) { resolved++; };
+  QObject::connect(&resolver, signal_r, slot_r);
+
+  // the lookup of the address that is not valid fails
+  const auto invalid = QHostAddress();
+  resolver.resolve(invalid);
+  ASSERT_TRUE(waitFor([&] { return resolved == 1; }, 10000));
+
+  // the failure is cached and not looked up again
+  EXPECT_EQ(resolver.resolve(invalid), invalid.toString());
+  waitFor([] { return false; }, 100);
+  EXPECT_EQ(resolved, 1);
+
+  // till the cache is cleared
+  resolver.clearCache();
+  resolver.resolve(invalid);
+  ASSERT_TRUE(waitFor([&] { return resolved == 2; }, 10000));
+}
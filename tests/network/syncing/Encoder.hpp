@@ -0,0 +1,51 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Local header files
+#include "network/syncing/encoder/encoder.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+/**
+ * @brief testing the Encoder
+ */
+TEST(Encoder, TestingEncoder) {
+  // using the SyncingPacket
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+
+  // using the Encoder
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Encoder;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // packet type
+  const auto type = SyncingPacket::PacketType::SyncPacket;
+
+  // a long and a short packet
+  const auto longer  = createPacket({type, {{"text/plain", QByteArray(64, 'x')}}});
+  const auto shorter = createPacket({type, {{"text/plain", "y"}}});
+
+  // encoder of the connection
+  Encoder encoder;
+
+  // the bytes are the same as the packet
+  const auto frame = encoder.encode(longer).constData();
+  EXPECT_EQ(encoder.encode(longer), toQByteArray(longer));
+
+  // the shorter packet reuses the frame and leaves no bytes of the long one
+  const auto bytes = encoder.encode(shorter);
+  EXPECT_EQ(bytes, toQByteArray(shorter));
+  EXPECT_EQ(bytes.constData(), frame);
+
+  // the frame that is still shared is not written over
+  const auto next = encoder.encode(longer);
+  EXPECT_EQ(bytes, toQByteArray(shorter));
+  EXPECT_EQ(next, toQByteArray(longer));
+}
@@ -0,0 +1,41 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Local header files
+#include "network/syncing/generation/generation.hpp"
+
+/**
+ * @brief testing the Generation
+ */
+TEST(Generation, TestingGeneration) {
+  // using the Generation
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Generation;
+
+  // clock of the node
+  Generation clock;
+
+  // the copy is newer than all seen, the base is far after the time
+  const auto first = clock.next(1);
+  const auto base  = first + 1000000;
+  EXPECT_TRUE(clock.advance(base, 2));
+  EXPECT_EQ(clock.next(1), base + 1);
+
+  // the older and the tied lower node are stale
+  EXPECT_TRUE(clock.isStale(first, 2));
+  EXPECT_TRUE(clock.isStale(base + 1, 0));
+  EXPECT_FALSE(clock.advance(base - 5, 3));
+
+  // the tied higher node and the newer wins
+  EXPECT_TRUE(clock.advance(base + 1, 3));
+  EXPECT_TRUE(clock.advance(base + 2, 0));
+
+  // the sync without the generation is never stale
+  EXPECT_TRUE(clock.advance(0, 0));
+  EXPECT_EQ(clock.value(), base + 2);
+}
@@ -0,0 +1,82 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QGuiApplication>
+#include <QHostAddress>
+
+// Local header files
+#include "clipboard/clipboard.hpp"
+#include "network/syncing/server/server.hpp"
+#include "tests/common/WaitFor.hpp"
+#include "utility/functions/sslcert/sslcert.hpp"
+#include "utility/tracing/tracing.hpp"
+
+/**
+ * @brief testing the sync through two meshed servers is applied
+ * once on each and doesn't bounce back as a new copy
+ */
+TEST(Mesh, TestingNoEcho) {
+  // using the Server and Clipboard
+  using srilakshmikanthanp::clipbirdesk::clipboard::Clipboard;
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Server;
+
+  // using the namespaces
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+  namespace tracing = srilakshmikanthanp::clipbirdesk::tracing;
+
+  // one identity for both, every peer is accepted
+  const auto config = getQSslConfiguration();
+  const auto accept = [](auto, auto result) { result(true); };
+
+  // the first server has no clipboard, the copy starts at it
+  Server first, second;
+  for (auto server : {&first, &second}) {
+    server->setSSLConfiguration(config);
+    server->setAuthenticator(accept);
+    server->startServer();
+  }
+
+  // the second server is wired to the clipboard like the controller
+  Clipboard clipboard(QGuiApplication::clipboard());
+  QObject::connect(&second, &Server::OnSyncRequest, &clipboard, &Clipboard::set);
+  QObject::connect(&clipboard, &Clipboard::OnClipboardChange, &second, &Server::syncItems);
+
+  // items of the clipboard
+  using Items = QVector<QPair<QString, QByteArray>>;
+
+  // count the syncs applied and the copies on each node
+  int firstApplied = 0, secondApplied = 0, copies = 0;
+  QObject::connect(&first, &Server::OnSyncRequest, [&](Items, QString) { firstApplied++; });
+  QObject::connect(&second, &Server::OnSyncRequest, [&](Items, QString) { secondApplied++; });
+  QObject::connect(&clipboard, &Clipboard::OnClipboardChange, [&](Items) { copies++; });
+
+  // the first server joins the second one
+  first.addRelay({QHostAddress::LocalHost, second.getServerInfo().second});
+  ASSERT_TRUE(waitFor([&] { return second.getConnectedClientsList().size() == 1; }, 10000));
+  waitFor([] { return false; }, 500);
+
+  // copy at the first server
+  {
+    tracing::SyncScope scope(tracing::newSyncId());
+    first.syncItems({{"text/plain", "copied at the first"}});
+  }
+
+  // the second server applies it
+  ASSERT_TRUE(waitFor([&] { return secondApplied > 0; }, 10000));
+
+  // give a bounce time to come back
+  waitFor([] { return false; }, 1000);
+
+  // applied once on the second and never back on the first
+  EXPECT_EQ(secondApplied, 1);
+  EXPECT_EQ(firstApplied, 0);
+  EXPECT_EQ(copies, 0);
+  EXPECT_EQ(clipboard.get().value(0).second, QByteArray("copied at the first"));
+}
@@ -0,0 +1,103 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QDataStream>
+#include <QHostAddress>
+#include <QSslSocket>
+
+// Local header files
+#include "network/syncing/server/server.hpp"
+#include "tests/common/WaitFor.hpp"
+#include "utility/functions/nbytes/nbytes.hpp"
+#include "utility/functions/packet/packet.hpp"
+#include "utility/functions/sslcert/sslcert.hpp"
+
+/**
+ * @brief testing the client that says hello with the version 1
+ * gets the syncing packets of the version 1
+ */
+TEST(Negotiation, TestingVersionOne) {
+  // using the Server and the packets
+  using srilakshmikanthanp::clipbirdesk::network::packets::HelloPacket;
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingPacket;
+  using srilakshmikanthanp::clipbirdesk::network::syncing::Server;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // one identity for both, every peer is accepted
+  const auto config = getQSslConfiguration();
+  const auto accept = [](auto, auto result) { result(true); };
+
+  // start the server
+  Server server;
+  server.setSSLConfiguration(config);
+  server.setAuthenticator(accept);
+  server.startServer();
+
+  // the client of the version 1 that reads references too
+  QSslSocket socket;
+  auto clientConfig = config;
+  clientConfig.setPeerVerifyMode(QSslSocket::QueryPeer);
+  socket.setSslConfiguration(clientConfig);
+
+  // say hello once encrypted
+  const auto features = quint32(HelloPacket::InlineItems | HelloPacket::ReferenceItems);
+  const auto signal_e = &QSslSocket::encrypted;
+  const auto slot_e   = [&]() {
+    socket.write(toQByteArray(createPacket({HelloPacket::PacketType::Hello, 1, 1, features})));
+  };
+  QObject::connect(&socket, signal_e, slot_e);
+
+  // connect to the server
+  socket.connectToHostEncrypted("127.0.0.1", server.getServerInfo().second);
+  ASSERT_TRUE(waitFor([&] { return server.getConnectedClientsList().size() == 1; }, 10000));
+
+  // sync a payload that a version 2 client gets as a reference
+  const auto payload = QByteArray(4096, 'x');
+  server.syncItems({{"image/png", payload}});
+
+  // read the packets till the syncing packet
+  QByteArray data;
+  const auto isSync = [&]() {
+    for (data = readPacket(&socket); !data.isEmpty(); data = readPacket(&socket)) {
+      if (static_cast<quint8>(data.at(0)) == SyncingPacket::PacketType::SyncPacket) return true;
+    }
+    return false;
+  };
+  ASSERT_TRUE(waitFor(isSync, 10000));
+
+  // read the packet as the version 1 does
+  QDataStream stream(data);
+  stream.setByteOrder(QDataStream::BigEndian);
+  quint8 type;
+  qint32 length, itemCount, mimeLength, payloadLength;
+  stream >> type >> length >> itemCount >> mimeLength;
+  QByteArray mime(mimeLength, Qt::Uninitialized);
+  stream.readRawData(mime.data(), mimeLength);
+  stream >> payloadLength;
+  QByteArray inline_(payloadLength, Qt::Uninitialized);
+  stream.readRawData(inline_.data(), payloadLength);
+
+  // the packet has only the items and the payload is inline
+  ASSERT_EQ(stream.status(), QDataStream::Ok);
+  EXPECT_TRUE(stream.atEnd());
+  EXPECT_EQ(length, data.size());
+  EXPECT_EQ(itemCount, 1);
+  EXPECT_EQ(mime, QByteArray("image/png"));
+  EXPECT_EQ(inline_, payload);
+
+  // the packet of the version 1 reads back the same
+  const auto packet = fromQByteArray<SyncingPacket>(data, 1);
+  EXPECT_EQ(packet.getItems().first().getEncoding(), 0);
+  EXPECT_EQ(packet.getGeneration(), quint64(0));
+  EXPECT_EQ(packet.getPacketLength(), packet.size());
+}
@@ -0,0 +1,114 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QTemporaryDir>
+
+// Local header files
+#include "storage/blobstore/blobstore.hpp"
+#include "storage/history/history.hpp"
+#include "utility/functions/blobs/blobs.hpp"
+
+/**
+ * @brief testing the references and the history of the BlobStore
+ */
+TEST(BlobStore, TestingRefCount) {
+  // using the BlobStore and History
+  using srilakshmikanthanp::clipbirdesk::storage::BlobStore;
+  using srilakshmikanthanp::clipbirdesk::storage::History;
+
+  // directory of the history
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+
+  // payloads to store
+  const auto image = QByteArray(4096, 'x');
+  const auto text  = QByteArray("Hello World");
+
+  // creating the store
+  BlobStore store;
+
+  // the same payload is kept once
+  const auto hash = store.put(image);
+  EXPECT_EQ(store.put(image), hash);
+  EXPECT_EQ(store.size(), 1);
+  EXPECT_EQ(store.getRefCount(hash), 2);
+  EXPECT_EQ(store.get(hash), image);
+
+  // dropped on the last reference
+  store.release(hash);
+  EXPECT_TRUE(store.has(hash));
+  store.release(hash);
+  EXPECT_FALSE(store.has(hash));
+  EXPECT_THROW(store.get(hash), std::out_of_range);
+
+  // the offers are released after the newer ones
+  const auto offered = store.offer(text);
+  for (auto i = 0; i < BlobStore::maxOffered - 1; i++) store.offer(QByteArray::number(i));
+  EXPECT_TRUE(store.has(offered));
+  store.offer("newest");
+  EXPECT_FALSE(store.has(offered));
+
+  // the payloads in the history are found
+  History history(dir.path());
+  history.add({{"image/png", image}, {"text/plain", text}}, "peer");
+  history.waitForIdle();
+  store.setHistory(&history);
+  EXPECT_TRUE(store.has(BlobStore::hashOf(image)));
+  EXPECT_EQ(store.get(BlobStore::hashOf(text)), text);
+
+  // the payload is shared by the entries of the history
+  history.add({{"image/png", image}}, "peer");
+  history.waitForIdle();
+  const auto entries = history.getEntries();
+  EXPECT_EQ(entries.at(0).items.at(0).offset, entries.at(1).items.at(0).offset);
+}
+
+/**
+ * @brief testing the have and want of the payloads
+ */
+TEST(BlobStore, TestingHaveAndWant) {
+  // using the BlobStore and SyncingItem
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingItem;
+  using srilakshmikanthanp::clipbirdesk::storage::BlobStore;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // stores of the sender and the receiver
+  BlobStore sender, receiver;
+
+  // items to sync
+  const QVector<QPair<QString, QByteArray>> items = {
+    {"text/plain", "Hello World"},
+    {"image/png", QByteArray(4096, 'x')},
+  };
+
+  // the large payload is sent by the hash
+  const auto packet = createSyncingPacket(items, 42, sender);
+  EXPECT_EQ(packet.getSyncId(), 42u);
+  EXPECT_EQ(packet.getItems().at(0).getEncoding(), SyncingItem::Encoding::Inline);
+  EXPECT_EQ(packet.getItems().at(1).getEncoding(), SyncingItem::Encoding::Reference);
+  EXPECT_LT(packet.size(), 256);
+
+  // the receiver wants the payload
+  const auto missing = getMissingBlobs(packet, receiver);
+  ASSERT_EQ(missing.size(), 1);
+  EXPECT_THROW(resolveItems(packet, receiver), std::out_of_range);
+
+  // the sender has the payload
+  const auto blobs = getBlobs(missing, sender);
+  ASSERT_EQ(blobs.size(), 1);
+
+  // the receiver has all the payloads
+  receiver.put(blobs.first());
+  EXPECT_TRUE(getMissingBlobs(packet, receiver).isEmpty());
+  EXPECT_EQ(resolveItems(packet, receiver), items);
+}
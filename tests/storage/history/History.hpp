@@ -0,0 +1,118 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+
+// Local header files
+#include "storage/history/history.hpp"
+
+/**
+ * @brief testing the add, dedupe and restore of the History
+ */
+TEST(History, TestingAddAndRestore) {
+  // using the History
+  using srilakshmikanthanp::clipbirdesk::storage::History;
+
+  // directory of the history
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+
+  // items to add
+  const QVector<QPair<QString, QByteArray>> text  = {{"text/plain", "Hello World"}};
+  const QVector<QPair<QString, QByteArray>> image = {{"image/png", QByteArray(4096, 'x')}};
+
+  // creating the history
+  History history(dir.path());
+
+  // count the entries added, read once the thread is idle
+  auto added        = 0;
+  const auto slot_a = [&](QByteArray, QVector<QPair<QString, QByteArray>>) { added++; };
+  QObject::connect(&history, &History::OnAdded, slot_a);
+
+  // the same as the newest is ignored
+  history.add(text, "peer-a");
+  history.add(text, "peer-b");
+  history.add(image, "peer-b");
+  history.add(text, "peer-c");
+  history.waitForIdle();
+  EXPECT_EQ(added, 3);
+
+  // check the entries
+  const auto entries = history.getEntries();
+  ASSERT_EQ(entries.size(), 3);
+  EXPECT_EQ(entries.at(0).origin, "peer-a");
+  EXPECT_EQ(entries.at(2).origin, "peer-c");
+
+  // the same content is stored once
+  EXPECT_EQ(entries.at(0).items.at(0).offset, entries.at(2).items.at(0).offset);
+
+  // check the restore
+  EXPECT_EQ(history.restore(1), image);
+  EXPECT_EQ(history.restore(2), text);
+
+  // check the limited read
+  EXPECT_EQ(history.read(entries.at(0).items.at(0), 5), QByteArray("Hello"));
+
+  // the entries are loaded again
+  History loaded(dir.path());
+  ASSERT_EQ(loaded.getEntries().size(), 3);
+  EXPECT_EQ(loaded.restore(1), image);
+}
+
+/**
+ * @brief testing the compaction and recovery of the History
+ */
+TEST(History, TestingCompactAndRecover) {
+  // using the History
+  using srilakshmikanthanp::clipbirdesk::storage::History;
+
+  // directory of the history
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+
+  // creating the history limited to 10KB
+  History history(dir.path());
+  history.setLimits(10 * 1024, 60 * 1000);
+
+  // add 1KB items
+  for (auto i = 0; i < 20; i++) {
+    history.add({{"text/plain", QByteArray(1024, 'a' + i)}}, "peer");
+  }
+
+  // the item larger than the log is not kept
+  history.add({{"image/png", QByteArray(11 * 1024, 'x')}}, "peer");
+  history.waitForIdle();
+
+  // only the newest are kept
+  const auto entries = history.getEntries();
+  ASSERT_FALSE(entries.isEmpty());
+  EXPECT_LT(entries.size(), 20);
+  EXPECT_EQ(history.restore(entries.size() - 1).at(0).second, QByteArray(1024, 'a' + 19));
+
+  // tear the last record of the index
+  {
+    QFile index(dir.filePath("index"));
+    ASSERT_TRUE(index.open(QIODevice::ReadWrite));
+    index.resize(index.size() - 3);
+  }
+
+  // the torn record is dropped
+  History loaded(dir.path());
+  ASSERT_EQ(loaded.getEntries().size(), entries.size() - 1);
+  EXPECT_EQ(loaded.restore(0).at(0).second, history.restore(0).at(0).second);
+
+  // the history can be added to again
+  loaded.add({{"text/plain", "after"}}, "peer");
+  loaded.waitForIdle();
+  EXPECT_EQ(History(dir.path()).getEntries().size(), entries.size());
+}
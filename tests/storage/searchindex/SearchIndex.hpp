@@ -0,0 +1,63 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QTemporaryDir>
+
+// Local header files
+#include "storage/searchindex/searchindex.hpp"
+
+/**
+ * @brief testing the search and load of the SearchIndex
+ */
+TEST(SearchIndex, TestingSearchAndLoad) {
+  // using the SearchIndex
+  using srilakshmikanthanp::clipbirdesk::storage::SearchIndex;
+
+  // directory of the index
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+
+  // file of the index
+  const auto file = dir.filePath("search");
+
+  // hashes of the documents
+  const QByteArray url = "url", html = "html", image = "image";
+
+  // creating the index
+  {
+    SearchIndex index(file);
+    index.load({});
+    index.add(url, {{"text/plain", "See https://example.com/Path?q=1"}});
+    index.add(html, {{"text/html", "<p>Meeting at <b>10&amp;30</b></p>"}});
+    index.add(image, {{"image/png", QByteArray(16, 'x')}});
+    index.waitForIdle();
+
+    // substring, prefix and case are matched
+    EXPECT_EQ(index.search("example.com/path"), QList<QByteArray>{url});
+    EXPECT_EQ(index.search("HTTPS"), QList<QByteArray>{url});
+    EXPECT_EQ(index.search("at 10&30"), QList<QByteArray>{html});
+
+    // short queries are scanned from the newest
+    EXPECT_EQ(index.search("e"), (QList<QByteArray>{html, url}));
+    EXPECT_EQ(index.search("e", 1), QList<QByteArray>{html});
+
+    // trigrams in another order are not matched
+    EXPECT_TRUE(index.search("path?q=2").isEmpty());
+    EXPECT_TRUE(index.search("png").isEmpty());
+  }
+
+  // the content that is gone is dropped on load
+  SearchIndex index(file);
+  index.load({url});
+  index.waitForIdle();
+  EXPECT_EQ(index.search("example"), QList<QByteArray>{url});
+  EXPECT_TRUE(index.search("meeting").isEmpty());
+}
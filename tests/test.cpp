@@ -6,15 +6,68 @@
 // Google test header files
 #include <gtest/gtest.h>
 
+// Qt header files
+#include <QGuiApplication>
+
+// C++ header files
+#include <cstdlib>
+
 // Local header files
+#include "tests/clipboard/Clipboard.hpp"
+#include "tests/clipboard/MimeData.hpp"
+#include "tests/common/Allocations.hpp"
+#include "tests/network/packets/BlobPacket.hpp"
+#include "tests/network/packets/ChunkPacket.hpp"
 #include "tests/network/packets/DiscoveryPacket.hpp"
+#include "tests/network/packets/FilterPacket.hpp"
+#include "tests/network/packets/HelloPacket.hpp"
 #include "tests/network/packets/InvalidRequest.hpp"
 #include "tests/network/packets/SyncingPacket.hpp"
+#include "tests/network/resolver/Resolver.hpp"
+#include "tests/network/syncing/Encoder.hpp"
+#include "tests/network/syncing/Generation.hpp"
+#include "tests/network/syncing/Mesh.hpp"
+#include "tests/network/syncing/Negotiation.hpp"
+#include "tests/storage/blobstore/BlobStore.hpp"
+#include "tests/storage/history/History.hpp"
+#include "tests/storage/searchindex/SearchIndex.hpp"
+#include "tests/ui/gui/models/HostsModel.hpp"
+#include "tests/utility/functions/Delta.hpp"
+#include "tests/utility/functions/SslCert.hpp"
+#include "tests/utility/metrics/Metrics.hpp"
+
+// Qt containers allocate with malloc/realloc so the large ones
+// are counted by hooking the glibc allocator
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_realloc(void* ptr, std::size_t size);
+
+/**
+ * @brief Count the large allocation and forward to the glibc malloc
+ */
+extern "C" void* malloc(std::size_t size) {
+  if (size >= largeAllocationSize) largeAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+/**
+ * @brief Count the large allocation and forward to the glibc realloc
+ */
+extern "C" void* realloc(void* ptr, std::size_t size) {
+  if (size >= largeAllocationSize) largeAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+#endif
 
 /**
  * @brief Testing the clipbirdesk Application
  */
 auto main(int argc, char **argv) -> int {
+  // the clipboard tests don't need a display
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  // create the application
+  QGuiApplication app(argc, argv);
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,98 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QHostAddress>
+#include <QList>
+#include <QModelIndex>
+
+// Local header files
+#include "ui/gui/models/hostsmodel/hostsmodel.hpp"
+
+/**
+ * @brief testing the HostsModel notifies only the rows that differ
+ */
+TEST(HostsModel, TestingReconcile) {
+  // using the HostsModel
+  using srilakshmikanthanp::clipbirdesk::ui::gui::models::HostsModel;
+
+  // hosts of the tests
+  const auto a = HostsModel::Value{QHostAddress("10.0.0.1"), 1, HostsModel::Action::Connect};
+  const auto b = HostsModel::Value{QHostAddress("10.0.0.2"), 2, HostsModel::Action::Connect};
+  const auto c = HostsModel::Value{QHostAddress("10.0.0.3"), 3, HostsModel::Action::Connect};
+  const auto d = HostsModel::Value{QHostAddress("10.0.0.4"), 4, HostsModel::Action::Connect};
+
+  // the host b when it is connected
+  auto connected         = b;
+  std::get<2>(connected) = HostsModel::Action::Disconnect;
+
+  // creating the model
+  HostsModel model;
+
+  // count the notified rows
+  int inserted = 0, removed = 0, moved = 0, changed = 0;
+
+  // count the inserted rows
+  const auto signal_i = &HostsModel::rowsInserted;
+  const auto slot_i   = [&](const QModelIndex &, int first, int last) {
+    inserted += last - first + 1;
+  };
+  QObject::connect(&model, signal_i, slot_i);
+
+  // count the removed rows
+  const auto signal_r = &HostsModel::rowsRemoved;
+  const auto slot_r   = [&](const QModelIndex &, int first, int last) {
+    removed += last - first + 1;
+  };
+  QObject::connect(&model, signal_r, slot_r);
+
+  // count the moved rows
+  const auto signal_m = &HostsModel::rowsMoved;
+  const auto slot_m   = [&](const QModelIndex &, int first, int last, const QModelIndex &, int) {
+    moved += last - first + 1;
+  };
+  QObject::connect(&model, signal_m, slot_m);
+
+  // count the changed rows
+  const auto signal_c = &HostsModel::dataChanged;
+  const auto slot_c   = [&](const QModelIndex &first, const QModelIndex &last) {
+    changed += last.row() - first.row() + 1;
+  };
+  QObject::connect(&model, signal_c, slot_c);
+
+  // the first list is inserted
+  model.setHosts({a, b, c});
+  EXPECT_EQ(inserted, 3);
+  EXPECT_EQ(model.getAllHosts(), (QList<HostsModel::Value>{a, b, c}));
+
+  // the same list notifies nothing
+  model.setHosts({a, b, c});
+  EXPECT_EQ(inserted + removed + moved + changed, 3);
+
+  // c is removed, d is inserted in the middle and b is changed
+  model.setHosts({a, d, connected});
+  EXPECT_EQ(inserted, 4);
+  EXPECT_EQ(removed, 1);
+  EXPECT_EQ(moved, 0);
+  EXPECT_EQ(changed, 1);
+  EXPECT_EQ(model.getAllHosts(), (QList<HostsModel::Value>{a, d, connected}));
+
+  // the reordered list moves the rows and keeps the duplicates out
+  model.setHosts({connected, a, d, a});
+  EXPECT_EQ(inserted, 4);
+  EXPECT_EQ(removed, 1);
+  EXPECT_EQ(moved, 1);
+  EXPECT_EQ(changed, 1);
+  EXPECT_EQ(model.getAllHosts(), (QList<HostsModel::Value>{connected, a, d}));
+
+  // the rows have the data of the hosts
+  EXPECT_EQ(model.rowCount(), 3);
+  EXPECT_EQ(model.data(model.index(1), HostsModel::AddressRole).toString(), "10.0.0.1");
+  EXPECT_EQ(model.data(model.index(2), HostsModel::PortRole).toInt(), 4);
+}
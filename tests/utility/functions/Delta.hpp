@@ -0,0 +1,102 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+#include <QHash>
+#include <QRandomGenerator>
+
+// Local header files
+#include "storage/blobstore/blobstore.hpp"
+#include "utility/functions/blobs/blobs.hpp"
+#include "utility/functions/delta/delta.hpp"
+
+/**
+ * @brief testing the create and apply of the delta
+ */
+TEST(Delta, TestingCreateAndApply) {
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // text of 256KB
+  QByteArray base;
+  QRandomGenerator random(42);
+  while (base.size() < 256 * 1024) base += QByteArray::number(random.generate(), 36) + ' ';
+
+  // the section grows, is edited in the middle and is replaced
+  const auto grown    = base + "one more paragraph";
+  const auto edited   = QByteArray(base).replace(1000, 10, "edit").insert(90000, "insert");
+  const auto replaced = QByteArray("something else");
+
+  // the delta of the edits is small
+  EXPECT_LT(createDelta(base, grown).size(), 64);
+  EXPECT_LT(createDelta(base, edited).size(), 256);
+
+  // the delta gives the target
+  for (const auto &target : {grown, edited, replaced, QByteArray(), base.left(10)}) {
+    EXPECT_EQ(applyDelta(base, createDelta(base, target)), target);
+  }
+
+  // the delta against an empty base has the whole target
+  EXPECT_EQ(applyDelta(QByteArray(), createDelta(QByteArray(), grown)), grown);
+
+  // a malformed delta is rejected
+  const auto delta = createDelta(base, edited);
+  EXPECT_THROW(applyDelta(base, delta.left(delta.size() - 1)), std::invalid_argument);
+  EXPECT_THROW(applyDelta(base.left(100), delta), std::invalid_argument);
+}
+
+/**
+ * @brief testing the delta of the syncing packet
+ */
+TEST(Delta, TestingSyncingPacket) {
+  // using the BlobStore and SyncingItem
+  using srilakshmikanthanp::clipbirdesk::network::packets::SyncingItem;
+  using srilakshmikanthanp::clipbirdesk::storage::BlobStore;
+
+  // using functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // stores and bases of the sender and the receiver
+  BlobStore sender, receiver;
+  QHash<QString, QByteArray> senderBases, receiverBases;
+
+  // first and second version of the text
+  const QVector<QPair<QString, QByteArray>> first  = {{"text/plain", QByteArray(8192, 'a')}};
+  const QVector<QPair<QString, QByteArray>> second = {{"text/plain", first[0].second + "b"}};
+
+  // the first version has no base so it is a reference
+  const auto packet1 = createSyncingPacket(first, 1, sender, senderBases);
+  EXPECT_EQ(packet1.getItems().at(0).getEncoding(), SyncingItem::Encoding::Reference);
+
+  // the receiver wants and gets it
+  for (const auto &blob : getBlobs(getMissingBlobs(packet1, receiver), sender)) receiver.put(blob);
+  EXPECT_EQ(resolveItems(packet1, receiver), first);
+
+  // both have the first version as the base
+  updateBases(senderBases, first, sender);
+  updateBases(receiverBases, first, receiver);
+
+  // the second version is a delta
+  const auto packet2 = createSyncingPacket(second, 2, sender, senderBases);
+  EXPECT_EQ(packet2.getItems().at(0).getEncoding(), SyncingItem::Encoding::Delta);
+  EXPECT_LT(packet2.size(), 256);
+
+  // the receiver applies it to the base
+  EXPECT_TRUE(getMissingBlobs(packet2, receiver).isEmpty());
+  EXPECT_EQ(resolveItems(packet2, receiver), second);
+
+  // without the base the receiver wants the payload
+  releaseBases(receiverBases, receiver);
+  receiver.release(BlobStore::hashOf(first[0].second));
+  ASSERT_FALSE(receiver.has(BlobStore::hashOf(first[0].second)));
+  const auto missing = getMissingBlobs(packet2, receiver);
+  ASSERT_EQ(missing.size(), 1);
+  EXPECT_EQ(missing.first(), BlobStore::hashOf(second[0].second));
+}
@@ -0,0 +1,51 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+// Local header files
+#include "utility/functions/sslcert/sslcert.hpp"
+
+/**
+ * @brief testing the identity kept across the restarts
+ */
+TEST(SslCert, TestingPersistedIdentity) {
+  // using the functions namespace
+  using namespace srilakshmikanthanp::clipbirdesk::utility::functions;
+
+  // directory of the identity
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+
+  // fingerprint of the certificate the peers pin
+  const auto fingerprint = [](const QSslConfiguration& config) {
+    return config.localCertificate().digest(QCryptographicHash::Sha256);
+  };
+
+  // the first call generates and the second loads the identity
+  const auto first  = getQSslConfiguration(dir.path());
+  const auto second = getQSslConfiguration(dir.path());
+  EXPECT_FALSE(fingerprint(first).isEmpty());
+  EXPECT_EQ(fingerprint(first), fingerprint(second));
+  EXPECT_EQ(first.privateKey(), second.privateKey());
+
+  // the key is readable only by the owner
+  const auto keyFile = QDir(dir.path()).filePath("identity.key");
+  const auto perms   = QFile::permissions(keyFile);
+  EXPECT_FALSE(perms.testFlag(QFile::ReadGroup));
+  EXPECT_FALSE(perms.testFlag(QFile::ReadOther));
+
+  // the broken identity is generated again
+  QFile::remove(keyFile);
+  EXPECT_NE(fingerprint(getQSslConfiguration(dir.path())), fingerprint(first));
+}
@@ -0,0 +1,73 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Google test header files
+#include <gtest/gtest.h>
+
+// Qt header files
+#include <QByteArray>
+
+// Local header files
+#include "utility/metrics/metrics.hpp"
+
+/**
+ * @brief testing the buckets of the Histogram
+ */
+TEST(Metrics, TestingHistogramBuckets) {
+  // using the Histogram
+  using srilakshmikanthanp::clipbirdesk::metrics::Histogram;
+
+  // every value is below the upper bound of its bucket and
+  // above the upper bound of the previous bucket
+  for (quint64 value : {0ull, 1ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, ~0ull}) {
+    const auto bucket = Histogram::bucketOf(value);
+    EXPECT_LT(bucket, Histogram::bucketCount);
+    EXPECT_LE(value, Histogram::upperBoundOf(bucket));
+    if (bucket > 0) EXPECT_GT(value, Histogram::upperBoundOf(bucket - 1));
+  }
+
+  // creating the histogram
+  Histogram histogram;
+
+  // record 1 - 1000
+  for (quint64 i = 1; i <= 1000; i++) histogram.record(i);
+
+  // check the count and sum
+  EXPECT_EQ(histogram.count(), 1000);
+  EXPECT_EQ(histogram.sum(), 500500);
+
+  // check the quantiles are within the precision
+  EXPECT_NEAR(histogram.quantile(0.5), 500, 500 * 0.125);
+  EXPECT_NEAR(histogram.quantile(0.99), 990, 990 * 0.125);
+}
+
+/**
+ * @brief testing the prometheus export of the Registry
+ */
+TEST(Metrics, TestingPrometheusExport) {
+  // using the Registry
+  using srilakshmikanthanp::clipbirdesk::metrics::Registry;
+
+  // registry of the process
+  auto &registry = Registry::instance();
+
+  // record some metrics
+  registry.counter("test_packets_total", {{"peer", "1.2.3.4"}}).inc(3);
+  registry.gauge("test_pending").set(2);
+  registry.histogram("test_decode_ns").record(100);
+
+  // same series is returned for the same labels
+  EXPECT_EQ(&registry.gauge("test_pending"), &registry.gauge("test_pending"));
+
+  // export the metrics
+  const auto text = registry.toPrometheus();
+
+  // check the series
+  EXPECT_TRUE(text.contains("# TYPE test_packets_total counter\n"));
+  EXPECT_TRUE(text.contains("test_packets_total{peer=\"1.2.3.4\"} 3\n"));
+  EXPECT_TRUE(text.contains("test_pending 2\n"));
+  EXPECT_TRUE(text.contains("test_decode_ns_count 1\n"));
+}
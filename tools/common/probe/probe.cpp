@@ -0,0 +1,131 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "probe.hpp"
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace srilakshmikanthanp::clipbirdesk::tools {
+/**
+ * @brief Parse the name of the workload (repeat, unique or edit)
+ *
+ * @param name name of the workload
+ * @return std::optional<Workload> workload or nullopt if unknown
+ */
+std::optional<Workload> parseWorkload(const QString& name) {
+  if (name == "repeat") return Workload::Repeat;
+  if (name == "unique") return Workload::Unique;
+  if (name == "edit") return Workload::Edit;
+  return std::nullopt;
+}
+
+/**
+ * @brief Get the payload of the next sync from the previous one
+ *
+ * @param workload how the payload changes
+ * @param previous payload of the previous sync
+ * @param seq sequence of the sync
+ * @param item index of the item in the sync
+ */
+QByteArray nextPayload(Workload workload, const QByteArray& previous, quint64 seq, quint64 item) {
+  // the same bytes again
+  if (workload == Workload::Repeat) return previous;
+
+  // stamp of the sync and the item in big endian
+  char stamp[sizeof(seq) + sizeof(item)];
+  qToBigEndian(seq, stamp);
+  qToBigEndian(item, stamp + sizeof(seq));
+
+  // the edit changes a copy of the previous payload
+  auto payload = previous;
+  auto data    = payload.data();
+
+  // the edit stamps the start and unique all of the payload
+  const auto end = workload == Workload::Edit ? std::min(payload.size(), qsizetype(sizeof(stamp)))
+                                              : payload.size();
+
+  // write the stamp
+  for (qsizetype at = 0; at < end; at += sizeof(stamp)) {
+    std::memcpy(data + at, stamp, std::min(end - at, qsizetype(sizeof(stamp))));
+  }
+
+  // return the payload
+  return payload;
+}
+
+/**
+ * @brief Create the items with the probe as first item
+ * followed by the payload items
+ *
+ * @param probe sequence and send time
+ * @param payloads payload of each item
+ */
+QVector<QPair<QString, QByteArray>> createProbeItems(
+    const Probe& probe, const QList<QByteArray>& payloads
+) {
+  // create the items
+  QVector<QPair<QString, QByteArray>> items;
+
+  // reserve the memory
+  items.reserve(payloads.size() + 1);
+
+  // sequence and send time in big endian
+  QByteArray data(sizeof(probe.seq) + sizeof(probe.sentAt), Qt::Uninitialized);
+  qToBigEndian(probe.seq, data.data());
+  qToBigEndian(probe.sentAt, data.data() + sizeof(probe.seq));
+
+  // add the probe
+  items.append({probeMime, data});
+
+  // add the payload items
+  for (const auto& payload : payloads) items.append({"text/plain", payload});
+
+  // return the items
+  return items;
+}
+
+/**
+ * @brief Read the probe from the items
+ *
+ * @param items received items
+ * @return std::optional<Probe> probe or nullopt if not a probe
+ */
+std::optional<Probe> readProbe(const QVector<QPair<QString, QByteArray>>& items) {
+  // check the first item is a probe
+  if (items.isEmpty() || items.first().first != probeMime) return std::nullopt;
+
+  // data of the probe
+  const auto& data = items.first().second;
+
+  // check the size
+  if (data.size() != sizeof(quint64) + sizeof(qint64)) return std::nullopt;
+
+  // read the probe
+  return Probe{
+      qFromBigEndian<quint64>(data.constData()),
+      qFromBigEndian<qint64>(data.constData() + sizeof(quint64)),
+  };
+}
+
+/**
+ * @brief Get the nearest rank percentile from sorted samples
+ *
+ * @param samples sorted samples
+ * @param p percentile in range 0 - 1
+ */
+qint64 percentile(const std::vector<qint64>& samples, double p) {
+  // if no samples then zero
+  if (samples.empty()) return 0;
+
+  // nearest rank of the percentile
+  const auto rank = static_cast<std::size_t>(std::ceil(p * samples.size()));
+
+  // return the sample
+  return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::tools
@@ -0,0 +1,83 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtEndian>
+
+// C++ headers
+#include <optional>
+#include <vector>
+
+namespace srilakshmikanthanp::clipbirdesk::tools {
+/// @brief Mime type of the item that carries the probe
+inline constexpr const char* probeMime = "application/x-clipbird-probe";
+
+/// @brief Sequence and send time (ns) carried by the probe
+struct Probe {
+  quint64 seq;
+  qint64 sentAt;
+};
+
+/**
+ * @brief How the payloads change from a sync to the next, repeat
+ * sends the same bytes so after the first sync only the dedup of
+ * the references is measured, unique stamps the sync all over the
+ * payload so neither the dedup nor the delta can skip any of it,
+ * edit stamps it only at the start so the payload goes as a delta
+ */
+enum class Workload { Repeat, Unique, Edit };
+
+/**
+ * @brief Parse the name of the workload (repeat, unique or edit)
+ *
+ * @param name name of the workload
+ * @return std::optional<Workload> workload or nullopt if unknown
+ */
+std::optional<Workload> parseWorkload(const QString& name);
+
+/**
+ * @brief Get the payload of the next sync from the previous one
+ *
+ * @param workload how the payload changes
+ * @param previous payload of the previous sync
+ * @param seq sequence of the sync
+ * @param item index of the item in the sync
+ */
+QByteArray nextPayload(Workload workload, const QByteArray& previous, quint64 seq, quint64 item);
+
+/**
+ * @brief Create the items with the probe as first item
+ * followed by the payload items
+ *
+ * @param probe sequence and send time
+ * @param payloads payload of each item
+ */
+QVector<QPair<QString, QByteArray>> createProbeItems(
+    const Probe& probe, const QList<QByteArray>& payloads
+);
+
+/**
+ * @brief Read the probe from the items
+ *
+ * @param items received items
+ * @return std::optional<Probe> probe or nullopt if not a probe
+ */
+std::optional<Probe> readProbe(const QVector<QPair<QString, QByteArray>>& items);
+
+/**
+ * @brief Get the nearest rank percentile from sorted samples
+ *
+ * @param samples sorted samples
+ * @param p percentile in range 0 - 1
+ */
+qint64 percentile(const std::vector<qint64>& samples, double p);
+}  // namespace srilakshmikanthanp::clipbirdesk::tools
@@ -0,0 +1,248 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+/**
+ * This File starts the loopback latency harness, it runs one
+ * syncing Server and N syncing Clients over TLS in this process
+ * and measures the time from Server::syncItems till the items
+ * are delivered to every client
+ */
+
+// Qt Headers
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QTextStream>
+#include <QTimer>
+
+// C++ Headers
+#include <algorithm>
+#include <vector>
+
+// Project Headers
+#include "network/syncing/client/client.hpp"
+#include "network/syncing/server/server.hpp"
+#include "tools/common/probe/probe.hpp"
+#include "utility/functions/sslcert/sslcert.hpp"
+#include "utility/tracing/tracing.hpp"
+
+using namespace srilakshmikanthanp::clipbirdesk;
+using namespace srilakshmikanthanp::clipbirdesk::tools;
+
+/**
+ * @brief main function that runs the harness for each of the
+ * payload sizes and prints p50/p99/p999 latency and throughput
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments
+ *
+ * @return int Status code
+ */
+auto main(int argc, char **argv) -> int {
+  // create the application
+  QCoreApplication app(argc, argv);
+
+  // command line parser
+  QCommandLineParser parser;
+
+  // command line options
+  const QCommandLineOption clientsOpt("clients", "Number of clients", "n", "4");
+  const QCommandLineOption sizesOpt("sizes", "Payload sizes in bytes", "list", "16,1024,1048576");
+  const QCommandLineOption itemsOpt("items", "Payload items per sync", "n", "1");
+  const QCommandLineOption countOpt("count", "Syncs per payload size", "n", "1000");
+  const QCommandLineOption timeoutOpt("timeout", "Give up after milliseconds", "ms", "300000");
+  const QCommandLineOption traceOpt("trace", "Write the spans as Chrome trace JSON", "file");
+  const QCommandLineOption workloadOpt("workload", "repeat, unique or edit", "w", "unique");
+
+  // add the options
+  parser.setApplicationDescription("Loopback end-to-end sync latency harness");
+  parser.addHelpOption();
+  parser.addOptions({clientsOpt, sizesOpt, itemsOpt, countOpt, timeoutOpt, traceOpt});
+  parser.addOption(workloadOpt);
+
+  // parse the arguments
+  parser.process(app);
+
+  // options values
+  const auto clients = std::max(1, parser.value(clientsOpt).toInt());
+  const auto items   = std::max(0, parser.value(itemsOpt).toInt());
+  const auto count   = std::max(1, parser.value(countOpt).toInt());
+  const auto name    = parser.value(workloadOpt);
+  const auto load    = parseWorkload(name);
+
+  // check the workload
+  if (!load) {
+    qCritical() << "Invalid workload" << name;
+    return 2;
+  }
+
+  // write the spans to the file if asked
+  if (parser.isSet(traceOpt) && tracing::start(parser.value(traceOpt))) {
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [] { tracing::stop(); });
+  }
+
+  // payload sizes
+  QList<qint64> sizes;
+  for (const auto &size : parser.value(sizesOpt).split(',', Qt::SkipEmptyParts)) {
+    sizes.append(size.toLongLong());
+  }
+
+  // output stream
+  QTextStream out(stdout);
+
+  // one configuration for every peer, the peers are
+  // accepted by the authenticators so it is not pinned
+  const auto config = utility::functions::getQSslConfiguration();
+
+  // accept every peer
+  const auto accept = [](auto, auto result) { result(true); };
+
+  // create and start the server
+  network::syncing::Server server;
+  server.setSSLConfiguration(config);
+  server.setAuthenticator(accept);
+  server.startServer();
+
+  // server address on loopback
+  const auto address = QPair<QHostAddress, quint16>(
+      QHostAddress::LocalHost, server.getServerInfo().second
+  );
+
+  // clock shared by the server and the clients
+  QElapsedTimer clock;
+  clock.start();
+
+  // state of the current round
+  quint64 seq       = 0;
+  qint64 sentAt     = 0;
+  int delivered     = 0;
+  int connected     = 0;
+  int sizeIndex     = 0;
+  bool started      = false;
+  qint64 roundBytes = 0;
+  std::vector<qint64> samples;
+  QList<QByteArray> payloads;
+  QElapsedTimer roundClock;
+
+  // start the next sync, the payloads change before the clock
+  const auto sendNext = [&]() {
+    delivered = 0;
+    ++seq;
+    for (qsizetype i = 0; i < payloads.size(); ++i) {
+      payloads[i] = nextPayload(*load, payloads[i], seq, quint64(i));
+    }
+    sentAt = clock.nsecsElapsed();
+    server.syncItems(createProbeItems({seq, sentAt}, payloads));
+  };
+
+  // payloads of the current size
+  const auto usePayloads = [&]() {
+    payloads = QList<QByteArray>(items, QByteArray(sizes[sizeIndex], 'x'));
+  };
+
+  // print the result of the size and go to next size
+  const auto finishSize = [&]() {
+    // elapsed time of the round
+    const auto elapsed = roundClock.nsecsElapsed();
+
+    // sort the samples
+    std::sort(samples.begin(), samples.end());
+
+    // throughput to all the clients in MB/s
+    const auto mbps = (roundBytes / 1e6) / (elapsed / 1e9);
+
+    // print the result
+    out << "size=" << sizes[sizeIndex] << " items=" << items << " workload=" << name
+        << " clients=" << clients
+        << " syncs=" << count << " p50_us=" << percentile(samples, 0.50) / 1000
+        << " p99_us=" << percentile(samples, 0.99) / 1000
+        << " p999_us=" << percentile(samples, 0.999) / 1000 << " throughput_mbps=" << mbps
+        << Qt::endl;
+
+    // reset the state
+    samples.clear();
+    roundBytes = 0;
+
+    // if no more sizes then quit
+    if (++sizeIndex >= sizes.size()) return QCoreApplication::quit();
+
+    // start the next size
+    usePayloads();
+    roundClock.start();
+    sendNext();
+  };
+
+  // record the delivery to one client
+  const auto onSync = [&](QVector<QPair<QString, QByteArray>> recv) {
+    // read the probe of the items
+    const auto probe = readProbe(recv);
+
+    // ignore the items that are not ours or late
+    if (!probe || probe->seq != seq) return;
+
+    // record the latency
+    samples.push_back(clock.nsecsElapsed() - probe->sentAt);
+
+    // record the bytes
+    for (const auto &[_, payload] : recv) roundBytes += payload.size();
+
+    // wait for all the clients
+    if (++delivered < clients) return;
+
+    // next sync or next size
+    if (samples.size() >= static_cast<std::size_t>(count) * clients) {
+      finishSize();
+    } else {
+      sendNext();
+    }
+  };
+
+  // start measuring once all the clients are connected on
+  // both ends, otherwise the first sync may miss a client
+  const auto startIfReady = [&]() {
+    if (started || connected < clients) return;
+    if (server.getConnectedClientsList().size() < clients) return;
+    if (sizes.isEmpty()) return QCoreApplication::quit();
+    started = true;
+    usePayloads();
+    roundClock.start();
+    sendNext();
+  };
+
+  // count the connected clients
+  const auto onConnected = [&](bool isConnected) {
+    if (isConnected) connected++;
+    startIfReady();
+  };
+
+  // server side of the clients
+  const auto onClients = [&](auto) { startIfReady(); };
+  QObject::connect(&server, &network::syncing::Server::OnClientListChanged, onClients);
+
+  // create and connect the clients
+  for (int i = 0; i < clients; i++) {
+    auto client = new network::syncing::Client(&app);
+    client->setSSLConfiguration(config);
+    client->setAuthenticator(accept);
+    QObject::connect(client, &network::syncing::Client::OnSyncRequest, onSync);
+    QObject::connect(client, &network::syncing::Client::OnServerStatusChanged, onConnected);
+    client->connectToServer(address);
+  }
+
+  // report the errors
+  const auto onError = [&](QString error) { qWarning() << error; };
+  QObject::connect(&server, &network::syncing::Server::OnErrorOccurred, onError);
+
+  // give up if it takes too long
+  QTimer::singleShot(parser.value(timeoutOpt).toInt(), &app, []() {
+    qCritical() << "Timed out";
+    QCoreApplication::exit(1);
+  });
+
+  // start the event loop
+  return app.exec();
+}
@@ -0,0 +1,471 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+/**
+ * This File starts the relay load generator, it runs a syncing
+ * Server on its own thread and opens many TLS clients to it that
+ * copy at the given rate and payload mix, every interval the
+ * server CPU, the RSS of the whole process, per-client queue depth
+ * and delivery lag are printed, with --max-p99 the exit code tells if the p99 lag
+ * is within the budget so it can be used as a CI smoke test
+ */
+
+// Qt Headers
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QHostAddress>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+
+// C++ Headers
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Platform Headers
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Project Headers
+#include "network/syncing/client/client.hpp"
+#include "network/syncing/server/server.hpp"
+#include "tools/common/probe/probe.hpp"
+#include "utility/functions/sslcert/sslcert.hpp"
+
+using namespace srilakshmikanthanp::clipbirdesk;
+using namespace srilakshmikanthanp::clipbirdesk::tools;
+
+/**
+ * @brief Get the CPU time of the calling thread in nanoseconds,
+ * where the per thread usage is not available the usage of the
+ * whole process is returned
+ */
+static qint64 threadCpuTime() {
+#if defined(Q_OS_UNIX)
+#if defined(RUSAGE_THREAD)
+  const auto who = RUSAGE_THREAD;
+#else
+  const auto who = RUSAGE_SELF;
+#endif
+  // get the usage
+  rusage usage{};
+  getrusage(who, &usage);
+
+  // user and system time
+  const auto user = qint64(usage.ru_utime.tv_sec) * 1000000 + usage.ru_utime.tv_usec;
+  const auto sys  = qint64(usage.ru_stime.tv_sec) * 1000000 + usage.ru_stime.tv_usec;
+
+  // return in nanoseconds
+  return (user + sys) * 1000;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Get the resident set size of the process in bytes, on
+ * the platforms without /proc the peak is returned, the clients
+ * run in the same process so it is not the size of the server
+ */
+static qint64 residentSize() {
+#if defined(Q_OS_LINUX)
+  // open the statm of the process
+  QFile statm("/proc/self/statm");
+
+  // read the resident pages
+  if (statm.open(QIODevice::ReadOnly)) {
+    const auto fields = statm.readAll().split(' ');
+    if (fields.size() > 1) return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+  }
+#endif
+#if defined(Q_OS_MACOS)
+  // peak usage in bytes
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+#elif defined(Q_OS_UNIX)
+  // peak usage in kilobytes
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return qint64(usage.ru_maxrss) * 1024;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Raise the open files limit to the hard limit, each
+ * client needs a few descriptors on both ends of the loopback
+ */
+static void raiseFileLimit() {
+#if defined(Q_OS_UNIX)
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+#endif
+}
+
+/**
+ * @brief Parse the payload mix of the form size:weight,...
+ *
+ * @param mix mix string
+ * @return QList<QPair<qint64, int>> size and weight
+ */
+static QList<QPair<qint64, int>> parseMix(const QString &mix) {
+  // parsed mix
+  QList<QPair<qint64, int>> parsed;
+
+  // parse the entries
+  for (const auto &entry : mix.split(',', Qt::SkipEmptyParts)) {
+    const auto parts  = entry.split(':');
+    const auto size   = parts[0].toLongLong();
+    const auto weight = parts.size() > 1 ? parts[1].toInt() : 1;
+    if (size >= 0 && weight > 0) parsed.append({size, weight});
+  }
+
+  // return the mix
+  return parsed;
+}
+
+/**
+ * @brief main function that runs the load and prints the
+ * report every interval and a summary at the end
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments
+ *
+ * @return int Status code
+ */
+auto main(int argc, char **argv) -> int {
+  // create the application
+  QCoreApplication app(argc, argv);
+
+  // command line parser
+  QCommandLineParser parser;
+
+  // command line options
+  const QCommandLineOption clientsOpt("clients", "Number of clients", "n", "200");
+  const QCommandLineOption rateOpt("rate", "Copies per second by all clients", "n", "10");
+  const QCommandLineOption mixOpt("mix", "Payload mix", "size:weight", "1024:8,65536:1");
+  const QCommandLineOption durationOpt("duration", "Seconds to copy", "s", "30");
+  const QCommandLineOption rampOpt("ramp", "Clients connected per 100ms", "n", "50");
+  const QCommandLineOption intervalOpt("interval", "Report interval", "ms", "1000");
+  const QCommandLineOption maxP99Opt("max-p99", "Fail if p99 lag is above", "ms", "0");
+  const QCommandLineOption timeoutOpt("connect-timeout", "Fail if not connected", "ms", "60000");
+  const QCommandLineOption workloadOpt("workload", "repeat, unique or edit", "w", "unique");
+
+  // add the options
+  parser.setApplicationDescription("Many-client relay load generator");
+  parser.addHelpOption();
+  parser.addOptions({clientsOpt, rateOpt, mixOpt, durationOpt});
+  parser.addOptions({rampOpt, intervalOpt, maxP99Opt, timeoutOpt, workloadOpt});
+
+  // parse the arguments
+  parser.process(app);
+
+  // options values
+  const auto clients  = std::max(1, parser.value(clientsOpt).toInt());
+  const auto rate     = std::max(0.0, parser.value(rateOpt).toDouble());
+  const auto mix      = parseMix(parser.value(mixOpt));
+  const auto duration = qint64(parser.value(durationOpt).toDouble() * 1000);
+  const auto ramp     = std::max(1, parser.value(rampOpt).toInt());
+  const auto interval = std::max(100, parser.value(intervalOpt).toInt());
+  const auto maxP99   = parser.value(maxP99Opt).toDouble();
+  const auto load     = parseWorkload(parser.value(workloadOpt));
+
+  // check the mix
+  if (mix.isEmpty()) {
+    qCritical() << "Invalid payload mix";
+    return 2;
+  }
+
+  // check the workload
+  if (!load) {
+    qCritical() << "Invalid workload" << parser.value(workloadOpt);
+    return 2;
+  }
+
+  // each client needs descriptors
+  raiseFileLimit();
+
+  // output stream
+  QTextStream out(stdout);
+
+  // last payload of each size, changed by the workload per copy
+  QHash<qint64, QByteArray> payloads;
+  for (const auto &[size, _] : mix) payloads.insert(size, QByteArray(size, 'x'));
+
+  // total weight of the mix
+  const auto totalWeight = std::accumulate(mix.begin(), mix.end(), 0, [](int s, const auto &m) {
+    return s + m.second;
+  });
+
+  // one configuration for every peer, the peers are
+  // accepted by the authenticators so it is not pinned
+  const auto config = utility::functions::getQSslConfiguration();
+
+  // accept every peer
+  const auto accept = [](auto, auto result) { result(true); };
+
+  // server runs on its own thread so its CPU can be measured
+  QThread serverThread;
+  auto server = new network::syncing::Server();
+  server->moveToThread(&serverThread);
+  QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+  serverThread.start();
+
+  // start the server on its thread
+  QString startError;
+  quint16 port = 0;
+  QMetaObject::invokeMethod(server, [&]() {
+    try {
+      server->setSSLConfiguration(config);
+      server->setAuthenticator(accept);
+      server->startServer();
+      port = server->getServerInfo().second;
+    } catch (const std::exception &e) {
+      startError = e.what();
+    }
+  }, Qt::BlockingQueuedConnection);
+
+  // stop the server thread on exit
+  const auto stopServer = [&]() {
+    serverThread.quit();
+    serverThread.wait();
+  };
+
+  // check the server is started
+  if (!startError.isEmpty()) {
+    qCritical() << startError;
+    stopServer();
+    return 2;
+  }
+
+  // clock shared by the server and the clients
+  QElapsedTimer clock;
+  clock.start();
+
+  // state of the load
+  QList<network::syncing::Client *> peers;
+  quint64 seq       = 0;
+  qint64 sent       = 0;
+  qint64 delivered  = 0;
+  qint64 errors     = 0;
+  int connected     = 0;
+  qint64 lastCpu    = 0;
+  qint64 lastWall   = 0;
+  std::vector<qint64> window;
+  std::vector<qint64> samples;
+  QElapsedTimer loadClock;
+
+  // timers of the load
+  QTimer rampTimer, sendTimer, reportTimer;
+
+  // record the delivery to one client
+  const auto onSync = [&](QVector<QPair<QString, QByteArray>> items) {
+    // read the probe of the items
+    const auto probe = readProbe(items);
+
+    // ignore the items that are not ours
+    if (!probe) return;
+
+    // record the lag
+    const auto lag = clock.nsecsElapsed() - probe->sentAt;
+    window.push_back(lag);
+    samples.push_back(lag);
+    delivered++;
+  };
+
+  // pick the payload size from the mix
+  const auto pickSize = [&]() {
+    auto point = QRandomGenerator::global()->bounded(totalWeight);
+    for (const auto &[size, weight] : mix) {
+      if ((point -= weight) < 0) return size;
+    }
+    return mix.last().first;
+  };
+
+  // next payload of the size picked from the mix
+  const auto pickPayload = [&](quint64 copy) {
+    auto &payload = payloads[pickSize()];
+    return payload = nextPayload(*load, payload, copy, 0);
+  };
+
+  // send the copies that are due from random clients
+  const auto onSend = [&]() {
+    // copies due till now
+    const auto due = qint64(rate * loadClock.elapsed() / 1000.0);
+
+    // send the copies
+    for (; sent < due; sent++) {
+      auto peer  = peers[QRandomGenerator::global()->bounded(peers.size())];
+      auto data  = pickPayload(++seq);
+      auto items = createProbeItems({seq, clock.nsecsElapsed()}, {data});
+      try {
+        peer->syncItems(items);
+      } catch (const std::exception &) {
+        errors++;
+      }
+    }
+  };
+
+  // get the server CPU time and backlog on its thread
+  const auto serverStats = [&]() {
+    QPair<qint64, QList<qint64>> stats;
+    QMetaObject::invokeMethod(server, [&]() {
+      stats = {threadCpuTime(), server->getClientsBacklog()};
+    }, Qt::BlockingQueuedConnection);
+    return stats;
+  };
+
+  // print the report of the interval
+  const auto onReport = [&]() {
+    // server stats
+    const auto [cpu, backlog] = serverStats();
+
+    // wall time of the interval
+    const auto wall    = clock.nsecsElapsed();
+
+    // server CPU usage of the interval in percent
+    const auto cpuUse  = 100.0 * (cpu - lastCpu) / std::max<qint64>(1, wall - lastWall);
+
+    // queue depth of the clients
+    const auto maxQ    = backlog.isEmpty() ? 0 : *std::max_element(backlog.begin(), backlog.end());
+    const auto sumQ    = std::accumulate(backlog.begin(), backlog.end(), qint64(0));
+
+    // lag of the interval
+    std::sort(window.begin(), window.end());
+
+    // print the report
+    out << "t_ms=" << loadClock.elapsed() << " clients=" << backlog.size() << " sent=" << sent
+        << " delivered=" << delivered << " cpu_pct=" << cpuUse
+        << " process_rss_mb=" << residentSize() / (1024 * 1024) << " queue_max_b=" << maxQ
+        << " queue_sum_b=" << sumQ << " lag_p50_ms=" << percentile(window, 0.50) / 1e6
+        << " lag_p99_ms=" << percentile(window, 0.99) / 1e6 << Qt::endl;
+
+    // reset the interval
+    window.clear();
+    lastCpu  = cpu;
+    lastWall = wall;
+  };
+
+  // print the summary and exit with the status
+  const auto finish = [&]() {
+    // stop the timers
+    sendTimer.stop();
+    reportTimer.stop();
+
+    // final report
+    onReport();
+
+    // lag of the whole run
+    std::sort(samples.begin(), samples.end());
+
+    // p99 of the whole run
+    const auto p99 = percentile(samples, 0.99) / 1e6;
+
+    // every other client gets every copy, the sender doesn't
+    const auto expected = sent * (clients - 1);
+
+    // print the summary
+    out << "summary workload=" << parser.value(workloadOpt) << " clients=" << clients
+        << " sent=" << sent << " delivered=" << delivered
+        << " expected=" << expected << " errors=" << errors
+        << " lag_p50_ms=" << percentile(samples, 0.50) / 1e6 << " lag_p99_ms=" << p99
+        << " lag_p999_ms=" << percentile(samples, 0.999) / 1e6 << Qt::endl;
+
+    // fail if over the budget or the copies are lost
+    const auto failed = (maxP99 > 0 && p99 > maxP99) || delivered < expected;
+
+    // exit with the status
+    QCoreApplication::exit(failed ? 1 : 0);
+  };
+
+  // wait for the deliveries in flight after the duration
+  const auto drain = [&]() {
+    // stop sending
+    sendTimer.stop();
+
+    // poll till all the copies are delivered
+    auto poll = new QTimer(&app);
+    QObject::connect(poll, &QTimer::timeout, [&, poll, until = clock.elapsed() + 10000]() {
+      if (delivered < sent * (clients - 1) && clock.elapsed() < until) return;
+      poll->stop();
+      finish();
+    });
+    poll->start(50);
+  };
+
+  // start the load once all the clients are connected
+  const auto onConnected = [&](bool isConnected) {
+    if (!isConnected || ++connected != clients) return;
+    out << "connected clients=" << clients << " in_ms=" << clock.elapsed() << Qt::endl;
+    lastCpu  = serverStats().first;
+    lastWall = clock.nsecsElapsed();
+    loadClock.start();
+    sendTimer.start(10);
+    reportTimer.start(interval);
+    QTimer::singleShot(duration, &app, drain);
+  };
+
+  // count the errors of the clients
+  const auto onError = [&](QString error) {
+    if (errors++ == 0) qWarning() << error;
+  };
+
+  // connect the clients in batches
+  const auto onRamp = [&]() {
+    for (int i = 0; i < ramp && peers.size() < clients; i++) {
+      auto peer = new network::syncing::Client(&app);
+      peer->setSSLConfiguration(config);
+      peer->setAuthenticator(accept);
+      QObject::connect(peer, &network::syncing::Client::OnSyncRequest, onSync);
+      QObject::connect(peer, &network::syncing::Client::OnServerStatusChanged, onConnected);
+      QObject::connect(peer, &network::syncing::Client::OnErrorOccurred, onError);
+      peer->connectToServer({QHostAddress::LocalHost, port});
+      peers.append(peer);
+    }
+
+    if (peers.size() >= clients) rampTimer.stop();
+  };
+
+  // connect the timers
+  QObject::connect(&rampTimer, &QTimer::timeout, onRamp);
+  QObject::connect(&sendTimer, &QTimer::timeout, onSend);
+  QObject::connect(&reportTimer, &QTimer::timeout, onReport);
+
+  // start connecting the clients
+  rampTimer.start(100);
+  onRamp();
+
+  // fail if the clients are not connected in time
+  QTimer::singleShot(parser.value(timeoutOpt).toInt(), &app, [&]() {
+    if (connected >= clients) return;
+    qCritical() << "Connected" << connected << "of" << clients << "clients";
+    QCoreApplication::exit(1);
+  });
+
+  // start the event loop
+  const auto status = app.exec();
+
+  // release the clients before the server
+  qDeleteAll(peers);
+
+  // stop the server
+  stopServer();
+
+  // return the status
+  return status;
+}
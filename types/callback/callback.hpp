@@ -7,11 +7,15 @@
 
 #include <QHostAddress>
 #include <QPair>
-#include <QTtypes>
+#include <QtTypes>
 
 #include <functional>
 
 namespace srilakshmikanthanp::clipbirdesk::types::callback {
-/// @brief Authenticator for server to authenticate the client
-using Authenticator = std::function<bool(QPair<QHostAddress, quint16>)>;
+/// @brief Callback that receives the result of the authentication
+using AuthResult    = std::function<void(bool)>;
+
+/// @brief Authenticator for server to authenticate the client, it must not
+/// block, the result is delivered later through the AuthResult callback
+using Authenticator = std::function<void(QPair<QHostAddress, quint16>, AuthResult)>;
 } // namespace srilakshmikanthanp::clipbirdesk::types::callback
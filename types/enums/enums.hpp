@@ -16,7 +16,8 @@ enum class IPType : quint8 {
 
 /// @brief Allowed Error Codes
 enum ErrorCode : quint8 {
-  CodingError = 0x01,
-  SSLError    = 0x02,
+  CodingError  = 0x01,
+  SSLError     = 0x02,
+  VersionError = 0x03,
 };
 }  // namespace srilakshmikanthanp::clipbirdesk::types::enums
@@ -6,6 +6,14 @@
 #include "host.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::ui::gui::components {
+/**
+ * @brief Handle the host name resolved by the resolver
+ * and update the host name if it is this host
+ */
+void Host::handleHostNameResolved(QHostAddress address, QString name) {
+  if (address == this->address) this->hostName->setText(name);
+}
+
 /**
  * @brief Construct a new Host object
  * with parent as QWidget
@@ -15,6 +23,11 @@ Host::Host(QWidget *parent) : QWidget(parent) {
   // connect the button signal to this signal
   QObject::connect(actBtn, &Button::clicked, [this]() { emit onAction(this->getHost()); });
 
+  // update the host name once it is resolved
+  const auto signal_r = &Resolver::OnHostNameResolved;
+  const auto slot_r   = &Host::handleHostNameResolved;
+  QObject::connect(Resolver::instance(), signal_r, this, slot_r);
+
   // create a layout to align the widgets
   QHBoxLayout *layout = new QHBoxLayout();
 
@@ -53,11 +66,11 @@ void Host::setHost(Host::Value host) {
   this->port      = std::get<1>(host);
   this->action    = std::get<2>(host);
 
-  // get the host info
-  const auto info = QHostInfo::fromName(address.toString());
+  // get the host name (cached or looked up asynchronously)
+  const auto name = Resolver::instance()->resolve(address);
 
   // set the host name
-  this->hostName->setText(info.hostName());
+  this->hostName->setText(name);
 
   // set the ip
   this->ip->setText(address.toString());
@@ -7,11 +7,11 @@
 
 #include <QHBoxLayout>
 #include <QHostAddress>
-#include <QHostInfo>
 #include <QVBoxLayout>
 #include <QWidget>
 #include <tuple>
 
+#include "network/resolver/resolver.hpp"
 #include "ui/gui/components/button/button.hpp"
 #include "ui/gui/components/label/label.hpp"
 
@@ -43,6 +43,10 @@ class Host : public QWidget {
   quint16 port;
   Action action;
 
+ private:  // typedefs
+
+  using Resolver = network::resolver::Resolver;
+
  private:  // Member variable
 
   Label *hostName = new Label(this);
@@ -53,6 +57,13 @@ class Host : public QWidget {
 
   Q_OBJECT
 
+ private:  // private slots
+
+  /**
+   * @brief Handle the host name resolved by the resolver
+   */
+  void handleHostNameResolved(QHostAddress address, QString name);
+
  public:  // public Member functions
 
   /**
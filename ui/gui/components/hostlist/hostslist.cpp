@@ -6,6 +6,30 @@
 #include "hostslist.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::ui::gui::components {
+/**
+ * @brief Get the key of the host
+ */
+HostsList::Key HostsList::keyOf(const Host::Value &host) {
+  return {std::get<0>(host), std::get<1>(host)};
+}
+
+/**
+ * @brief Create a Host view for the host
+ */
+Host *HostsList::createHostView(const Host::Value &host) {
+  // create a new host view
+  auto hostView = new components::Host(this);
+
+  // set the host
+  hostView->setHost(host);
+
+  // connect the host view signal to this signal
+  QObject::connect(hostView, &Host::onAction, [&](auto h) { emit onAction(h); });
+
+  // return the host view
+  return hostView;
+}
+
 HostsList::HostsList(QWidget *parent) : QWidget(parent) {
   // set the root layout for this widget
   this->setLayout(verticalLayout);
@@ -15,50 +39,111 @@ HostsList::HostsList(QWidget *parent) : QWidget(parent) {
 }
 
 /**
- * @brief Set the Hosts to the list
+ * @brief Set the Hosts to the list, only the rows that are
+ * inserted, removed, changed or moved are touched
  */
 void HostsList::setHosts(QList<Host::Value> hosts) {
-  // remove & add all the hosts
-  removeAllHosts();
-  for (auto host : hosts) addHost(host);
+  // keys of the new list
+  QSet<Key> keys;
+
+  // collect the keys
+  for (const auto &host : hosts) keys.insert(keyOf(host));
+
+  // remove the rows that are not in the new list
+  for (auto it = hostViews.begin(); it != hostViews.end();) {
+    if (keys.contains(it.key())) {
+      ++it;
+      continue;
+    }
+
+    verticalLayout->removeWidget(it.value());
+    it.value()->deleteLater();
+    it = hostViews.erase(it);
+  }
+
+  // keys that are already placed
+  QSet<Key> placed;
+
+  // position of the next row
+  int position = 0;
+
+  // insert or update the rows in the order of the list
+  for (const auto &host : hosts) {
+    // key of the host
+    const auto key = keyOf(host);
+
+    // skip the duplicates
+    if (placed.contains(key)) continue;
+
+    // mark as placed
+    placed.insert(key);
+
+    // find the existing view
+    auto hostView = hostViews.value(key, nullptr);
+
+    // if not exists then create and insert
+    if (hostView == nullptr) {
+      hostView = createHostView(host);
+      hostViews.insert(key, hostView);
+      verticalLayout->insertWidget(position++, hostView);
+      continue;
+    }
+
+    // update only if changed
+    if (hostView->getHost() != host) {
+      hostView->setHost(host);
+    }
+
+    // move only if the position is changed
+    if (verticalLayout->indexOf(hostView) != position) {
+      verticalLayout->removeWidget(hostView);
+      verticalLayout->insertWidget(position, hostView);
+    }
+
+    // next position
+    position++;
+  }
 }
 
 /**
  * @brief Get the All Hosts from the list
  */
 QList<components::Host::Value> HostsList::getAllHosts() {
-// cast the widget to host view
-#define CAST(x) dynamic_cast<components::Host *>(x)
-
   // create a list of hosts
   QList<Host::Value> hosts;
 
-  // iterate over the layout
+  // reserve the memory
+  hosts.reserve(verticalLayout->count());
+
+  // iterate over the layout to keep the order, all the
+  // widgets in the layout are created by this class
   for (int i = 0; i < verticalLayout->count(); i++) {
     auto currItem = verticalLayout->itemAt(i)->widget();
-    auto hostView = CAST(currItem);
+    auto hostView = static_cast<components::Host *>(currItem);
     hosts.append(hostView->getHost());
   }
 
   // return the list of hosts
   return hosts;
-
-// undefine the cast macro
-#undef CAST
 }
 
 /**
  * @brief Add Host to the list
  */
 void HostsList::addHost(Host::Value host) {
-  // create a new host view
-  auto hostView = new components::Host(this);
+  // key of the host
+  const auto key = keyOf(host);
 
-  // set the host
-  hostView->setHost(host);
+  // if already exists then just update it
+  if (auto hostView = hostViews.value(key, nullptr)) {
+    return hostView->setHost(host);
+  }
 
-  // connect the host view signal to this signal
-  QObject::connect(hostView, &Host::onAction, [&](auto h) { emit onAction(h); });
+  // create a new host view
+  auto hostView = createHostView(host);
+
+  // add the host view to the map
+  hostViews.insert(key, hostView);
 
   // add the host view to the layout
   verticalLayout->addWidget(hostView);
@@ -68,36 +153,30 @@ void HostsList::addHost(Host::Value host) {
  * @brief Remove a Host from the list
  */
 void HostsList::removeHost(Host::Value host) {
-// cast the widget to host view
-#define CAST(x) dynamic_cast<components::Host *>(x)
+  // take the host view from the map
+  auto hostView = hostViews.take(keyOf(host));
 
-  // iterate over the layout
-  for (int i = 0; i < verticalLayout->count(); i++) {
-    auto currItem = verticalLayout->itemAt(i)->widget();
-    auto hostView = CAST(currItem);
-    if (hostView->getHost() != host) continue;
-    verticalLayout->removeWidget(hostView);
-  }
+  // if not exists then return
+  if (hostView == nullptr) return;
+
+  // remove the host view from the layout
+  verticalLayout->removeWidget(hostView);
 
-// undefine the cast macro
-#undef CAST
+  // delete the host view
+  hostView->deleteLater();
 }
 
 /**
  * @brief Remove all Hosts from the list
  */
 void HostsList::removeAllHosts() {
-// cast the widget to host view
-#define CAST(x) dynamic_cast<components::Host *>(x)
-
-  // iterate over the layout
-  for (int i = 0; i < verticalLayout->count(); i++) {
-    auto currItem = verticalLayout->itemAt(i)->widget();
-    auto hostView = CAST(currItem);
+  // remove and delete all the host views
+  for (auto hostView : std::as_const(hostViews)) {
     verticalLayout->removeWidget(hostView);
+    hostView->deleteLater();
   }
 
-// undefine the cast macro
-#undef CAST
+  // clear the map
+  hostViews.clear();
 }
 }  // namespace srilakshmikanthanp::clipbirdesk::ui::gui::components
@@ -5,8 +5,11 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
+#include <QHash>
 #include <QHostAddress>
+#include <QPair>
 #include <QScrollArea>
+#include <QSet>
 #include <QWidget>
 
 #include "ui/gui/components/host/host.hpp"
@@ -32,19 +35,35 @@ class HostsList : public QWidget {
  public:  // Type alias
 
   using Action = components::Host::Action;
+  using Key    = QPair<QHostAddress, quint16>;
 
  private:  // Member Variables
 
   QVBoxLayout *verticalLayout = new QVBoxLayout(this);
+  QHash<Key, Host *> hostViews;
+
+ private:  // Member Functions
+
+  /**
+   * @brief Get the key of the host
+   */
+  static Key keyOf(const Host::Value &host);
+
+  /**
+   * @brief Create a Host view for the host
+   */
+  Host *createHostView(const Host::Value &host);
 
  public:  // Member Functions
 
   explicit HostsList(QWidget *parent = nullptr);
 
   /**
-   * @brief Set the Hosts to the list
+   * @brief Set the Hosts to the list, only the rows that are
+   * inserted, removed, changed or moved are touched
    */
   void setHosts(QList<Host::Value> hosts);
+
   /**
    * @brief Get the All Hosts from the list
    */
@@ -65,5 +84,4 @@ class HostsList : public QWidget {
    */
   void removeAllHosts();
 };
-#undef CAST
 }  // namespace srilakshmikanthanp::clipbirdesk::ui::gui::components
@@ -0,0 +1,172 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "hostsmodel.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::ui::gui::models {
+/**
+ * @brief Get the key of the host
+ */
+HostsModel::Key HostsModel::keyOf(const Value &host) {
+  return {std::get<0>(host), std::get<1>(host)};
+}
+
+/**
+ * @brief Find the row of the key from the given row
+ */
+int HostsModel::findRow(const Key &key, int from) const {
+  for (int i = from; i < hosts.size(); i++) {
+    if (keyOf(hosts[i]) == key) return i;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Handle the host name resolved by the resolver
+ */
+void HostsModel::handleHostNameResolved(QHostAddress address, QString name) {
+  for (int i = 0; i < hosts.size(); i++) {
+    if (std::get<0>(hosts[i]) != address) continue;
+    emit dataChanged(index(i), index(i), {Qt::DisplayRole});
+  }
+}
+
+/**
+ * @brief Construct a new Hosts Model object
+ *
+ * @param parent parent object
+ */
+HostsModel::HostsModel(QObject *parent) : QAbstractListModel(parent) {
+  const auto signal_r = &Resolver::OnHostNameResolved;
+  const auto slot_r   = &HostsModel::handleHostNameResolved;
+  QObject::connect(Resolver::instance(), signal_r, this, slot_r);
+}
+
+/**
+ * @brief Set the Hosts to the model, only the rows that are
+ * inserted, removed, changed or moved are notified
+ */
+void HostsModel::setHosts(const QList<Value> &newHosts) {
+  // keys of the new list
+  QSet<Key> incoming;
+
+  // reserve the memory
+  incoming.reserve(newHosts.size());
+
+  // collect the keys
+  for (const auto &host : newHosts) incoming.insert(keyOf(host));
+
+  // remove the rows that are not in the new list from
+  // the back so the row numbers stay valid
+  for (int i = hosts.size() - 1; i >= 0; i--) {
+    if (incoming.contains(keyOf(hosts[i]))) continue;
+    beginRemoveRows(QModelIndex(), i, i);
+    keys.remove(keyOf(hosts[i]));
+    hosts.removeAt(i);
+    endRemoveRows();
+  }
+
+  // keys that are already placed
+  QSet<Key> placed;
+
+  // position of the next row
+  int position = 0;
+
+  // insert, move or update the rows in the order of the list
+  for (const auto &host : newHosts) {
+    // key of the host
+    const auto key = keyOf(host);
+
+    // skip the duplicates
+    if (placed.contains(key)) continue;
+
+    // mark as placed
+    placed.insert(key);
+
+    // if not exists then insert at the position
+    if (!keys.contains(key)) {
+      beginInsertRows(QModelIndex(), position, position);
+      keys.insert(key);
+      hosts.insert(position, host);
+      endInsertRows();
+      position++;
+      continue;
+    }
+
+    // the rows before the position are placed so it is here or after
+    const auto row = findRow(key, position);
+
+    // move only if the position is changed
+    if (row != position) {
+      beginMoveRows(QModelIndex(), row, row, QModelIndex(), position);
+      hosts.move(row, position);
+      endMoveRows();
+    }
+
+    // update only if changed
+    if (hosts[position] != host) {
+      hosts[position] = host;
+      emit dataChanged(index(position), index(position));
+    }
+
+    // next position
+    position++;
+  }
+}
+
+/**
+ * @brief Get the All Hosts from the model
+ */
+QList<HostsModel::Value> HostsModel::getAllHosts() const {
+  return hosts;
+}
+
+/**
+ * @brief Get the number of rows
+ */
+int HostsModel::rowCount(const QModelIndex &parent) const {
+  return parent.isValid() ? 0 : hosts.size();
+}
+
+/**
+ * @brief Get the data of the row for the role
+ */
+QVariant HostsModel::data(const QModelIndex &index, int role) const {
+  // check the index is valid
+  if (!index.isValid() || index.row() >= hosts.size()) {
+    return QVariant();
+  }
+
+  // get the host of the row
+  const auto &[address, port, action] = hosts[index.row()];
+
+  // return the data for the role
+  switch (role) {
+  case Qt::DisplayRole:
+    return Resolver::instance()->resolve(address);
+  case AddressRole:
+    return address.toString();
+  case PortRole:
+    return port;
+  case ActionRole:
+    return static_cast<int>(action);
+  default:
+    return QVariant();
+  }
+}
+
+/**
+ * @brief Get the role names of the model
+ */
+QHash<int, QByteArray> HostsModel::roleNames() const {
+  return {
+      {Qt::DisplayRole, "hostName"},
+      {    AddressRole,  "address"},
+      {       PortRole,     "port"},
+      {     ActionRole,   "action"},
+  };
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::ui::gui::models
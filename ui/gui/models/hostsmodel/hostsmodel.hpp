@@ -0,0 +1,107 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+#include "network/resolver/resolver.hpp"
+#include "ui/gui/components/host/host.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::ui::gui::models {
+/**
+ * @brief List model of the hosts for the views that has to
+ * show large number of hosts, the rows are reconciled by the
+ * host key so only inserted, removed or changed rows are
+ * notified to the view
+ */
+class HostsModel : public QAbstractListModel {
+ public:  // Type alias
+
+  using Value    = components::Host::Value;
+  using Action   = components::Host::Action;
+  using Key      = QPair<QHostAddress, quint16>;
+  using Resolver = network::resolver::Resolver;
+
+ public:  // roles of the model
+
+  enum Roles { AddressRole = Qt::UserRole + 1, PortRole, ActionRole };
+
+ private:  // just for Qt
+
+  Q_OBJECT
+
+ private:  // disable copy and move
+
+  Q_DISABLE_COPY_MOVE(HostsModel)
+
+ private:  // Member Variables
+
+  QList<Value> hosts;
+  QSet<Key> keys;
+
+ private:  // Member Functions
+
+  /**
+   * @brief Get the key of the host
+   */
+  static Key keyOf(const Value &host);
+
+  /**
+   * @brief Find the row of the key from the given row
+   */
+  int findRow(const Key &key, int from) const;
+
+  /**
+   * @brief Handle the host name resolved by the resolver
+   */
+  void handleHostNameResolved(QHostAddress address, QString name);
+
+ public:  // Member Functions
+
+  /**
+   * @brief Construct a new Hosts Model object
+   *
+   * @param parent parent object
+   */
+  explicit HostsModel(QObject *parent = nullptr);
+
+  /**
+   * @brief Destroy the Hosts Model object
+   */
+  ~HostsModel() override = default;
+
+  /**
+   * @brief Set the Hosts to the model, only the rows that are
+   * inserted, removed, changed or moved are notified
+   */
+  void setHosts(const QList<Value> &newHosts);
+
+  /**
+   * @brief Get the All Hosts from the model
+   */
+  QList<Value> getAllHosts() const;
+
+  /**
+   * @brief Get the number of rows
+   */
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+  /**
+   * @brief Get the data of the row for the role
+   */
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  /**
+   * @brief Get the role names of the model
+   */
+  QHash<int, QByteArray> roleNames() const override;
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::ui::gui::models
@@ -7,41 +7,48 @@
 
 namespace srilakshmikanthanp::clipbirdesk::ui::gui {
 /**
- * @brief Authenticator for server to authenticate the client
- * when client connects to server, This Authenticator just
- * shows a info of the client and asks for permission to
- * connect or not.
+ * @brief Authenticator to authenticate the peer that is not
+ * pinned yet, the server asks it for new clients and the client
+ * for new servers, This Authenticator just shows a non-modal
+ * info of the peer and asks for permission to connect or not,
+ * the answer is delivered through result so the caller keeps
+ * working meanwhile.
  *
  * @param host <QHostAddress, quint16>
- *
- * @return true if user accepts the connection
- * @return false if user rejects the connection
+ * @param result callback that receives true if user accepts
+ * the connection or false if user rejects the connection
  */
-bool authenticator(QPair<QHostAddress, quint16> host) {
+void authenticator(QPair<QHostAddress, quint16> host, types::callback::AuthResult result) {
   // get the message to show
   auto message = QString("Host: %1\nPort: %2\n\nAccept?").arg(
       host.first.toString(), QString::number(host.second));
 
   // title of the dialog
-  auto title = "New Client Connection!";
+  auto title = "New Device Connection!";
 
-  // get the user input
-  auto dialog = QInputDialog();
+  // create the dialog, it is deleted when closed
+  auto dialog = new QInputDialog();
 
   // Set the dialog properties
-  dialog.setWindowFlags(Qt::WindowStaysOnTopHint);
-  dialog.setWindowModality(Qt::ApplicationModal);
-  dialog.setFixedSize(dialog.sizeHint());
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->setWindowFlags(Qt::WindowStaysOnTopHint);
+  dialog->setWindowModality(Qt::NonModal);
+  dialog->setFixedSize(dialog->sizeHint());
 
   // set the dialog message
-  dialog.setWindowTitle(title);
-  dialog.setLabelText(message);
+  dialog->setWindowTitle(title);
+  dialog->setLabelText(message);
 
   // set the dialog buttons
-  dialog.setOkButtonText("Accept");
-  dialog.setCancelButtonText("Reject");
+  dialog->setOkButtonText("Accept");
+  dialog->setCancelButtonText("Reject");
+
+  // deliver the result once the user answers
+  const auto signal = &QDialog::finished;
+  const auto slot   = [result](int code) { result(code == QDialog::Accepted); };
+  QObject::connect(dialog, signal, dialog, slot);
 
-  // show the dialog and return the status
-  return dialog.exec() == QDialog::Accepted;
+  // show the dialog without blocking the caller
+  dialog->show();
 }
 }  // namespace srilakshmikanthanp::clipbirdesk::ui::gui::utility
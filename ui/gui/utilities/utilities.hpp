@@ -9,17 +9,20 @@
 #include <QPair>
 #include <QHostAddress>
 
+#include "types/callback/callback.hpp"
+
 namespace srilakshmikanthanp::clipbirdesk::ui::gui {
 /**
- * @brief Authenticator for server to authenticate the client
- * when client connects to server, This Authenticator just
- * shows a info of the client and asks for permission to
- * connect or not.
+ * @brief Authenticator to authenticate the peer that is not
+ * pinned yet, the server asks it for new clients and the client
+ * for new servers, This Authenticator just shows a non-modal
+ * info of the peer and asks for permission to connect or not,
+ * the answer is delivered through result so the caller keeps
+ * working meanwhile.
  *
  * @param host <QHostAddress, quint16>
- *
- * @return true if user accepts the connection
- * @return false if user rejects the connection
+ * @param result callback that receives true if user accepts
+ * the connection or false if user rejects the connection
  */
-bool authenticator(QPair<QHostAddress, quint16> host);
+void authenticator(QPair<QHostAddress, quint16> host, types::callback::AuthResult result);
 }  // namespace srilakshmikanthanp::clipbirdesk::ui::gui::utility
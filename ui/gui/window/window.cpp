@@ -37,6 +37,9 @@ void Window::handleTabChangeForClient(Tabs tab) {
   this->setServerIpPort(c_ipPortKey, "-");
   this->setHostCount(c_serversKey, 0);
 
+  // no server is shown so a late name is ignored
+  this->serverAddress = QHostAddress();
+
   // notify the controller
   controller->setCurrentHostAsClient();
 }
@@ -53,6 +56,9 @@ void Window::handleTabChangeForServer(Tabs tab) {
   this->setServerIpPort(s_ipPortKey, "-");
   this->setHostCount(s_clientsKey, 0);
 
+  // no server is shown so a late name is ignored
+  this->serverAddress = QHostAddress();
+
   // notify the controller
   controller->setCurrentHostAsServer();
 }
@@ -87,9 +93,12 @@ void Window::handleServerStateChange(bool isStarted) {
   const auto serverIp   = serverInfo.first.toString();
   const auto serverPort = serverInfo.second;
   const auto IpPort     = QString("%1:%2").arg(serverIp).arg(serverPort);
-  const auto serverName = QHostInfo::fromName(serverIp).hostName();
+  const auto serverName = resolver->resolve(serverInfo.first);
   const auto clients    = controller->getConnectedClientsList();
 
+  // remember the address to update the name once resolved
+  this->serverAddress   = serverInfo.first;
+
   this->setServerHostName(s_hostNameKey, serverName);
   this->setStatus(s_statusKey, status_m);
   this->setServerIpPort(s_ipPortKey, IpPort);
@@ -135,9 +144,12 @@ void Window::handleServerStatusChange(bool status) {
   const auto serverIp   = server.first.toString();
   const auto serverPort = server.second;
   const auto IpPort     = QString("%1:%2").arg(serverIp).arg(serverPort);
-  const auto serverName = QHostInfo::fromName(serverIp).hostName();
+  const auto serverName = resolver->resolve(server.first);
   const auto servers    = controller->getServerList();
 
+  // remember the address to update the name once resolved
+  this->serverAddress   = server.first;
+
   // set the server status
   this->setServerHostName(c_hostNameKey, serverName);
   this->setStatus(c_statusKey, status_m);
@@ -145,6 +157,17 @@ void Window::handleServerStatusChange(bool status) {
   this->setHostCount(c_serversKey, servers.size());
 }
 
+//----------------------------- slots for Resolver ------------------------//
+
+/**
+ * @brief Handle the host name resolved by the resolver
+ * and update the server host name if it is the one shown
+ */
+void Window::handleHostNameResolved(QHostAddress address, QString hostName) {
+  if (serverAddress.isNull() || address != serverAddress) return;  // not the shown server
+  this->serverName.second->setText(hostName);
+}
+
 /**
  * @brief Construct a new Window object
  * with parent as QWidget
@@ -252,6 +275,11 @@ Window::Window(Window::ClipBird* controller, QWidget* parent)
   const auto slot_sc   = &Window::handleServerStatusChange;
   connect(controller, signal_sc, this, slot_sc);
 
+  // Connect the signal and slot for host name resolved
+  const auto signal_hn = &Resolver::OnHostNameResolved;
+  const auto slot_hn   = &Window::handleHostNameResolved;
+  connect(resolver, signal_hn, this, slot_hn);
+
   // Connect the signal and slot for host action
   const auto signal_ha = &Window::onHostAction;
   const auto slot_ha   = &Window::handleHostAction;
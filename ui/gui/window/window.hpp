@@ -12,7 +12,6 @@
 #include <QGuiApplication>
 #include <QHBoxLayout>
 #include <QHostAddress>
-#include <QHostInfo>
 #include <QScreen>
 #include <QTabWidget>
 #include <QVBoxLayout>
@@ -25,6 +24,7 @@
 
 // project headers
 #include "controller/clipbird/clipbird.hpp"
+#include "network/resolver/resolver.hpp"
 #include "ui/gui/components/button/button.hpp"
 #include "ui/gui/components/host/host.hpp"
 #include "ui/gui/components/hostlist/hostslist.hpp"
@@ -49,6 +49,7 @@ class Window : public QWidget {
  private:  // typedefs used in this class
 
   using ClipBird = controller::ClipBird;
+  using Resolver = network::resolver::Resolver;
 
  public:  // typedefs used in this class
 
@@ -80,6 +81,8 @@ class Window : public QWidget {
 
   QSize ratio = QSize(3, 3);
   ClipBird* controller;
+  Resolver* resolver = Resolver::instance();
+  QHostAddress serverAddress;
 
  signals:  // signals
   void onHostAction(Tabs tab, std::tuple<QHostAddress, quint16, Action>);
@@ -144,6 +147,13 @@ class Window : public QWidget {
    */
   void handleServerStatusChange(bool status);
 
+  //---------------------------- slots for Resolver -------------------------//
+
+  /**
+   * @brief Handle the host name resolved by the resolver
+   */
+  void handleHostNameResolved(QHostAddress address, QString hostName);
+
  public:
 
   /**
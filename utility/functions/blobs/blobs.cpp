@@ -0,0 +1,291 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "blobs.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/**
+ * @brief Is the payload of the mime type a text that is edited
+ * and copied again so a delta is worth it
+ */
+static bool isDeltaType(const QString& mime) {
+  return mime.startsWith("text/");
+}
+
+/**
+ * @brief Get the hash of the base and the payload of the delta
+ *
+ * @throw MalformedPacket if the delta is too short
+ */
+static QPair<QByteArray, QByteArray> getDeltaHashes(const QByteArray& payload) {
+  // check the length
+  if (payload.size() < 2 * hashLength) {
+    throw types::except::MalformedPacket(types::enums::ErrorCode::CodingError, "Invalid Delta");
+  }
+
+  // return the hashes
+  return {payload.left(hashLength), payload.mid(hashLength, hashLength)};
+}
+
+/**
+ * @brief Create the SyncingPacket, the payloads that are at least
+ * the threshold are offered by the store and sent as a reference,
+ * or as a delta against the base of the text if it is smaller,
+ * only the encodings the peer reads are used and the version 1
+ * has only the inline items
+ *
+ * @param items mime type and payload
+ * @param syncId id of the sync
+ * @param store store of the payloads
+ * @param bases hash of the last text the peer has by the mime type
+ * @param codecs encodings the peer reads, bit n is the encoding n
+ * @param version protocol version agreed with the peer
+ *
+ * @return SyncingPacket
+ */
+network::packets::SyncingPacket createSyncingPacket(
+    const QVector<QPair<QString, QByteArray>>& items,
+    quint64 syncId,
+    storage::BlobStore& store,
+    const QHash<QString, QByteArray>& bases,
+    quint32 codecs,
+    quint16 version
+) {
+  // encodings of the large payloads
+  const auto reference = network::packets::SyncingItem::Encoding::Reference;
+  const auto delta     = network::packets::SyncingItem::Encoding::Delta;
+
+  // the delta falls back to the reference so it needs both, the
+  // version 1 has no encoding of the items
+  const auto isReference = version >= 2 && (codecs & (1u << reference)) != 0;
+  const auto isDelta     = isReference && (codecs & (1u << delta)) != 0;
+
+  // create the packet
+  network::packets::SyncingPacket packet;
+
+  // set the packet type
+  packet.setPacketType(network::packets::SyncingPacket::PacketType::SyncPacket);
+
+  // set the sync id
+  packet.setSyncId(syncId);
+
+  // set the item count
+  packet.setItemCount(items.size());
+
+  // Convert the items to SyncingItem
+  QVector<network::packets::SyncingItem> syncItems;
+
+  // reserve the memory
+  syncItems.reserve(items.size());
+
+  // the large payloads are sent by the hash
+  for (const auto& [mime, payload] : items) {
+    // the small payloads and all of them for the old peers are sent as is
+    if (payload.size() < referenceThreshold || !isReference) {
+      syncItems.push_back(createPacket({mime, payload}));
+      continue;
+    }
+
+    // offer the payload, the delta falls back to it too
+    const auto hash = store.offer(payload);
+
+    // base of the text that the peer has
+    const auto base = bases.value(mime);
+
+    // the text is sent as a delta if it is smaller
+    if (isDelta && isDeltaType(mime) && !base.isEmpty() && base != hash && store.has(base)) {
+      const auto diff = createDelta(store.get(base), payload);
+      if (2 * hashLength + diff.size() < payload.size()) {
+        syncItems.push_back(createPacket({mime, base + hash + diff, delta}));
+        continue;
+      }
+    }
+
+    // else as a reference
+    syncItems.push_back(createPacket({mime, hash, reference}));
+  }
+
+  // set the items
+  packet.setItems(std::move(syncItems));
+
+  // set the version the packet is coded in
+  packet.setVersion(version);
+
+  // set the packet length
+  packet.setPacketLength(packet.size());
+
+  // return the packet
+  return packet;
+}
+
+/**
+ * @brief Make the text of the items the bases of the peer, the
+ * bases are held in the store till they are replaced
+ *
+ * @param bases hash of the last text the peer has by the mime type
+ * @param items mime type and payload
+ * @param store store of the payloads
+ */
+void updateBases(
+    QHash<QString, QByteArray>& bases,
+    const QVector<QPair<QString, QByteArray>>& items,
+    storage::BlobStore& store
+) {
+  for (const auto& [mime, payload] : items) {
+    // only the large text has a delta
+    if (!isDeltaType(mime) || payload.size() < referenceThreshold) continue;
+
+    // hold the new base before the old one is released
+    const auto hash = store.put(payload);
+
+    // release the old base
+    if (const auto it = bases.constFind(mime); it != bases.constEnd()) store.release(*it);
+
+    // set the base
+    bases.insert(mime, hash);
+  }
+}
+
+/**
+ * @brief Release the bases of the peer that is gone
+ *
+ * @param bases hash of the last text the peer has by the mime type
+ * @param store store of the payloads
+ */
+void releaseBases(QHash<QString, QByteArray>& bases, storage::BlobStore& store) {
+  for (const auto& hash : std::as_const(bases)) store.release(hash);
+  bases.clear();
+}
+
+/**
+ * @brief Get the hashes of the referenced payloads that are not
+ * in the store, the payload of a delta is missing if neither it
+ * nor its base is in the store, each hash is listed once
+ *
+ * @param packet SyncingPacket
+ * @param store store of the payloads
+ *
+ * @return QVector<QByteArray> hashes to want
+ * @throw MalformedPacket if a delta is malformed
+ */
+QVector<QByteArray> getMissingBlobs(
+    const network::packets::SyncingPacket& packet, const storage::BlobStore& store
+) {
+  // encodings of the large payloads
+  const auto reference = network::packets::SyncingItem::Encoding::Reference;
+  const auto delta     = network::packets::SyncingItem::Encoding::Delta;
+
+  // hashes that are not in the store
+  QVector<QByteArray> missing;
+
+  // check the references and the bases of the deltas
+  for (const auto& item : packet.getItems()) {
+    // hash of the payload
+    QByteArray hash;
+
+    // the delta can be applied if the base is here
+    if (item.getEncoding() == delta) {
+      const auto [base, target] = getDeltaHashes(item.getPayload());
+      if (store.has(base)) continue;
+      hash = target;
+    } else if (item.getEncoding() == reference) {
+      hash = item.getPayload();
+    } else {
+      continue;
+    }
+
+    // want the payload if not here
+    if (!store.has(hash) && !missing.contains(hash)) missing.append(hash);
+  }
+
+  // return the hashes
+  return missing;
+}
+
+/**
+ * @brief Get the items of the packet with the references replaced
+ * by the payloads from the store and the deltas applied
+ *
+ * @param packet SyncingPacket
+ * @param store store of the payloads
+ *
+ * @return mime type and payload
+ * @throw std::out_of_range if a payload is not in the store
+ * @throw std::invalid_argument if a delta doesn't give the payload
+ */
+QVector<QPair<QString, QByteArray>> resolveItems(
+    const network::packets::SyncingPacket& packet, const storage::BlobStore& store
+) {
+  // encodings of the large payloads
+  const auto reference = network::packets::SyncingItem::Encoding::Reference;
+  const auto delta     = network::packets::SyncingItem::Encoding::Delta;
+
+  // Make the vector of QPair<QString, QByteArray>
+  QVector<QPair<QString, QByteArray>> items;
+  items.reserve(packet.getItems().size());
+
+  // Get the items from the packet
+  for (const auto& item : packet.getItems()) {
+    // mime type decoded from the utf-8 and the payload borrowed
+    const auto mime     = QString::fromUtf8(item.getMimeType());
+    const auto &payload = item.getPayload();
+
+    // the payload is as is
+    if (item.getEncoding() != reference && item.getEncoding() != delta) {
+      items.append({mime, payload});
+      continue;
+    }
+
+    // the payload by the hash
+    if (item.getEncoding() == reference) {
+      items.append({mime, store.get(payload)});
+      continue;
+    }
+
+    // the payload may be here already
+    const auto [base, target] = getDeltaHashes(payload);
+    if (store.has(target)) {
+      items.append({mime, store.get(target)});
+      continue;
+    }
+
+    // apply the delta to the base
+    const auto result = applyDelta(store.get(base), payload.mid(2 * hashLength));
+
+    // check the result
+    if (storage::BlobStore::hashOf(result) != target) {
+      throw std::invalid_argument("Delta doesn't match the payload");
+    }
+
+    // add the result
+    items.append({mime, result});
+  }
+
+  // return the items
+  return items;
+}
+
+/**
+ * @brief Get the payloads of the hashes that are in the store,
+ * the others are skipped
+ *
+ * @param hashes hashes that are wanted
+ * @param store store of the payloads
+ *
+ * @return QVector<QByteArray> payloads
+ */
+QVector<QByteArray> getBlobs(const QVector<QByteArray>& hashes, const storage::BlobStore& store) {
+  // payloads that are in the store
+  QVector<QByteArray> blobs;
+
+  // get the payloads
+  for (const auto& hash : hashes) {
+    if (store.has(hash)) blobs.append(store.get(hash));
+  }
+
+  // return the payloads
+  return blobs;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
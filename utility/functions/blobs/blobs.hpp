@@ -0,0 +1,123 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt header files
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtTypes>
+
+// Local header files
+#include "constants/constants.hpp"
+#include "network/packets/syncingpacket/syncingpacket.hpp"
+#include "storage/blobstore/blobstore.hpp"
+#include "types/except/except.hpp"
+#include "utility/functions/delta/delta.hpp"
+#include "utility/functions/packet/packet.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/// @brief Payloads of at least this size are sent by their hash
+constexpr qsizetype referenceThreshold = 1024;
+
+/// @brief Length of the hash of a payload
+constexpr qsizetype hashLength = 32;
+
+/// @brief Encodings of the syncing items that are read and sent, bit n is the encoding n
+constexpr quint32 supportedCodecs = (1u << network::packets::SyncingItem::Encoding::Inline) |
+                                    (1u << network::packets::SyncingItem::Encoding::Reference) |
+                                    (1u << network::packets::SyncingItem::Encoding::Delta);
+
+/**
+ * @brief Create the SyncingPacket, the payloads that are at least
+ * the threshold are offered by the store and sent as a reference,
+ * or as a delta against the base of the text if it is smaller,
+ * only the encodings the peer reads are used and the version 1
+ * has only the inline items
+ *
+ * @param items mime type and payload
+ * @param syncId id of the sync
+ * @param store store of the payloads
+ * @param bases hash of the last text the peer has by the mime type
+ * @param codecs encodings the peer reads, bit n is the encoding n
+ * @param version protocol version agreed with the peer
+ *
+ * @return SyncingPacket
+ */
+network::packets::SyncingPacket createSyncingPacket(
+    const QVector<QPair<QString, QByteArray>>& items,
+    quint64 syncId,
+    storage::BlobStore& store,
+    const QHash<QString, QByteArray>& bases = {},
+    quint32 codecs                          = supportedCodecs,
+    quint16 version                         = constants::getProtocolVersion()
+);
+
+/**
+ * @brief Make the text of the items the bases of the peer, the
+ * bases are held in the store till they are replaced
+ *
+ * @param bases hash of the last text the peer has by the mime type
+ * @param items mime type and payload
+ * @param store store of the payloads
+ */
+void updateBases(
+    QHash<QString, QByteArray>& bases,
+    const QVector<QPair<QString, QByteArray>>& items,
+    storage::BlobStore& store
+);
+
+/**
+ * @brief Release the bases of the peer that is gone
+ *
+ * @param bases hash of the last text the peer has by the mime type
+ * @param store store of the payloads
+ */
+void releaseBases(QHash<QString, QByteArray>& bases, storage::BlobStore& store);
+
+/**
+ * @brief Get the hashes of the referenced payloads that are not
+ * in the store, the payload of a delta is missing if neither it
+ * nor its base is in the store, each hash is listed once
+ *
+ * @param packet SyncingPacket
+ * @param store store of the payloads
+ *
+ * @return QVector<QByteArray> hashes to want
+ * @throw MalformedPacket if a delta is malformed
+ */
+QVector<QByteArray> getMissingBlobs(
+    const network::packets::SyncingPacket& packet, const storage::BlobStore& store
+);
+
+/**
+ * @brief Get the items of the packet with the references replaced
+ * by the payloads from the store and the deltas applied
+ *
+ * @param packet SyncingPacket
+ * @param store store of the payloads
+ *
+ * @return mime type and payload
+ * @throw std::out_of_range if a payload is not in the store
+ * @throw std::invalid_argument if a delta doesn't give the payload
+ */
+QVector<QPair<QString, QByteArray>> resolveItems(
+    const network::packets::SyncingPacket& packet, const storage::BlobStore& store
+);
+
+/**
+ * @brief Get the payloads of the hashes that are in the store,
+ * the others are skipped
+ *
+ * @param hashes hashes that are wanted
+ * @param store store of the payloads
+ *
+ * @return QVector<QByteArray> payloads
+ */
+QVector<QByteArray> getBlobs(const QVector<QByteArray>& hashes, const storage::BlobStore& store);
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
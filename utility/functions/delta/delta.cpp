@@ -0,0 +1,226 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "delta.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/// @brief Operations of the delta
+enum DeltaOp : quint8 { Copy = 0x00, Insert = 0x01 };
+
+/**
+ * @brief Rolling checksum of a block, the sums are kept apart
+ * so the block can be rolled by a byte in O(1)
+ */
+struct RollingSum {
+  quint32 a = 0;
+  quint32 b = 0;
+
+  /**
+   * @brief Sum of the block
+   */
+  RollingSum(const uchar* data, qsizetype length) {
+    for (qsizetype i = 0; i < length; i++) {
+      a += data[i];
+      b += quint32(length - i) * data[i];
+    }
+  }
+
+  /**
+   * @brief Roll the block by a byte
+   */
+  void roll(uchar out, uchar in, qsizetype length) {
+    a += in - out;
+    b += a - quint32(length) * out;
+  }
+
+  /**
+   * @brief Checksum of the block
+   */
+  quint32 value() const {
+    return (a & 0xffff) | (b << 16);
+  }
+};
+
+/**
+ * @brief Append the value in big endian
+ */
+static void appendUInt32(QByteArray& data, quint32 value) {
+  const char bytes[] = {
+    char(value >> 24), char(value >> 16), char(value >> 8), char(value),
+  };
+  data.append(bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Read the big endian value at the position and move it
+ */
+static quint32 readUInt32(const QByteArray& data, qsizetype& pos) {
+  // check the bounds
+  if (pos + 4 > data.size()) throw std::invalid_argument("Invalid Delta");
+
+  // read the value
+  const auto bytes = reinterpret_cast<const uchar*>(data.constData()) + pos;
+  pos += 4;
+
+  // return the value
+  return quint32(bytes[0]) << 24 | quint32(bytes[1]) << 16 | quint32(bytes[2]) << 8 | bytes[3];
+}
+
+/**
+ * @brief Create the delta that turns the base into the target, the
+ * blocks of the base are found in the target by a rolling hash like
+ * rsync and the delta is a list of copies from the base and inserts
+ * of the bytes that are not in the base
+ *
+ * @param base payload the receiver has
+ * @param target payload to send
+ *
+ * @return QByteArray delta
+ */
+QByteArray createDelta(const QByteArray& base, const QByteArray& target) {
+  // bytes of the payloads
+  const auto baseData   = reinterpret_cast<const uchar*>(base.constData());
+  const auto targetData = reinterpret_cast<const uchar*>(target.constData());
+  const auto block      = deltaBlockSize;
+
+  // offset of a block of the base by the checksum
+  QHash<quint32, qsizetype> blocks;
+  blocks.reserve(base.size() / block);
+  for (qsizetype offset = 0; offset + block <= base.size(); offset += block) {
+    blocks.insert(RollingSum(baseData + offset, block).value(), offset);
+  }
+
+  // the delta starts with the size of the target
+  QByteArray delta;
+  appendUInt32(delta, target.size());
+
+  // insert the bytes of the target that are not copied
+  const auto insert = [&](qsizetype from, qsizetype to) {
+    if (from == to) return;
+    delta.append(char(DeltaOp::Insert));
+    appendUInt32(delta, to - from);
+    delta.append(target.constData() + from, to - from);
+  };
+
+  // start of the bytes that are not copied yet
+  qsizetype pending = 0;
+
+  // position of the window in the target
+  qsizetype pos     = 0;
+
+  // checksum of the window
+  auto sum          = RollingSum(targetData, std::min(block, target.size()));
+
+  // slide the window over the target
+  while (!blocks.isEmpty() && pos + block <= target.size()) {
+    // offset of the block in the base if any
+    const auto it = blocks.constFind(sum.value());
+
+    // the same checksum may be a different block
+    if (it == blocks.constEnd() || std::memcmp(baseData + *it, targetData + pos, block) != 0) {
+      if (pos + block < target.size()) sum.roll(targetData[pos], targetData[pos + block], block);
+      pos += 1;
+      continue;
+    }
+
+    // start and length of the match
+    auto offset = *it;
+    auto start  = pos;
+    auto length = block;
+
+    // grow the match back over the pending bytes
+    while (start > pending && offset > 0 && targetData[start - 1] == baseData[offset - 1]) {
+      start -= 1;
+      offset -= 1;
+      length += 1;
+    }
+
+    // grow the match forward
+    while (start + length < target.size() && offset + length < base.size() &&
+           targetData[start + length] == baseData[offset + length]) {
+      length += 1;
+    }
+
+    // insert the bytes before the match
+    insert(pending, start);
+
+    // copy the match from the base
+    delta.append(char(DeltaOp::Copy));
+    appendUInt32(delta, offset);
+    appendUInt32(delta, length);
+
+    // move after the match
+    pending = pos = start + length;
+
+    // checksum of the next window
+    if (pos + block <= target.size()) sum = RollingSum(targetData + pos, block);
+  }
+
+  // insert the rest of the target
+  insert(pending, target.size());
+
+  // return the delta
+  return delta;
+}
+
+/**
+ * @brief Apply the delta to the base
+ *
+ * @param base payload the delta was made against
+ * @param delta delta from the createDelta
+ *
+ * @return QByteArray target
+ * @throw std::invalid_argument if the delta is malformed
+ */
+QByteArray applyDelta(const QByteArray& base, const QByteArray& delta) {
+  // position in the delta
+  qsizetype pos = 0;
+
+  // size of the target
+  const qsizetype size = readUInt32(delta, pos);
+
+  // the target can't be larger than the inserts and the copies
+  if (size > delta.size() + qsizetype(delta.size() / 9 + 1) * base.size()) {
+    throw std::invalid_argument("Invalid Delta");
+  }
+
+  // target that is built
+  QByteArray target;
+  target.reserve(size);
+
+  // apply the operations
+  while (pos < delta.size()) {
+    // operation
+    const auto op = quint8(delta.at(pos++));
+
+    // copy from the base
+    if (op == DeltaOp::Copy) {
+      const qsizetype offset = readUInt32(delta, pos);
+      const qsizetype length = readUInt32(delta, pos);
+      if (offset + length > base.size()) throw std::invalid_argument("Invalid Delta");
+      target.append(base.constData() + offset, length);
+      continue;
+    }
+
+    // insert the bytes
+    if (op == DeltaOp::Insert) {
+      const qsizetype length = readUInt32(delta, pos);
+      if (pos + length > delta.size()) throw std::invalid_argument("Invalid Delta");
+      target.append(delta.constData() + pos, length);
+      pos += length;
+      continue;
+    }
+
+    // unknown operation
+    throw std::invalid_argument("Invalid Delta");
+  }
+
+  // check the size
+  if (target.size() != size) throw std::invalid_argument("Invalid Delta");
+
+  // return the target
+  return target;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
@@ -0,0 +1,45 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt header files
+#include <QByteArray>
+#include <QHash>
+#include <QtTypes>
+
+// C++ headers
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/// @brief Size of the blocks of the base that are matched
+constexpr qsizetype deltaBlockSize = 64;
+
+/**
+ * @brief Create the delta that turns the base into the target, the
+ * blocks of the base are found in the target by a rolling hash like
+ * rsync and the delta is a list of copies from the base and inserts
+ * of the bytes that are not in the base
+ *
+ * @param base payload the receiver has
+ * @param target payload to send
+ *
+ * @return QByteArray delta
+ */
+QByteArray createDelta(const QByteArray& base, const QByteArray& target);
+
+/**
+ * @brief Apply the delta to the base
+ *
+ * @param base payload the delta was made against
+ * @param delta delta from the createDelta
+ *
+ * @return QByteArray target
+ * @throw std::invalid_argument if the delta is malformed
+ */
+QByteArray applyDelta(const QByteArray& base, const QByteArray& delta);
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
@@ -0,0 +1,76 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "filter.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/**
+ * @brief Is the item accepted by the filter of the peer
+ *
+ * @param mime mime type of the item
+ * @param payload payload of the item
+ * @param filter filter of the peer
+ *
+ * @return true if the peer wants the item
+ */
+bool isAccepted(
+    const QString& mime, const QByteArray& payload, const network::packets::FilterPacket& filter
+) {
+  // flags of the filter
+  using Flag       = network::packets::FilterPacket::Flag;
+  const auto flags = filter.getFlags();
+
+  // the paused peer wants nothing
+  if (flags & Flag::Paused) return false;
+
+  // only the text if asked
+  if ((flags & Flag::TextOnly) && !mime.startsWith("text/")) return false;
+
+  // drop the items over the size
+  const auto maxSize = filter.getMaxItemSize();
+  if (maxSize > 0 && static_cast<quint64>(payload.size()) > maxSize) return false;
+
+  // no types accept all
+  const auto types = filter.getMimeTypes();
+  if (types.isEmpty()) return true;
+
+  // the mime type as bytes to compare
+  const auto type = mime.toUtf8();
+
+  // the same type or the prefix that ends with an asterisk
+  for (const auto& allowed : types) {
+    if (allowed.endsWith('*') ? type.startsWith(allowed.chopped(1)) : type == allowed) {
+      return true;
+    }
+  }
+
+  // not in the types
+  return false;
+}
+
+/**
+ * @brief Get the items that are accepted by the filter of the peer
+ * in the same order, nothing is accepted if the peer is paused
+ *
+ * @param items mime type and payload
+ * @param filter filter of the peer
+ *
+ * @return mime type and payload
+ */
+QVector<QPair<QString, QByteArray>> filterItems(
+    const QVector<QPair<QString, QByteArray>>& items, const network::packets::FilterPacket& filter
+) {
+  // accepted items
+  QVector<QPair<QString, QByteArray>> accepted;
+
+  // keep the accepted items
+  for (const auto& [mime, payload] : items) {
+    if (isAccepted(mime, payload, filter)) accepted.append({mime, payload});
+  }
+
+  // return the accepted items
+  return accepted;
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
@@ -0,0 +1,44 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt header files
+#include <QByteArray>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtTypes>
+
+// Local header files
+#include "network/packets/filterpacket/filterpacket.hpp"
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/**
+ * @brief Is the item accepted by the filter of the peer
+ *
+ * @param mime mime type of the item
+ * @param payload payload of the item
+ * @param filter filter of the peer
+ *
+ * @return true if the peer wants the item
+ */
+bool isAccepted(
+    const QString& mime, const QByteArray& payload, const network::packets::FilterPacket& filter
+);
+
+/**
+ * @brief Get the items that are accepted by the filter of the peer
+ * in the same order, nothing is accepted if the peer is paused
+ *
+ * @param items mime type and payload
+ * @param filter filter of the peer
+ *
+ * @return mime type and payload
+ */
+QVector<QPair<QString, QByteArray>> filterItems(
+    const QVector<QPair<QString, QByteArray>>& items, const network::packets::FilterPacket& filter
+);
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
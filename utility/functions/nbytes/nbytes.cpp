@@ -6,5 +6,54 @@
 #include "nbytes.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::utility::functions {
-// Nothing All defined in header are template functions
+/**
+ * @brief Read one whole packet from the device, all the packets
+ * start with the packet type (quint8) and the packet length
+ * (qint32 big endian) that includes the header, so the header is
+ * peeked and the packet is read only once all of it has arrived
+ *
+ * @param device device to read from
+ * @return QByteArray whole packet or empty if not arrived yet
+ * @throw MalformedPacket if the packet length is invalid or too large
+ */
+QByteArray readPacket(QIODevice* device) {
+  // size of the packet header
+  constexpr auto headerSize = qint64(sizeof(quint8) + sizeof(qint32));
+
+  // wait for the whole header
+  if (device->bytesAvailable() < headerSize) return QByteArray();
+
+  // peek the header
+  auto header = device->peek(headerSize);
+
+  // create the data stream
+  QDataStream stream(header);
+
+  // set Byte Order
+  stream.setByteOrder(QDataStream::BigEndian);
+
+  // packet type and length
+  quint8 type;
+  qint32 length;
+
+  // read the header
+  stream >> type >> length;
+
+  // the stream can't be resynchronized after a bad
+  // length so drop everything that is buffered, the
+  // length over the maximum is not buffered either
+  if (length < headerSize || length > constants::getMaxPacketSize()) {
+    device->readAll();
+    throw types::except::MalformedPacket(
+        types::enums::ErrorCode::CodingError, "Invalid Packet Length"
+    );
+  }
+
+  // wait for the whole packet
+  if (device->bytesAvailable() < length) return QByteArray();
+
+  // read the packet
+  CLIPBIRD_TRACE_SPAN("read");
+  return device->read(length);
 }
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
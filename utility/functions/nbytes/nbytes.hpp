@@ -5,10 +5,21 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
+// Qt header files
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+
 // Local header files
+#include "constants/constants.hpp"
+#include "network/packets/blobpacket/blobpacket.hpp"
+#include "network/packets/chunkpacket/chunkpacket.hpp"
 #include "network/packets/discoverypacket/discoverypacket.hpp"
+#include "network/packets/filterpacket/filterpacket.hpp"
+#include "network/packets/hellopacket/hellopacket.hpp"
 #include "network/packets/invalidrequest/invalidrequest.hpp"
 #include "network/packets/syncingpacket/syncingpacket.hpp"
+#include "utility/tracing/tracing.hpp"
 
 namespace srilakshmikanthanp::clipbirdesk::utility::functions {
 /**
@@ -22,6 +33,9 @@ QByteArray toQByteArray(const Packet& packet) {
   // create the byte array
   QByteArray data;
 
+  // grow once for the packet
+  data.reserve(packet.size());
+
   // create the data stream
   QDataStream stream(&data, QIODevice::WriteOnly);
 
@@ -38,18 +52,16 @@ QByteArray toQByteArray(const Packet& packet) {
   return data;
 }
 
+namespace internals {
 /**
- * @brief Convert the QByteArray to Packet
+ * @brief Read the Packet from the QByteArray
  *
  * @tparam Packet
  * @param data
- * @return Packet
+ * @param packet packet to read into
  */
 template <typename Packet>
-Packet fromQByteArray(const QByteArray& data) {
-  // create the packet
-  Packet packet;
-
+void readFrom(const QByteArray& data, Packet& packet) {
   // create the data stream
   QDataStream stream(data);
 
@@ -61,8 +73,61 @@ Packet fromQByteArray(const QByteArray& data) {
 
   // read the packet
   stream >> packet;
+}
+}  // namespace internals
+
+/**
+ * @brief Convert the QByteArray to Packet
+ *
+ * @tparam Packet
+ * @param data
+ * @return Packet
+ */
+template <typename Packet>
+Packet fromQByteArray(const QByteArray& data) {
+  // create the packet
+  Packet packet;
+
+  // read the packet
+  internals::readFrom(data, packet);
 
   // return the packet
   return packet;
 }
+
+/**
+ * @brief Convert the QByteArray to Packet that is coded in the
+ * protocol version the peers agreed on
+ *
+ * @tparam Packet
+ * @param data
+ * @param version agreed protocol version
+ * @return Packet
+ */
+template <typename Packet>
+Packet fromQByteArray(const QByteArray& data, quint16 version) {
+  // create the packet
+  Packet packet;
+
+  // set the version
+  packet.setVersion(version);
+
+  // read the packet
+  internals::readFrom(data, packet);
+
+  // return the packet
+  return packet;
+}
+
+/**
+ * @brief Read one whole packet from the device, all the packets
+ * start with the packet type (quint8) and the packet length
+ * (qint32 big endian) that includes the header, so the header is
+ * peeked and the packet is read only once all of it has arrived
+ *
+ * @param device device to read from
+ * @return QByteArray whole packet or empty if not arrived yet
+ * @throw MalformedPacket if the packet length is invalid or too large
+ */
+QByteArray readPacket(QIODevice* device);
 }  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
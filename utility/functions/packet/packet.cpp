@@ -90,6 +90,9 @@ network::packets::SyncingItem createPacket(internals::SyncingItemParams params)
   // set the mime type
   syncItem.setMimeType(params.mimeType.toUtf8());
 
+  // set the encoding
+  syncItem.setEncoding(params.encoding);
+
   // set the payload length
   syncItem.setPayloadLength(params.payload.size());
 
@@ -100,6 +103,141 @@ network::packets::SyncingItem createPacket(internals::SyncingItemParams params)
   return syncItem;
 }
 
+/**
+ * @brief Create the BlobPacket
+ *
+ * @param packetType
+ * @param syncId
+ * @param blobs
+ *
+ * @return BlobPacket
+ */
+network::packets::BlobPacket createPacket(internals::BlobPacketParams params) {
+  // create the packet
+  network::packets::BlobPacket packet;
+
+  // set the packet type
+  packet.setPacketType(params.packetType);
+
+  // set the sync id of the syncing packet
+  packet.setSyncId(params.syncId);
+
+  // set the blob count
+  packet.setBlobCount(params.blobs.size());
+
+  // set the blobs
+  packet.setBlobs(params.blobs);
+
+  // set the packet length
+  packet.setPacketLength(packet.size());
+
+  // return the packet
+  return packet;
+}
+
+/**
+ * @brief Create the HelloPacket
+ *
+ * @param packetType
+ * @param version
+ * @param minVersion
+ * @param features
+ *
+ * @return HelloPacket
+ */
+network::packets::HelloPacket createPacket(internals::HelloPacketParams params) {
+  // create the packet
+  network::packets::HelloPacket packet;
+
+  // set the packet type
+  packet.setPacketType(params.packetType);
+
+  // set the versions
+  packet.setVersion(params.version);
+  packet.setMinVersion(params.minVersion);
+
+  // set the features
+  packet.setFeatures(params.features);
+
+  // set the packet length
+  packet.setPacketLength(packet.size());
+
+  // return the packet
+  return packet;
+}
+
+/**
+ * @brief Create the FilterPacket
+ *
+ * @param packetType
+ * @param flags
+ * @param maxItemSize
+ * @param mimeTypes
+ *
+ * @return FilterPacket
+ */
+network::packets::FilterPacket createPacket(internals::FilterPacketParams params) {
+  // create the packet
+  network::packets::FilterPacket packet;
+
+  // set the packet type
+  packet.setPacketType(params.packetType);
+
+  // set the flags
+  packet.setFlags(params.flags);
+
+  // set the max item size
+  packet.setMaxItemSize(params.maxItemSize);
+
+  // set the mime count
+  packet.setMimeCount(params.mimeTypes.size());
+
+  // set the mime types
+  packet.setMimeTypes(params.mimeTypes);
+
+  // set the packet length
+  packet.setPacketLength(packet.size());
+
+  // return the packet
+  return packet;
+}
+
+/**
+ * @brief Create the ChunkPacket
+ *
+ * @param packetType
+ * @param streamId
+ * @param flags
+ * @param payload
+ *
+ * @return ChunkPacket
+ */
+network::packets::ChunkPacket createPacket(internals::ChunkPacketParams params) {
+  // create the packet
+  network::packets::ChunkPacket packet;
+
+  // set the packet type
+  packet.setPacketType(params.packetType);
+
+  // set the stream id
+  packet.setStreamId(params.streamId);
+
+  // set the flags
+  packet.setFlags(params.flags);
+
+  // set the payload length
+  packet.setPayloadLength(params.payload.size());
+
+  // set the payload
+  packet.setPayload(params.payload);
+
+  // set the packet length
+  packet.setPacketLength(packet.size());
+
+  // return the packet
+  return packet;
+}
+
 /**
  * @brief Create the SyncingPacket
  *
@@ -115,6 +253,9 @@ network::packets::SyncingPacket createPacket(internals::SyncingPacketParams para
   // set the packet type
   packet.setPacketType(params.packetType);
 
+  // set a new sync id, forwards keep it
+  packet.setSyncId(QRandomGenerator::global()->generate64());
+
   // set the item count
   packet.setItemCount(params.items.size());
 
@@ -130,7 +271,7 @@ network::packets::SyncingPacket createPacket(internals::SyncingPacketParams para
   }
 
   // set the items
-  packet.setItems(items);
+  packet.setItems(std::move(items));
 
   // set the packet length
   packet.setPacketLength(packet.size());
@@ -156,6 +297,9 @@ network::packets::SyncingPacket createPacket(
   // set the packet type
   packet.setPacketType(packetType);
 
+  // set a new sync id, forwards keep it
+  packet.setSyncId(QRandomGenerator::global()->generate64());
+
   // set the item count
   packet.setItemCount(items.size());
 
@@ -171,7 +315,7 @@ network::packets::SyncingPacket createPacket(
   }
 
   // set the items
-  packet.setItems(syncItems);
+  packet.setItems(std::move(syncItems));
 
   // set the packet length
   packet.setPacketLength(packet.size());
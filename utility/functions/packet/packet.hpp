@@ -9,12 +9,17 @@
 #include <QByteArray>
 #include <QHostAddress>
 #include <QPair>
+#include <QRandomGenerator>
 #include <QString>
 #include <QVector>
 #include <QtTypes>
 
 // Local header files
+#include "network/packets/blobpacket/blobpacket.hpp"
+#include "network/packets/chunkpacket/chunkpacket.hpp"
 #include "network/packets/discoverypacket/discoverypacket.hpp"
+#include "network/packets/filterpacket/filterpacket.hpp"
+#include "network/packets/hellopacket/hellopacket.hpp"
 #include "network/packets/invalidrequest/invalidrequest.hpp"
 #include "network/packets/syncingpacket/syncingpacket.hpp"
 #include "types/enums/enums.hpp"
@@ -46,6 +51,7 @@ struct InvalidPacketParams {
 struct SyncingItemParams {
   const QString& mimeType;
   const QByteArray& payload;
+  quint8 encoding = network::packets::SyncingItem::Encoding::Inline;
 };
 
 /**
@@ -55,9 +61,55 @@ struct SyncingPacketParams {
   quint8 packetType;
   QVector<QPair<QString, QByteArray>> items;
 };
+
+/**
+ * @brief parameters for the BlobPacket
+ */
+struct BlobPacketParams {
+  quint8 packetType;
+  quint64 syncId;
+  const QVector<QByteArray>& blobs;
+};
+
+/**
+ * @brief parameters for the HelloPacket
+ */
+struct HelloPacketParams {
+  quint8 packetType;
+  quint16 version;
+  quint16 minVersion;
+  quint32 features;
+};
+
+/**
+ * @brief parameters for the FilterPacket
+ */
+struct FilterPacketParams {
+  quint8 packetType;
+  quint8 flags;
+  quint32 maxItemSize;
+  const QVector<QByteArray>& mimeTypes;
+};
+
+/**
+ * @brief parameters for the ChunkPacket
+ */
+struct ChunkPacketParams {
+  quint8 packetType;
+  quint32 streamId;
+  quint8 flags;
+  const QByteArray& payload;
+};
 }  // namespace srilakshmikanthanp::clipbirdesk::utility::functions::internals
 
 namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/// @brief Features of the protocol this version supports
+constexpr quint32 supportedFeatures = network::packets::HelloPacket::Feature::InlineItems |
+                                      network::packets::HelloPacket::Feature::ReferenceItems |
+                                      network::packets::HelloPacket::Feature::DeltaItems |
+                                      network::packets::HelloPacket::Feature::Filters |
+                                      network::packets::HelloPacket::Feature::Chunks;
+
 /**
  * @brief Create the DiscoveryPacket
  *
@@ -91,6 +143,53 @@ network::packets::InvalidRequest createPacket(internals::InvalidPacketParams par
  */
 network::packets::SyncingItem createPacket(internals::SyncingItemParams params);
 
+/**
+ * @brief Create the BlobPacket
+ *
+ * @param packetType
+ * @param syncId
+ * @param blobs
+ *
+ * @return BlobPacket
+ */
+network::packets::BlobPacket createPacket(internals::BlobPacketParams params);
+
+/**
+ * @brief Create the HelloPacket
+ *
+ * @param packetType
+ * @param version
+ * @param minVersion
+ * @param features
+ *
+ * @return HelloPacket
+ */
+network::packets::HelloPacket createPacket(internals::HelloPacketParams params);
+
+/**
+ * @brief Create the FilterPacket
+ *
+ * @param packetType
+ * @param flags
+ * @param maxItemSize
+ * @param mimeTypes
+ *
+ * @return FilterPacket
+ */
+network::packets::FilterPacket createPacket(internals::FilterPacketParams params);
+
+/**
+ * @brief Create the ChunkPacket
+ *
+ * @param packetType
+ * @param streamId
+ * @param flags
+ * @param payload
+ *
+ * @return ChunkPacket
+ */
+network::packets::ChunkPacket createPacket(internals::ChunkPacketParams params);
+
 /**
  * @brief Create the SyncingPacket
  *
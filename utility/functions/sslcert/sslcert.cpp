@@ -81,20 +81,19 @@ std::shared_ptr<X509> generateX509(std::shared_ptr<EVP_PKEY> pkey) {
   // return the certificate
   return x509;
 }
-}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions::internal
 
-namespace srilakshmikanthanp::clipbirdesk::utility::functions {
 /**
- * @brief Get the Q Ssl Configuration object
+ * @brief Generates the key and the self-signed certificate in PEM
+ *
  * @param bits - RSA key size
- * @return QSslConfiguration
+ * @return QPair<QByteArray, QByteArray> - key and certificate
  */
-QSslConfiguration getQSslConfiguration(int bits) {
+QPair<QByteArray, QByteArray> generateIdentity(int bits) {
   // Generate the RSA key for the certificate
-  std::shared_ptr<EVP_PKEY> pkey = internal::generateRSAKey(bits);
+  std::shared_ptr<EVP_PKEY> pkey = generateRSAKey(bits);
 
   // Generate the certificate
-  std::shared_ptr<X509> x509     = internal::generateX509(pkey);
+  std::shared_ptr<X509> x509     = generateX509(pkey);
 
   // using the defer as in golang
   using Defer                    = std::shared_ptr<void>;
@@ -117,9 +116,6 @@ QSslConfiguration getQSslConfiguration(int bits) {
   // QByteArray for the Key
   QByteArray key(QByteArray(pkey_buffer_memory->data, pkey_buffer_memory->length));
 
-  // Create the QSslKey
-  QSslKey sslKey(key, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
-
   // Write the certificate to buffer
   BIO *x509_buffer = BIO_new(BIO_s_mem());
 
@@ -138,15 +134,28 @@ QSslConfiguration getQSslConfiguration(int bits) {
   // QByteArray for the Certificate
   QByteArray cert(QByteArray(x509_buffer_memory->data, x509_buffer_memory->length));
 
-  // Create the QSslCertificate
-  QSslCertificate sslCert(cert, QSsl::Pem);
+  // return the key and the certificate
+  return {key, cert};
+}
 
+/**
+ * @brief Create the QSslConfiguration that presents the certificate
+ *
+ * @param sslCert certificate of this host
+ * @param sslKey private key of the certificate
+ * @return QSslConfiguration
+ */
+QSslConfiguration createQSslConfiguration(const QSslCertificate &sslCert, const QSslKey &sslKey) {
   // Create the QSslConfiguration
   QSslConfiguration sslConfig;
 
   // Add the certificate to the configuration
   sslConfig.addCaCertificate(sslCert);
 
+  // Present the certificate to the peer, the peer
+  // recognises this host by its fingerprint
+  sslConfig.setLocalCertificate(sslCert);
+
   // Add the key to the configuration
   sslConfig.setPrivateKey(sslKey);
 
@@ -158,4 +167,93 @@ QSslConfiguration getQSslConfiguration(int bits) {
   // return the configuration
   return sslConfig;
 }
+}  // namespace srilakshmikanthanp::clipbirdesk::utility::functions::internal
+
+namespace srilakshmikanthanp::clipbirdesk::utility::functions {
+/**
+ * @brief Get the Q Ssl Configuration object
+ * @param bits - RSA key size
+ * @return QSslConfiguration
+ */
+QSslConfiguration getQSslConfiguration(int bits) {
+  // Generate the key and the certificate
+  const auto [key, cert] = internal::generateIdentity(bits);
+
+  // Create the QSslKey
+  QSslKey sslKey(key, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+
+  // Create the QSslCertificate
+  QSslCertificate sslCert(cert, QSsl::Pem);
+
+  // return the configuration
+  return internal::createQSslConfiguration(sslCert, sslKey);
+}
+
+/**
+ * @brief Get the Q Ssl Configuration object of the identity kept in
+ * the directory, the key and the certificate are generated and saved
+ * on the first call and loaded on the later ones so the fingerprint
+ * that the peers pin stays the same across the restarts
+ *
+ * @param directory - directory of the identity
+ * @param bits - RSA key size
+ * @return QSslConfiguration
+ * @throw std::runtime_error if the identity can't be saved
+ */
+QSslConfiguration getQSslConfiguration(const QString &directory, int bits) {
+  // files of the identity
+  const auto keyFile  = QDir(directory).filePath("identity.key");
+  const auto certFile = QDir(directory).filePath("identity.crt");
+
+  // read the whole file or nothing
+  const auto readAll  = [](const QString &path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+  };
+
+  // load the saved identity
+  QSslKey sslKey(readAll(keyFile), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+  QSslCertificate sslCert(readAll(certFile), QSsl::Pem);
+
+  // the saved identity is used as long as it is whole
+  if (!sslKey.isNull() && !sslCert.isNull()) {
+    return internal::createQSslConfiguration(sslCert, sslKey);
+  }
+
+  // Generate the key and the certificate
+  const auto [key, cert] = internal::generateIdentity(bits);
+
+  // make sure the directory exists
+  QDir().mkpath(directory);
+
+  // write the file atomically, the key is readable only by the owner
+  const auto save = [](const QString &path, const QByteArray &data, bool secret) {
+    QSaveFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+      throw std::runtime_error("Can't open the identity file");
+    }
+
+    if (secret) {
+      file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    }
+
+    if (file.write(data) != data.size() || !file.commit()) {
+      throw std::runtime_error("Can't save the identity file");
+    }
+  };
+
+  // the key first so the certificate never is without it
+  save(keyFile, key, true);
+  save(certFile, cert, false);
+
+  // Create the QSslKey
+  sslKey  = QSslKey(key, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+
+  // Create the QSslCertificate
+  sslCert = QSslCertificate(cert, QSsl::Pem);
+
+  // return the configuration
+  return internal::createQSslConfiguration(sslCert, sslKey);
+}
 }  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
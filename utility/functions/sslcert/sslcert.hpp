@@ -9,9 +9,14 @@
 // https://opensource.org/licenses/MIT
 
 // Qt headers
+#include <QDir>
+#include <QFile>
+#include <QPair>
+#include <QSaveFile>
 #include <QSslCertificate>
 #include <QSslConfiguration>
 #include <QSslKey>
+#include <QString>
 
 // C++ headers
 #include <memory>
@@ -38,6 +43,23 @@ std::shared_ptr<EVP_PKEY> generateRSAKey(int bits = 2048);
  * @return X509* - shared pointer to certificate
  */
 std::shared_ptr<X509> generateX509(std::shared_ptr<EVP_PKEY> pkey);
+
+/**
+ * @brief Generates the key and the self-signed certificate in PEM
+ *
+ * @param bits - RSA key size
+ * @return QPair<QByteArray, QByteArray> - key and certificate
+ */
+QPair<QByteArray, QByteArray> generateIdentity(int bits);
+
+/**
+ * @brief Create the QSslConfiguration that presents the certificate
+ *
+ * @param sslCert certificate of this host
+ * @param sslKey private key of the certificate
+ * @return QSslConfiguration
+ */
+QSslConfiguration createQSslConfiguration(const QSslCertificate &sslCert, const QSslKey &sslKey);
 }  // namespace srilakshmikanthanp::clipbirdesk::utility::functions::internal
 
 namespace srilakshmikanthanp::clipbirdesk::utility::functions {
@@ -47,4 +69,17 @@ namespace srilakshmikanthanp::clipbirdesk::utility::functions {
  * @return QSslConfiguration
  */
 QSslConfiguration getQSslConfiguration(int bits = 2048);
+
+/**
+ * @brief Get the Q Ssl Configuration object of the identity kept in
+ * the directory, the key and the certificate are generated and saved
+ * on the first call and loaded on the later ones so the fingerprint
+ * that the peers pin stays the same across the restarts
+ *
+ * @param directory - directory of the identity
+ * @param bits - RSA key size
+ * @return QSslConfiguration
+ * @throw std::runtime_error if the identity can't be saved
+ */
+QSslConfiguration getQSslConfiguration(const QString &directory, int bits = 2048);
 }  // namespace srilakshmikanthanp::clipbirdesk::utility::functions
@@ -5,17 +5,456 @@
 
 #include "logging.hpp"
 
+// Qt header files
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+// C++ header files
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+// project header files
+#include "constants/constants.hpp"
+
 namespace srilakshmikanthanp::clipbirdesk::logging {
+Q_LOGGING_CATEGORY(lcNetwork, "clipbird.network", QtInfoMsg)
+}  // namespace srilakshmikanthanp::clipbirdesk::logging
+
+namespace srilakshmikanthanp::clipbirdesk::logging::internal {
 /**
- * @brief Create Qt Logging Message Handler for Logging thar
- * Redirects to Qt Logging to Given File
+ * @brief Bounded lock-free queue of the lines (Vyukov), every slot
+ * has a sequence that tells if it is free for the producers or
+ * filled for the consumer so neither side takes a lock
+ */
+class Ring {
+ private:  // Member variables
+
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    QByteArray line;
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  const std::size_t m_mask;
+  alignas(64) std::atomic<std::size_t> m_head{0};
+  alignas(64) std::atomic<std::size_t> m_tail{0};
+
+ public:  // Member functions
+
+  /**
+   * @brief Construct a new Ring object
+   *
+   * @param capacity capacity in power of two
+   */
+  explicit Ring(std::size_t capacity) : m_slots(new Slot[capacity]), m_mask(capacity - 1) {
+    for (std::size_t i = 0; i < capacity; i++) m_slots[i].sequence.store(i);
+  }
+
+  /**
+   * @brief Put the line, returns false if the ring is full
+   */
+  bool push(QByteArray &&line) {
+    auto pos = m_head.load(std::memory_order_relaxed);
+
+    for (;;) {
+      auto &slot = m_slots[pos & m_mask];
+      auto seq   = slot.sequence.load(std::memory_order_acquire);
+      auto diff  = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.line = std::move(line);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Take the line, returns false if the ring is empty
+   */
+  bool pop(QByteArray &line) {
+    auto pos = m_tail.load(std::memory_order_relaxed);
+
+    for (;;) {
+      auto &slot = m_slots[pos & m_mask];
+      auto seq   = slot.sequence.load(std::memory_order_acquire);
+      auto diff  = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          line = std::move(slot.line);
+          slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Number of lines pushed so far
+   */
+  std::size_t pushed() const {
+    return m_head.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Number of lines popped so far
+   */
+  std::size_t popped() const {
+    return m_tail.load(std::memory_order_acquire);
+  }
+};
+
+/**
+ * @brief Logger that owns the ring and the writer thread
+ */
+class Logger {
+ private:  // Member variables
+
+  Ring m_ring{8192};
+  QString m_file;
+  std::thread m_writer;
+  std::atomic<bool> m_running{true};
+  std::atomic<std::size_t> m_written{0};
+  std::atomic<quint64> m_dropped{0};
+  std::atomic<int> m_level{0};
+  std::atomic<qint64> m_maxBytes{10 * 1024 * 1024};
+  std::atomic<int> m_maxFiles{5};
+
+ private:  // Member functions
+
+  /**
+   * @brief Rotate the files file -> file.1 -> file.2 ...
+   */
+  void rotate(QFile &file) {
+    // close the current file
+    file.close();
+
+    // number of files to keep
+    const auto maxFiles = m_maxFiles.load();
+
+    // drop the oldest and shift the others
+    QFile::remove(QString("%1.%2").arg(m_file).arg(maxFiles));
+    for (int i = maxFiles - 1; i >= 1; i--) {
+      QFile::rename(QString("%1.%2").arg(m_file).arg(i), QString("%1.%2").arg(m_file).arg(i + 1));
+    }
+
+    // rename the current file
+    if (maxFiles > 0) {
+      QFile::rename(m_file, m_file + ".1");
+    } else {
+      QFile::remove(m_file);
+    }
+
+    // reopen the file
+    file.open(QIODevice::WriteOnly | QIODevice::Append);
+  }
+
+  /**
+   * @brief Write the lines till stopped
+   */
+  void run() {
+    // create the directory of the file
+    QDir().mkpath(QFileInfo(m_file).absolutePath());
+
+    // open the file
+    QFile file(m_file);
+    file.open(QIODevice::WriteOnly | QIODevice::Append);
+
+    // line taken from the ring
+    QByteArray line;
+
+    // number of lines taken from the ring so far
+    std::size_t taken = 0;
+
+    // write till stopped and drained
+    for (;;) {
+      // number of lines written in this round
+      auto written = 0;
+
+      // write all the lines in the ring
+      while (m_ring.pop(line)) {
+        if (file.isOpen() && file.size() + line.size() > m_maxBytes.load()) rotate(file);
+        file.write(line);
+        written++;
+      }
+
+      // the lines are taken
+      taken += written;
+
+      // tell about the dropped lines
+      if (const auto dropped = m_dropped.exchange(0); dropped > 0) {
+        file.write(QString("%1 WARN  logging: %2 lines dropped, the ring was full\n")
+                       .arg(QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs))
+                       .arg(dropped)
+                       .toUtf8());
+      }
+
+      // push the lines to the disk, then they count as written
+      if (written > 0) file.flush();
+      m_written.store(taken, std::memory_order_release);
+
+      // stop once drained
+      if (!m_running.load() && m_ring.popped() == m_ring.pushed()) break;
+
+      // nothing to write so wait a while
+      if (written == 0) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+
+ public:  // Member functions
+
+  /**
+   * @brief Construct a new Logger object and start the writer
+   *
+   * @param file log file
+   */
+  explicit Logger(const QString &file) : m_file(file) {
+    m_writer = std::thread([this] { run(); });
+  }
+
+  /**
+   * @brief Stop the writer after writing the pending lines
+   */
+  void stop() {
+    m_running.store(false);
+    if (m_writer.joinable()) m_writer.join();
+  }
+
+  /**
+   * @brief Is the writer running
+   */
+  bool isRunning() const {
+    return m_running.load();
+  }
+
+  /**
+   * @brief Put the line or count it as dropped
+   */
+  void log(QByteArray &&line) {
+    if (!m_ring.push(std::move(line))) m_dropped.fetch_add(1);
+  }
+
+  /**
+   * @brief Wait till the lines pushed so far are written and flushed
+   * to the file, the lines popped are not on the disk yet
+   */
+  void flush() {
+    const auto target = m_ring.pushed();
+    while (m_running.load() && m_written.load(std::memory_order_acquire) < target) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  /**
+   * @brief Set the minimum level rank
+   */
+  void setLevel(int rank) {
+    m_level.store(rank);
+  }
+
+  /**
+   * @brief Get the minimum level rank
+   */
+  int getLevel() const {
+    return m_level.load();
+  }
+
+  /**
+   * @brief Set the rotation
+   */
+  void setRotation(qint64 maxBytes, int maxFiles) {
+    m_maxBytes.store(maxBytes);
+    m_maxFiles.store(maxFiles);
+  }
+};
+
+/// @brief Logger of the process, never deleted so the late
+/// messages from the static destructors don't find it gone
+std::atomic<Logger *> logger{nullptr};
+
+/**
+ * @brief Rank of the level, QtMsgType is not in the order
+ */
+int rankOf(QtMsgType type) {
+  switch (type) {
+  case QtDebugMsg:
+    return 0;
+  case QtInfoMsg:
+    return 1;
+  case QtWarningMsg:
+    return 2;
+  case QtCriticalMsg:
+    return 3;
+  case QtFatalMsg:
+    return 4;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Name of the level padded to the same width
+ */
+const char *nameOf(QtMsgType type) {
+  switch (type) {
+  case QtDebugMsg:
+    return "DEBUG";
+  case QtInfoMsg:
+    return "INFO ";
+  case QtWarningMsg:
+    return "WARN ";
+  case QtCriticalMsg:
+    return "ERROR";
+  case QtFatalMsg:
+    return "FATAL";
+  }
+
+  return "?????";
+}
+
+/**
+ * @brief Message handler that formats and queues the line
+ */
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+  // the logger of the process
+  auto log = logger.load();
+
+  // is the logger running
+  const auto running = log != nullptr && log->isRunning();
+
+  // drop the lines below the level
+  if (running && rankOf(type) < log->getLevel()) return;
+
+  // time of the line
+  const auto time = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+
+  // category of the line
+  const auto category = context.category ? context.category : "default";
+
+  // format the line
+  auto line = QString("%1 %2 %3: %4\n").arg(time, nameOf(type), category, msg).toUtf8();
+
+  // if stopped then write directly to stderr
+  if (!running) {
+    std::fputs(line.constData(), stderr);
+    return;
+  }
+
+  // queue the line
+  log->log(std::move(line));
+
+  // fatal aborts after the handler so write it now
+  if (type == QtFatalMsg) log->flush();
+}
+
+/**
+ * @brief Stop the logger at exit after writing the lines
+ */
+void stopAtExit() {
+  if (auto log = logger.load()) log->stop();
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::logging::internal
+
+namespace srilakshmikanthanp::clipbirdesk::logging {
+/**
+ * @brief Get the default log file under the app home
+ *
+ * @return QString path of the file
+ */
+QString getDefaultFile() {
+  return QDir(QString::fromStdString(constants::getAppHome())).filePath("clipbird.log");
+}
+
+/**
+ * @brief Create Qt Logging Message Handler that Redirects the Qt
+ * Logging to the Given File, the handler only formats the line and
+ * puts it in a lock-free ring buffer, a background thread writes
+ * it to the file so the caller never blocks on the disk, when the
+ * ring is full the line is dropped and counted instead of waiting
  *
- * @param file
+ * @param file log file
+ *
+ * @return message handler to install with qInstallMessageHandler
+ */
+QtMessageHandler createFileMessageHandler(const QString &file) {
+  // the logger is created once per process
+  if (internal::logger.load() == nullptr) {
+    internal::logger.store(new internal::Logger(file));
+    std::atexit(internal::stopAtExit);
+  }
+
+  // return the handler
+  return internal::messageHandler;
+}
+
+/**
+ * @brief Set the minimum level that is written
+ *
+ * @param level minimum level
+ */
+void setLevel(QtMsgType level) {
+  if (auto log = internal::logger.load()) log->setLevel(internal::rankOf(level));
+}
+
+/**
+ * @brief Set the size based rotation, once the file reaches the
+ * size it is renamed to file.1 and the older ones are shifted
  *
- * @return message handler
+ * @param maxBytes size of a file
+ * @param maxFiles number of rotated files to keep
  */
-QMessageLogger createFileMessageHandler(const QString &file) {
-  // TODO: implement
+void setRotation(qint64 maxBytes, int maxFiles) {
+  if (auto log = internal::logger.load()) log->setRotation(maxBytes, maxFiles);
 }
 
+/**
+ * @brief Wait till the lines that are logged so far are written
+ */
+void flush() {
+  if (auto log = internal::logger.load()) log->flush();
+}
+
+/**
+ * @brief Append the fields to the message in key=value form so
+ * the lines can be parsed, e.g. peer, packet type, bytes, latency
+ *
+ * @param message message of the line
+ * @param fields structured fields
+ *
+ * @return QString message with the fields
+ */
+QString withFields(const QString &message, const Fields &fields) {
+  // start with the message
+  auto line = message;
+
+  // append the fields, values with spaces are quoted
+  for (const auto &[key, value] : fields) {
+    auto text = value.toString();
+    if (text.contains(' ') || text.contains('"')) {
+      text = QString("\"%1\"").arg(text.replace('"', "\\\""));
+    }
+    line += QString(" %1=%2").arg(key, text);
+  }
+
+  // return the line
+  return line;
+}
 }  // namespace srilakshmikanthanp::clipbirdesk::logging
@@ -6,16 +6,70 @@
 // https://opensource.org/licenses/MIT
 
 // Qt header files
+#include <QByteArray>
+#include <QList>
+#include <QLoggingCategory>
+#include <QPair>
+#include <QString>
+#include <QVariant>
 #include <QtLogging>
 
 namespace srilakshmikanthanp::clipbirdesk::logging {
+/// @brief Structured fields of a log line as key -> value
+using Fields = QList<QPair<QString, QVariant>>;
+
+/// @brief Category of the network hot path, debug is off by default
+Q_DECLARE_LOGGING_CATEGORY(lcNetwork)
+
+/**
+ * @brief Get the default log file under the app home
+ *
+ * @return QString path of the file
+ */
+QString getDefaultFile();
+
+/**
+ * @brief Create Qt Logging Message Handler that Redirects the Qt
+ * Logging to the Given File, the handler only formats the line and
+ * puts it in a lock-free ring buffer, a background thread writes
+ * it to the file so the caller never blocks on the disk, when the
+ * ring is full the line is dropped and counted instead of waiting
+ *
+ * @param file log file
+ *
+ * @return message handler to install with qInstallMessageHandler
+ */
+QtMessageHandler createFileMessageHandler(const QString &file = getDefaultFile());
+
+/**
+ * @brief Set the minimum level that is written
+ *
+ * @param level minimum level
+ */
+void setLevel(QtMsgType level);
+
+/**
+ * @brief Set the size based rotation, once the file reaches the
+ * size it is renamed to file.1 and the older ones are shifted
+ *
+ * @param maxBytes size of a file
+ * @param maxFiles number of rotated files to keep
+ */
+void setRotation(qint64 maxBytes, int maxFiles);
+
+/**
+ * @brief Wait till the lines that are logged so far are written
+ */
+void flush();
+
 /**
- * @brief Create Qt Logging Message Handler for Logging thar
- * Redirects to Qt Logging to Given File
+ * @brief Append the fields to the message in key=value form so
+ * the lines can be parsed, e.g. peer, packet type, bytes, latency
  *
- * @param file
+ * @param message message of the line
+ * @param fields structured fields
  *
- * @return message handler
+ * @return QString message with the fields
  */
-QMessageLogger createFileMessageHandler(const QString &file);
+QString withFields(const QString &message, const Fields &fields);
 }  // namespace srilakshmikanthanp::clipbirdesk::logging
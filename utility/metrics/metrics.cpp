@@ -0,0 +1,332 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "metrics.hpp"
+
+// Qt headers
+#include <QStringList>
+#include <QtAlgorithms>
+
+// C++ headers
+#include <algorithm>
+
+namespace srilakshmikanthanp::clipbirdesk::metrics {
+/**
+ * @brief Get the bucket index of the value
+ */
+int Histogram::bucketOf(quint64 value) noexcept {
+  // values below 16 have their own bucket
+  if (value < 16) return static_cast<int>(value);
+
+  // power of two of the value
+  const int exp = 63 - qCountLeadingZeroBits(value);
+
+  // one of the 8 buckets in the power of two
+  const int sub = static_cast<int>((value >> (exp - 3)) & 7);
+
+  // index of the bucket
+  return 16 + (exp - 4) * 8 + sub;
+}
+
+/**
+ * @brief Get the upper bound of the bucket
+ */
+quint64 Histogram::upperBoundOf(int bucket) noexcept {
+  // values below 16 have their own bucket
+  if (bucket < 16) return bucket;
+
+  // power of two and the sub bucket
+  const int exp = (bucket - 16) / 8 + 4;
+  const int sub = (bucket - 16) % 8;
+
+  // lower bound and the width of the bucket
+  const auto lower = quint64(8 + sub) << (exp - 3);
+  const auto width = quint64(1) << (exp - 3);
+
+  // upper bound of the bucket
+  return lower + width - 1;
+}
+
+/**
+ * @brief Record the value
+ *
+ * @param value value to record
+ */
+void Histogram::record(quint64 value) noexcept {
+  m_buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the number of recorded values
+ */
+quint64 Histogram::count() const noexcept {
+  return m_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the sum of the recorded values
+ */
+quint64 Histogram::sum() const noexcept {
+  return m_sum.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the quantile of the recorded values, it is the
+ * upper bound of the bucket the quantile falls in
+ *
+ * @param q quantile in range 0 - 1
+ */
+quint64 Histogram::quantile(double q) const noexcept {
+  // total of the buckets, the count may be ahead of the
+  // buckets while recording so the buckets are summed
+  quint64 total = 0;
+  for (const auto& bucket : m_buckets) total += bucket.load(std::memory_order_relaxed);
+
+  // if empty then zero
+  if (total == 0) return 0;
+
+  // rank of the quantile
+  const auto rank = std::max<quint64>(1, static_cast<quint64>(q * total + 0.5));
+
+  // find the bucket of the rank
+  quint64 seen = 0;
+  for (int i = 0; i < bucketCount; i++) {
+    if ((seen += m_buckets[i].load(std::memory_order_relaxed)) >= rank) {
+      return upperBoundOf(i);
+    }
+  }
+
+  // rank is beyond the buckets
+  return upperBoundOf(bucketCount - 1);
+}
+
+/**
+ * @brief Convert the labels to the prometheus form
+ */
+QString Registry::toLabelsText(const Labels& labels) {
+  // labels in the form key="value"
+  QStringList pairs;
+
+  // escape the values
+  for (const auto& [key, value] : labels) {
+    auto escaped = value;
+    escaped.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    pairs.append(QString("%1=\"%2\"").arg(key, escaped));
+  }
+
+  // join the pairs
+  return pairs.join(',');
+}
+
+/**
+ * @brief Run the collectors before the export
+ */
+void Registry::collect() {
+  // copy so the collectors can use the registry
+  std::map<int, std::function<void()>> collectors;
+
+  // copy with the read lock
+  {
+    QReadLocker locker(&m_lock);
+    collectors = m_collectors;
+  }
+
+  // run the collectors
+  for (const auto& [_, collector] : collectors) collector();
+}
+
+/**
+ * @brief Get the Registry of the process
+ */
+Registry& Registry::instance() {
+  static Registry registry;
+  return registry;
+}
+
+/**
+ * @brief Get or create the counter
+ *
+ * @param name name of the series
+ * @param labels labels of the series
+ */
+Counter& Registry::counter(const QString& name, const Labels& labels) {
+  return series(m_counters, {name, toLabelsText(labels)});
+}
+
+/**
+ * @brief Get or create the gauge
+ *
+ * @param name name of the series
+ * @param labels labels of the series
+ */
+Gauge& Registry::gauge(const QString& name, const Labels& labels) {
+  return series(m_gauges, {name, toLabelsText(labels)});
+}
+
+/**
+ * @brief Get or create the histogram
+ *
+ * @param name name of the series
+ * @param labels labels of the series
+ */
+Histogram& Registry::histogram(const QString& name, const Labels& labels) {
+  return series(m_histograms, {name, toLabelsText(labels)});
+}
+
+/**
+ * @brief Add a collector that is called before every export
+ * to update the gauges that are sampled rather than tracked,
+ * it is called on the thread that exports
+ *
+ * @param collector collector function
+ * @return int id to remove the collector
+ */
+int Registry::addCollector(std::function<void()> collector) {
+  QWriteLocker locker(&m_lock);
+  m_collectors[m_nextCollector] = std::move(collector);
+  return m_nextCollector++;
+}
+
+/**
+ * @brief Remove the collector
+ *
+ * @param id id of the collector
+ */
+void Registry::removeCollector(int id) {
+  QWriteLocker locker(&m_lock);
+  m_collectors.erase(id);
+}
+
+/**
+ * @brief Export the metrics in prometheus text format, the
+ * histograms are exported as summaries
+ */
+QByteArray Registry::toPrometheus() {
+  // update the sampled gauges
+  this->collect();
+
+  // lock for reading the series
+  QReadLocker locker(&m_lock);
+
+  // exported text
+  QByteArray text;
+
+  // series name with the labels and extra label
+  const auto seriesOf = [](const QString& name, QString labels, const QString& extra = {}) {
+    if (!extra.isEmpty()) labels = labels.isEmpty() ? extra : labels + ',' + extra;
+    return labels.isEmpty() ? name : QString("%1{%2}").arg(name, labels);
+  };
+
+  // write one sample of the series
+  const auto sample = [&](const QString& series, auto value) {
+    text += QString("%1 %2\n").arg(series, QString::number(value)).toUtf8();
+  };
+
+  // write the series of the map with the type line once per name
+  const auto write = [&](const auto& map, const char* type, const auto& samples) {
+    QString last;
+    for (const auto& [key, metric] : map) {
+      if (key.first != last) text += QString("# TYPE %1 %2\n").arg(key.first, type).toUtf8();
+      last = key.first;
+      samples(key, *metric);
+    }
+  };
+
+  // counters
+  write(m_counters, "counter", [&](const Key& key, const Counter& c) {
+    sample(seriesOf(key.first, key.second), c.value());
+  });
+
+  // gauges
+  write(m_gauges, "gauge", [&](const Key& key, const Gauge& g) {
+    sample(seriesOf(key.first, key.second), g.value());
+  });
+
+  // histograms as summaries
+  write(m_histograms, "summary", [&](const Key& key, const Histogram& h) {
+    for (const auto q : {0.5, 0.9, 0.99, 0.999}) {
+      const auto quantile = QString("quantile=\"%1\"").arg(q);
+      sample(seriesOf(key.first, key.second, quantile), h.quantile(q));
+    }
+    sample(seriesOf(key.first + "_sum", key.second), h.sum());
+    sample(seriesOf(key.first + "_count", key.second), h.count());
+  });
+
+  // return the text
+  return text;
+}
+
+/**
+ * @brief Export the metrics as JSON
+ */
+QByteArray Registry::toJson() {
+  // update the sampled gauges
+  this->collect();
+
+  // lock for reading the series
+  QReadLocker locker(&m_lock);
+
+  // series object with the name and labels
+  const auto seriesOf = [](const Key& key) {
+    return QJsonObject{{"name", key.first}, {"labels", key.second}};
+  };
+
+  // counters
+  QJsonArray counters;
+  for (const auto& [key, c] : m_counters) {
+    auto object = seriesOf(key);
+    object.insert("value", qint64(c->value()));
+    counters.append(object);
+  }
+
+  // gauges
+  QJsonArray gauges;
+  for (const auto& [key, g] : m_gauges) {
+    auto object = seriesOf(key);
+    object.insert("value", g->value());
+    gauges.append(object);
+  }
+
+  // histograms
+  QJsonArray histograms;
+  for (const auto& [key, h] : m_histograms) {
+    auto object = seriesOf(key);
+    object.insert("count", qint64(h->count()));
+    object.insert("sum", qint64(h->sum()));
+    object.insert("p50", qint64(h->quantile(0.5)));
+    object.insert("p90", qint64(h->quantile(0.9)));
+    object.insert("p99", qint64(h->quantile(0.99)));
+    object.insert("p999", qint64(h->quantile(0.999)));
+    histograms.append(object);
+  }
+
+  // the document
+  const QJsonObject root{
+      {  "counters",   counters},
+      {    "gauges",     gauges},
+      {"histograms", histograms},
+  };
+
+  // return the JSON
+  return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Construct a new Traffic object
+ *
+ * @param direction "in" or "out"
+ * @param peer address of the peer
+ */
+Traffic::Traffic(const QString& direction, const QString& peer) {
+  // labels of the series
+  const Labels labels = {{"direction", direction}, {"peer", peer}};
+
+  // the counters live as long as the registry
+  m_packets = &Registry::instance().counter("clipbird_packets_total", labels);
+  m_bytes   = &Registry::instance().counter("clipbird_bytes_total", labels);
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::metrics
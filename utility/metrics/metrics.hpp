@@ -0,0 +1,340 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QString>
+
+// C++ headers
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+
+namespace srilakshmikanthanp::clipbirdesk::metrics {
+/// @brief Labels of a series as name -> value
+using Labels = QList<QPair<QString, QString>>;
+
+/**
+ * @brief Monotonic counter, updates are lock-free
+ */
+class Counter {
+ private:  // Member variables
+
+  std::atomic<quint64> m_value{0};
+
+ public:  // Member functions
+
+  /**
+   * @brief Increment the counter
+   *
+   * @param n amount to add
+   */
+  void inc(quint64 n = 1) noexcept {
+    m_value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the value of the counter
+   */
+  quint64 value() const noexcept {
+    return m_value.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Gauge that can go up and down, updates are lock-free
+ */
+class Gauge {
+ private:  // Member variables
+
+  std::atomic<qint64> m_value{0};
+
+ public:  // Member functions
+
+  /**
+   * @brief Set the value of the gauge
+   */
+  void set(qint64 value) noexcept {
+    m_value.store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Add to the value of the gauge
+   */
+  void add(qint64 n) noexcept {
+    m_value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the value of the gauge
+   */
+  qint64 value() const noexcept {
+    return m_value.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Histogram with log-linear buckets like HDR histogram,
+ * the values below 16 have their own bucket and above that every
+ * power of two is split in 8 buckets, so any value is kept with
+ * 12.5% precision in a fixed array and the updates are lock-free
+ */
+class Histogram {
+ public:  // Constants
+
+  /// @brief Number of buckets for the 64 bit values
+  static constexpr int bucketCount = 16 + 60 * 8;
+
+ private:  // Member variables
+
+  std::array<std::atomic<quint64>, bucketCount> m_buckets{};
+  std::atomic<quint64> m_count{0};
+  std::atomic<quint64> m_sum{0};
+
+ public:  // Member functions
+
+  /**
+   * @brief Get the bucket index of the value
+   */
+  static int bucketOf(quint64 value) noexcept;
+
+  /**
+   * @brief Get the upper bound of the bucket
+   */
+  static quint64 upperBoundOf(int bucket) noexcept;
+
+  /**
+   * @brief Record the value
+   *
+   * @param value value to record
+   */
+  void record(quint64 value) noexcept;
+
+  /**
+   * @brief Get the number of recorded values
+   */
+  quint64 count() const noexcept;
+
+  /**
+   * @brief Get the sum of the recorded values
+   */
+  quint64 sum() const noexcept;
+
+  /**
+   * @brief Get the quantile of the recorded values, it is the
+   * upper bound of the bucket the quantile falls in
+   *
+   * @param q quantile in range 0 - 1
+   */
+  quint64 quantile(double q) const noexcept;
+};
+
+/**
+ * @brief Records the elapsed nanoseconds to the histogram when
+ * it goes out of scope
+ */
+class ScopedTimer {
+ private:  // Member variables
+
+  Histogram& m_histogram;
+  QElapsedTimer m_timer;
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Start the timer
+   *
+   * @param histogram histogram to record to
+   */
+  explicit ScopedTimer(Histogram& histogram) : m_histogram(histogram) {
+    m_timer.start();
+  }
+
+  /**
+   * @brief Record the elapsed time
+   */
+  ~ScopedTimer() {
+    m_histogram.record(m_timer.nsecsElapsed());
+  }
+};
+
+/**
+ * @brief Registry of the metrics of the process, the series are
+ * created on the first use and live as long as the process so
+ * the callers may keep the reference and update it without any
+ * lookup or lock, only the lookup of the series takes a lock
+ */
+class Registry {
+ private:  // Type alias
+
+  using Key = std::pair<QString, QString>;
+
+ private:  // Member variables
+
+  mutable QReadWriteLock m_lock;
+  std::map<Key, std::unique_ptr<Counter>> m_counters;
+  std::map<Key, std::unique_ptr<Gauge>> m_gauges;
+  std::map<Key, std::unique_ptr<Histogram>> m_histograms;
+  std::map<int, std::function<void()>> m_collectors;
+  int m_nextCollector = 0;
+
+ private:  // Member functions
+
+  /**
+   * @brief Convert the labels to the prometheus form
+   */
+  static QString toLabelsText(const Labels& labels);
+
+  /**
+   * @brief Find or create the series in the map
+   */
+  template <typename Metric>
+  Metric& series(std::map<Key, std::unique_ptr<Metric>>& map, const Key& key) {
+    // find with the read lock
+    {
+      QReadLocker locker(&m_lock);
+      if (auto it = map.find(key); it != map.end()) return *it->second;
+    }
+
+    // create with the write lock
+    QWriteLocker locker(&m_lock);
+    auto& metric = map[key];
+    if (!metric) metric = std::make_unique<Metric>();
+    return *metric;
+  }
+
+  /**
+   * @brief Run the collectors before the export
+   */
+  void collect();
+
+  /**
+   * @brief Construct a new Registry object
+   */
+  Registry() = default;
+
+ public:  // Member functions
+
+  /**
+   * @brief Get the Registry of the process
+   */
+  static Registry& instance();
+
+  /**
+   * @brief Get or create the counter
+   *
+   * @param name name of the series
+   * @param labels labels of the series
+   */
+  Counter& counter(const QString& name, const Labels& labels = {});
+
+  /**
+   * @brief Get or create the gauge
+   *
+   * @param name name of the series
+   * @param labels labels of the series
+   */
+  Gauge& gauge(const QString& name, const Labels& labels = {});
+
+  /**
+   * @brief Get or create the histogram
+   *
+   * @param name name of the series
+   * @param labels labels of the series
+   */
+  Histogram& histogram(const QString& name, const Labels& labels = {});
+
+  /**
+   * @brief Add a collector that is called before every export
+   * to update the gauges that are sampled rather than tracked,
+   * it is called on the thread that exports
+   *
+   * @param collector collector function
+   * @return int id to remove the collector
+   */
+  int addCollector(std::function<void()> collector);
+
+  /**
+   * @brief Remove the collector
+   *
+   * @param id id of the collector
+   */
+  void removeCollector(int id);
+
+  /**
+   * @brief Export the metrics in prometheus text format, the
+   * histograms are exported as summaries
+   */
+  QByteArray toPrometheus();
+
+  /**
+   * @brief Export the metrics as JSON
+   */
+  QByteArray toJson();
+};
+
+/**
+ * @brief Call the function and record its time to the histogram
+ *
+ * @param histogram histogram to record to
+ * @param func function to call
+ * @return result of the function
+ */
+template <typename Func>
+auto measure(Histogram& histogram, Func&& func) {
+  ScopedTimer timer(histogram);
+  return func();
+}
+
+/**
+ * @brief Counters of the packets sent to or received from the peer
+ * as clipbird_packets_total and clipbird_bytes_total, they are
+ * looked up once per connection so a packet is counted without
+ * the lock of the registry
+ */
+class Traffic {
+ private:  // Member variables
+
+  Counter* m_packets = nullptr;
+  Counter* m_bytes   = nullptr;
+
+ public:  // Member functions
+
+  /**
+   * @brief Construct a new Traffic object that counts nothing
+   */
+  Traffic() = default;
+
+  /**
+   * @brief Construct a new Traffic object
+   *
+   * @param direction "in" or "out"
+   * @param peer address of the peer
+   */
+  Traffic(const QString& direction, const QString& peer);
+
+  /**
+   * @brief Record the packet
+   *
+   * @param bytes size of the packet
+   */
+  void record(qint64 bytes) noexcept {
+    if (m_packets == nullptr) return;
+    m_packets->inc();
+    m_bytes->inc(bytes);
+  }
+};
+}  // namespace srilakshmikanthanp::clipbirdesk::metrics
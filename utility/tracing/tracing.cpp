@@ -0,0 +1,239 @@
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "tracing.hpp"
+
+// Qt headers
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRandomGenerator>
+
+// C++ headers
+#include <atomic>
+#include <vector>
+
+namespace srilakshmikanthanp::clipbirdesk::tracing::internal {
+/**
+ * @brief Span that is finished and waiting to be written
+ */
+struct Event {
+  const char* name;
+  qint64 start;
+  qint64 duration;
+  int thread;
+  quint64 syncId;
+};
+
+/// @brief Number of events buffered before they are written
+constexpr std::size_t bufferSize = 4096;
+
+/// @brief Sync id of the thread
+thread_local quint64 syncId = 0;
+
+/// @brief Is the trace started, checked without the lock
+std::atomic<bool> started{false};
+
+/// @brief Next id of the thread
+std::atomic<int> nextThread{1};
+
+/// @brief Lock of the buffer and the file
+QMutex lock;
+
+/// @brief Buffered events
+std::vector<Event> events;
+
+/// @brief Trace file
+QFile file;
+
+/// @brief Is any event written to the file
+bool isFirst = true;
+
+/**
+ * @brief Get the id of the current thread, Chrome trace needs a
+ * small number rather than the native handle
+ */
+int threadId() noexcept {
+  thread_local const int id = nextThread.fetch_add(1);
+  return id;
+}
+
+/**
+ * @brief Write the object to the array, must hold the lock
+ */
+void writeObject(const QByteArray& object) {
+  file.write(isFirst ? "[\n" : ",\n");
+  file.write(object);
+  isFirst = false;
+}
+
+/**
+ * @brief Write the buffered events to the file, must hold the lock
+ */
+void writeEvents() {
+  // process id of the events
+  const auto pid = QCoreApplication::applicationPid();
+
+  // write the events as complete events
+  for (const auto& event : events) {
+    auto object = QString(R"({"name":"%1","cat":"clipbird","ph":"X",)").arg(event.name);
+
+    object += QString(R"("ts":%1,"dur":%2,)").arg(event.start).arg(event.duration);
+    object += QString(R"("pid":%1,"tid":%2)").arg(pid).arg(event.thread);
+
+    if (event.syncId != 0) {
+      object += QString(R"(,"args":{"syncId":"%1"})").arg(event.syncId, 16, 16, QChar('0'));
+    }
+
+    writeObject((object + '}').toUtf8());
+  }
+
+  // clear the buffer
+  events.clear();
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::tracing::internal
+
+namespace srilakshmikanthanp::clipbirdesk::tracing {
+/**
+ * @brief Create a new random sync id
+ */
+quint64 newSyncId() {
+  return QRandomGenerator::global()->generate64();
+}
+
+/**
+ * @brief Get the sync id of the current thread or zero if the
+ * thread is not working on any sync
+ */
+quint64 currentSyncId() noexcept {
+  return internal::syncId;
+}
+
+/**
+ * @brief Set the sync id of the current thread
+ *
+ * @param syncId id of the sync
+ */
+SyncScope::SyncScope(quint64 syncId) noexcept : m_previous(internal::syncId) {
+  internal::syncId = syncId;
+}
+
+/**
+ * @brief Restore the previous sync id
+ */
+SyncScope::~SyncScope() noexcept {
+  internal::syncId = m_previous;
+}
+
+/**
+ * @brief Start the span
+ *
+ * @param name name of the span, must be a literal
+ */
+Span::Span(const char* name) noexcept : m_name(name), m_start(std::chrono::steady_clock::now()) {}
+
+/**
+ * @brief Record the span
+ */
+Span::~Span() noexcept {
+  // if not started then nothing to record
+  if (!internal::started.load(std::memory_order_relaxed)) return;
+
+  // using the clocks and units
+  using namespace std::chrono;
+
+  // duration of the span
+  const auto duration = steady_clock::now() - m_start;
+
+  // start of the span in the wall clock
+  const auto start    = system_clock::now() - duration;
+
+  // the event of the span
+  const internal::Event event{
+      m_name,
+      duration_cast<microseconds>(start.time_since_epoch()).count(),
+      duration_cast<microseconds>(duration).count(),
+      internal::threadId(),
+      internal::syncId,
+  };
+
+  // lock the buffer
+  QMutexLocker locker(&internal::lock);
+
+  // may be stopped while waiting for the lock
+  if (!internal::file.isOpen()) return;
+
+  // buffer the event
+  internal::events.push_back(event);
+
+  // write if the buffer is full
+  if (internal::events.size() >= internal::bufferSize) internal::writeEvents();
+}
+
+/**
+ * @brief Start writing the spans to the file in the Chrome trace
+ * event format (JSON array) that chrome://tracing and Perfetto
+ * open, the timestamps are wall clock so the files of the server
+ * and the clients can be merged into one array
+ *
+ * @param file trace file
+ * @return true if started
+ */
+bool start(const QString& file) {
+  // lock the buffer
+  QMutexLocker locker(&internal::lock);
+
+  // if already started then ignore
+  if (internal::file.isOpen()) return false;
+
+  // open the file
+  internal::file.setFileName(file);
+  if (!internal::file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+  // reserve the buffer
+  internal::events.reserve(internal::bufferSize);
+  internal::isFirst = true;
+
+  // name the process so the merged traces can be told apart
+  const auto pid    = QCoreApplication::applicationPid();
+  const auto name   = QCoreApplication::applicationName();
+  auto meta         = QString(R"({"name":"process_name","ph":"M","pid":%1,)").arg(pid);
+  meta += QString(R"("args":{"name":"%1 %2"}})").arg(name, QString::number(pid));
+  internal::writeObject(meta.toUtf8());
+
+  // start recording
+  internal::started.store(true);
+
+  // done
+  return true;
+}
+
+/**
+ * @brief Write the pending spans and close the file
+ */
+void stop() {
+  // stop recording
+  internal::started.store(false);
+
+  // lock the buffer
+  QMutexLocker locker(&internal::lock);
+
+  // if not started then ignore
+  if (!internal::file.isOpen()) return;
+
+  // write the pending events and close the array
+  internal::writeEvents();
+  internal::file.write("\n]\n");
+  internal::file.close();
+}
+
+/**
+ * @brief Is the trace started
+ */
+bool isStarted() noexcept {
+  return internal::started.load(std::memory_order_relaxed);
+}
+}  // namespace srilakshmikanthanp::clipbirdesk::tracing
@@ -0,0 +1,118 @@
+#pragma once  // Header guard see https://en.wikipedia.org/wiki/Include_guard
+
+// Copyright (c) 2023 Sri Lakshmi Kanthan P
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Qt headers
+#include <QString>
+#include <QtTypes>
+
+// C++ headers
+#include <chrono>
+
+namespace srilakshmikanthanp::clipbirdesk::tracing {
+/**
+ * @brief Create a new random sync id
+ */
+quint64 newSyncId();
+
+/**
+ * @brief Get the sync id of the current thread or zero if the
+ * thread is not working on any sync
+ */
+quint64 currentSyncId() noexcept;
+
+/**
+ * @brief Sets the sync id of the current thread while in scope
+ * so the spans and the packets created in it are correlated
+ */
+class SyncScope {
+ private:  // Member variables
+
+  quint64 m_previous;
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Set the sync id of the current thread
+   *
+   * @param syncId id of the sync
+   */
+  explicit SyncScope(quint64 syncId) noexcept;
+
+  /**
+   * @brief Restore the previous sync id
+   */
+  ~SyncScope() noexcept;
+
+  SyncScope(const SyncScope&)            = delete;
+  SyncScope& operator=(const SyncScope&) = delete;
+};
+
+/**
+ * @brief Records the span to the trace when it goes out of
+ * scope if the trace is started, use CLIPBIRD_TRACE_SPAN
+ * instead of this so the spans are compiled out by default
+ */
+class Span {
+ private:  // Member variables
+
+  const char* m_name;
+  std::chrono::steady_clock::time_point m_start;
+
+ public:  // constructors and destructors
+
+  /**
+   * @brief Start the span
+   *
+   * @param name name of the span, must be a literal
+   */
+  explicit Span(const char* name) noexcept;
+
+  /**
+   * @brief Record the span
+   */
+  ~Span() noexcept;
+
+  Span(const Span&)            = delete;
+  Span& operator=(const Span&) = delete;
+};
+
+/**
+ * @brief Start writing the spans to the file in the Chrome trace
+ * event format (JSON array) that chrome://tracing and Perfetto
+ * open, the timestamps are wall clock so the files of the server
+ * and the clients can be merged into one array
+ *
+ * @param file trace file
+ * @return true if started
+ */
+bool start(const QString& file);
+
+/**
+ * @brief Write the pending spans and close the file
+ */
+void stop();
+
+/**
+ * @brief Is the trace started
+ */
+bool isStarted() noexcept;
+}  // namespace srilakshmikanthanp::clipbirdesk::tracing
+
+#define CLIPBIRD_TRACE_CONCAT_IMPL(a, b) a##b
+#define CLIPBIRD_TRACE_CONCAT(a, b) CLIPBIRD_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Trace the rest of the scope as a span with the name, it
+ * expands to nothing unless built with CLIPBIRDESK_TRACING so the
+ * hot path pays nothing for it by default
+ */
+#ifdef CLIPBIRDESK_TRACING
+#define CLIPBIRD_TRACE_SPAN(name) \
+  ::srilakshmikanthanp::clipbirdesk::tracing::Span CLIPBIRD_TRACE_CONCAT(span_, __LINE__)(name)
+#else
+#define CLIPBIRD_TRACE_SPAN(name) static_cast<void>(0)
+#endif